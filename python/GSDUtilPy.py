@@ -61,7 +61,18 @@ class GSDUtilPy:
                          num_steps_output=1000,
                          fluid_density=1.0, particle_density=1.0,
                          wca_epsilon=0.0, wca_sigma=0.0,
-                         image_system=False):
+                         image_system=False,
+                         matrix_free_hydro=False,
+                         pair_tolerance=0.0, neighbor_skin=1.0,
+                         treecode_theta=0.0,
+                         mirror_hydro=False,
+                         adaptive_atol=0.0, adaptive_rtol=0.0,
+                         udwadia_solver=0, udwadia_refactor_tol=0.0,
+                         integrator_scheme=0, rattle_iterations=2,
+                         multirate_micro_periods=1, multirate_macro_periods=0,
+                         periodic_orbit_tol=0.0,
+                         steady_state_tol=0.0, steady_state_atol=0.0, steady_state_periods=3,
+                         parareal_slices=0, parareal_coarse_ratio=10, parareal_tol=1e-8):
         """Sets the data saved in the log section of GSD frame
 
         Args:
@@ -77,6 +88,26 @@ class GSDUtilPy:
             wca_epsilon (np.double): WCA length scale. Defaults to 0.0.
             wca_sigma (np.double): WCA energy scale. Defaults to 0.0.
             image_system (bool): Boolean stating whether input configuration is using the method of images. Defaults to False.
+            matrix_free_hydro (bool): Boolean stating whether hydrodynamic forces are evaluated matrix-free from particle pairs. Defaults to False.
+            pair_tolerance (np.double): Relative error tolerance of neglected far-field added mass elements. Non-positive values evaluate all particle pairs. Defaults to 0.0.
+            neighbor_skin (np.double): Skin distance of the neighbor list used with a finite pair tolerance. Defaults to 1.0.
+            treecode_theta (np.double): Opening angle of the treecode for added mass products in matrix-free mode, in (0, 1). Non-positive values use dense products. Defaults to 0.0.
+            mirror_hydro (bool): Boolean stating whether hydrodynamics of an image system only store the real particles and add image particles through reflection. Defaults to False.
+            adaptive_atol (np.double): Absolute error tolerance of adaptive time stepping on body positions and velocities. Adaptive stepping is used if either tolerance is positive. Defaults to 0.0.
+            adaptive_rtol (np.double): Relative error tolerance of adaptive time stepping on body positions and velocities. Defaults to 0.0.
+            udwadia_solver (np.int32): Solver of the constrained accelerations, 0 (eigendecomposition), 1 (Cholesky and Schur complement) or 2 (projected preconditioned conjugate gradient). Defaults to 0.
+            udwadia_refactor_tol (np.double): Relative residual tolerance to reuse the effective mass factorization of a previous solve with the Cholesky solver. Non-positive values factorize at every solve. Defaults to 0.0.
+            integrator_scheme (np.int32): Time integration scheme, 0 (classical Runge-Kutta in quaternion coordinates with Udwadia-Kalaba constraints) 1 (Lie-group Runge-Kutta-Munthe-Kaas with the quaternion exponential) or 2 (RATTLE velocity Verlet). Defaults to 0.
+            rattle_iterations (np.int32): Maximum number of fixed-point iterations (acceleration updates per step) of the implicit final kick of the RATTLE scheme. Defaults to 2.
+            multirate_micro_periods (np.int32): Number of gait periods resolved with the integrator between stroboscopic macro-steps. Defaults to 1.
+            multirate_macro_periods (np.int32): Number of gait periods skipped by each stroboscopic macro-step. Non-positive values resolve all periods. Defaults to 0.
+            periodic_orbit_tol (np.double): Newton residual tolerance of the periodic orbit solve. Positive values find the periodic state by shooting over one gait period instead of integrating to the final time. Defaults to 0.0.
+            steady_state_tol (np.double): Relative tolerance of the per-period mean body velocities, heights above the wall and mean hydrodynamic energies. Positive values stop the run once each changes by at most steady_state_tol * |value| + steady_state_atol over steady_state_periods consecutive gait periods. Defaults to 0.0.
+            steady_state_atol (np.double): Absolute tolerance of the steady-state monitor, for quantities that vanish at the steady state. Defaults to 0.0.
+            steady_state_periods (np.int32): Number of consecutive gait periods of the steady-state monitor. Defaults to 3.
+            parareal_slices (np.int32): Number of time slices integrated in parallel with parareal iterations. Values less than 2 integrate serially. Defaults to 0.
+            parareal_coarse_ratio (np.int32): Ratio of the coarse to the fine time step of the parareal iterations. Must divide the number of time steps per slice. Defaults to 10.
+            parareal_tol (np.double): Relative tolerance of the slice states of the parareal iterations. Defaults to 1e-8.
         """
 
         # Convert data types to GSD expected type
@@ -93,6 +124,26 @@ class GSDUtilPy:
         wca_sigma = np.array([wca_sigma], dtype=np.double)
 
         image_system = np.array([image_system], dtype=np.int32)
+        matrix_free_hydro = np.array([matrix_free_hydro], dtype=np.int32)
+        pair_tolerance = np.array([pair_tolerance], dtype=np.double)
+        neighbor_skin = np.array([neighbor_skin], dtype=np.double)
+        treecode_theta = np.array([treecode_theta], dtype=np.double)
+        mirror_hydro = np.array([mirror_hydro], dtype=np.int32)
+        adaptive_atol = np.array([adaptive_atol], dtype=np.double)
+        adaptive_rtol = np.array([adaptive_rtol], dtype=np.double)
+        udwadia_solver = np.array([udwadia_solver], dtype=np.int32)
+        udwadia_refactor_tol = np.array([udwadia_refactor_tol], dtype=np.double)
+        integrator_scheme = np.array([integrator_scheme], dtype=np.int32)
+        rattle_iterations = np.array([rattle_iterations], dtype=np.int32)
+        multirate_micro_periods = np.array([multirate_micro_periods], dtype=np.int32)
+        multirate_macro_periods = np.array([multirate_macro_periods], dtype=np.int32)
+        periodic_orbit_tol = np.array([periodic_orbit_tol], dtype=np.double)
+        steady_state_tol = np.array([steady_state_tol], dtype=np.double)
+        steady_state_atol = np.array([steady_state_atol], dtype=np.double)
+        steady_state_periods = np.array([steady_state_periods], dtype=np.int32)
+        parareal_slices = np.array([parareal_slices], dtype=np.int32)
+        parareal_coarse_ratio = np.array([parareal_coarse_ratio], dtype=np.int32)
+        parareal_tol = np.array([parareal_tol], dtype=np.double)
 
         zero = np.array([0.0], dtype=np.double)
 
@@ -110,6 +161,26 @@ class GSDUtilPy:
         self.snapshot.log['wca/sigma'] = wca_sigma
 
         self.snapshot.log['parameters/image_system'] = image_system
+        self.snapshot.log['parameters/matrix_free_hydro'] = matrix_free_hydro
+        self.snapshot.log['parameters/pair_tolerance'] = pair_tolerance
+        self.snapshot.log['parameters/neighbor_skin'] = neighbor_skin
+        self.snapshot.log['parameters/treecode_theta'] = treecode_theta
+        self.snapshot.log['parameters/mirror_hydro'] = mirror_hydro
+        self.snapshot.log['parameters/adaptive_atol'] = adaptive_atol
+        self.snapshot.log['parameters/adaptive_rtol'] = adaptive_rtol
+        self.snapshot.log['parameters/udwadia_solver'] = udwadia_solver
+        self.snapshot.log['parameters/udwadia_refactor_tol'] = udwadia_refactor_tol
+        self.snapshot.log['parameters/integrator_scheme'] = integrator_scheme
+        self.snapshot.log['parameters/rattle_iterations'] = rattle_iterations
+        self.snapshot.log['parameters/multirate_micro_periods'] = multirate_micro_periods
+        self.snapshot.log['parameters/multirate_macro_periods'] = multirate_macro_periods
+        self.snapshot.log['parameters/periodic_orbit_tol'] = periodic_orbit_tol
+        self.snapshot.log['parameters/steady_state_tol'] = steady_state_tol
+        self.snapshot.log['parameters/steady_state_atol'] = steady_state_atol
+        self.snapshot.log['parameters/steady_state_periods'] = steady_state_periods
+        self.snapshot.log['parameters/parareal_slices'] = parareal_slices
+        self.snapshot.log['parameters/parareal_coarse_ratio'] = parareal_coarse_ratio
+        self.snapshot.log['parameters/parareal_tol'] = parareal_tol
 
         self.snapshot.log['hydrodynamics/E_simple'] = zero
         self.snapshot.log['hydrodynamics/E_locater'] = zero
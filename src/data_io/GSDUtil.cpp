@@ -265,6 +265,199 @@ GSDUtil::readParameters()
     spdlog::get(m_logName)->info("image_sys : {0}", image_system);
     assert(image_system == m_system->imageSystem() && "image_sys not properly set");
 
+    // NOTE: optional parameter, defaults to the tensor force evaluation if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing matrix_free_hydro");
+    int matrix_free_hydro_int{-1};
+    return_bool = readChunk(&matrix_free_hydro_int, m_frame, "log/parameters/matrix_free_hydro", 4);
+    if (return_bool)
+    {
+        m_system->setMatrixFreeHydro(matrix_free_hydro_int == 1);
+    }
+    spdlog::get(m_logName)->info("matrix_free_hydro : {0}", m_system->matrixFreeHydro());
+
+    // NOTE: optional parameters, default to evaluating all particle pairs if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing pair_tolerance");
+    double pair_tolerance{-1.0};
+    return_bool = readChunk(&pair_tolerance, m_frame, "log/parameters/pair_tolerance", 8);
+    if (return_bool)
+    {
+        m_system->setPairTolerance(pair_tolerance);
+    }
+    spdlog::get(m_logName)->info("pair_tolerance : {0}", m_system->pairTolerance());
+
+    spdlog::get(m_logName)->info("GSD parsing neighbor_skin");
+    double neighbor_skin{-1.0};
+    return_bool = readChunk(&neighbor_skin, m_frame, "log/parameters/neighbor_skin", 8);
+    if (return_bool)
+    {
+        m_system->setNeighborSkin(neighbor_skin);
+    }
+    spdlog::get(m_logName)->info("neighbor_skin : {0}", m_system->neighborSkin());
+
+    // NOTE: optional parameter, defaults to dense added mass matrix-vector products if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing treecode_theta");
+    double treecode_theta{-1.0};
+    return_bool = readChunk(&treecode_theta, m_frame, "log/parameters/treecode_theta", 8);
+    if (return_bool)
+    {
+        m_system->setTreecodeTheta(treecode_theta);
+    }
+    spdlog::get(m_logName)->info("treecode_theta : {0}", m_system->treecodeTheta());
+
+    // NOTE: optional parameter, defaults to storing all image system particles if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing mirror_hydro");
+    int mirror_hydro_int{-1};
+    return_bool = readChunk(&mirror_hydro_int, m_frame, "log/parameters/mirror_hydro", 4);
+    if (return_bool)
+    {
+        m_system->setMirrorHydro(mirror_hydro_int == 1);
+    }
+    spdlog::get(m_logName)->info("mirror_hydro : {0}", m_system->mirrorHydro());
+
+    // NOTE: optional parameters, default to fixed time step integration if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing adaptive_atol");
+    double adaptive_atol{-1.0};
+    return_bool = readChunk(&adaptive_atol, m_frame, "log/parameters/adaptive_atol", 8);
+    if (return_bool)
+    {
+        m_system->setAdaptiveAtol(adaptive_atol);
+    }
+    spdlog::get(m_logName)->info("adaptive_atol : {0}", m_system->adaptiveAtol());
+
+    spdlog::get(m_logName)->info("GSD parsing adaptive_rtol");
+    double adaptive_rtol{-1.0};
+    return_bool = readChunk(&adaptive_rtol, m_frame, "log/parameters/adaptive_rtol", 8);
+    if (return_bool)
+    {
+        m_system->setAdaptiveRtol(adaptive_rtol);
+    }
+    spdlog::get(m_logName)->info("adaptive_rtol : {0}", m_system->adaptiveRtol());
+
+    // NOTE: optional parameter, defaults to the eigendecomposition solver if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing udwadia_solver");
+    int udwadia_solver{-1};
+    return_bool = readChunk(&udwadia_solver, m_frame, "log/parameters/udwadia_solver", 4);
+    if (return_bool)
+    {
+        m_system->setUdwadiaSolver(udwadia_solver);
+    }
+    spdlog::get(m_logName)->info("udwadia_solver : {0}", m_system->udwadiaSolver());
+
+    // NOTE: optional parameter, defaults to factorizing the effective mass matrix at every solve
+    spdlog::get(m_logName)->info("GSD parsing udwadia_refactor_tol");
+    double udwadia_refactor_tol{-1.0};
+    return_bool = readChunk(&udwadia_refactor_tol, m_frame, "log/parameters/udwadia_refactor_tol", 8);
+    if (return_bool)
+    {
+        m_system->setUdwadiaRefactorTol(udwadia_refactor_tol);
+    }
+    spdlog::get(m_logName)->info("udwadia_refactor_tol : {0}", m_system->udwadiaRefactorTol());
+
+    // NOTE: optional parameter, defaults to classical Runge-Kutta if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing integrator_scheme");
+    int integrator_scheme{-1};
+    return_bool = readChunk(&integrator_scheme, m_frame, "log/parameters/integrator_scheme", 4);
+    if (return_bool)
+    {
+        m_system->setIntegratorScheme(integrator_scheme);
+    }
+    spdlog::get(m_logName)->info("integrator_scheme : {0}", m_system->integratorScheme());
+
+    // NOTE: optional parameter, defaults to two fixed-point iterations of the RATTLE final kick if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing rattle_iterations");
+    int rattle_iterations{-1};
+    return_bool = readChunk(&rattle_iterations, m_frame, "log/parameters/rattle_iterations", 4);
+    if (return_bool)
+    {
+        m_system->setRattleIterations(rattle_iterations);
+    }
+    spdlog::get(m_logName)->info("rattle_iterations : {0}", m_system->rattleIterations());
+
+    // NOTE: optional parameters, default to resolving every gait period if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing multirate_micro_periods");
+    int multirate_micro_periods{-1};
+    return_bool = readChunk(&multirate_micro_periods, m_frame, "log/parameters/multirate_micro_periods", 4);
+    if (return_bool)
+    {
+        m_system->setMultirateMicroPeriods(multirate_micro_periods);
+    }
+    spdlog::get(m_logName)->info("multirate_micro_periods : {0}", m_system->multirateMicroPeriods());
+
+    spdlog::get(m_logName)->info("GSD parsing multirate_macro_periods");
+    int multirate_macro_periods{-1};
+    return_bool = readChunk(&multirate_macro_periods, m_frame, "log/parameters/multirate_macro_periods", 4);
+    if (return_bool)
+    {
+        m_system->setMultirateMacroPeriods(multirate_macro_periods);
+    }
+    spdlog::get(m_logName)->info("multirate_macro_periods : {0}", m_system->multirateMacroPeriods());
+
+    // NOTE: optional parameter, defaults to integrating to the final time if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing periodic_orbit_tol");
+    double periodic_orbit_tol{-1.0};
+    return_bool = readChunk(&periodic_orbit_tol, m_frame, "log/parameters/periodic_orbit_tol", 8);
+    if (return_bool)
+    {
+        m_system->setPeriodicOrbitTol(periodic_orbit_tol);
+    }
+    spdlog::get(m_logName)->info("periodic_orbit_tol : {0}", m_system->periodicOrbitTol());
+
+    // NOTE: optional parameters, default to integrating to the final time if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing steady_state_tol");
+    double steady_state_tol{-1.0};
+    return_bool = readChunk(&steady_state_tol, m_frame, "log/parameters/steady_state_tol", 8);
+    if (return_bool)
+    {
+        m_system->setSteadyStateTol(steady_state_tol);
+    }
+    spdlog::get(m_logName)->info("steady_state_tol : {0}", m_system->steadyStateTol());
+
+    spdlog::get(m_logName)->info("GSD parsing steady_state_atol");
+    double steady_state_atol{-1.0};
+    return_bool = readChunk(&steady_state_atol, m_frame, "log/parameters/steady_state_atol", 8);
+    if (return_bool)
+    {
+        m_system->setSteadyStateAtol(steady_state_atol);
+    }
+    spdlog::get(m_logName)->info("steady_state_atol : {0}", m_system->steadyStateAtol());
+
+    spdlog::get(m_logName)->info("GSD parsing steady_state_periods");
+    int steady_state_periods{-1};
+    return_bool = readChunk(&steady_state_periods, m_frame, "log/parameters/steady_state_periods", 4);
+    if (return_bool)
+    {
+        m_system->setSteadyStatePeriods(steady_state_periods);
+    }
+    spdlog::get(m_logName)->info("steady_state_periods : {0}", m_system->steadyStatePeriods());
+
+    // NOTE: optional parameters, default to serial time integration if not present in GSD
+    spdlog::get(m_logName)->info("GSD parsing parareal_slices");
+    int parareal_slices{-1};
+    return_bool = readChunk(&parareal_slices, m_frame, "log/parameters/parareal_slices", 4);
+    if (return_bool)
+    {
+        m_system->setPararealSlices(parareal_slices);
+    }
+    spdlog::get(m_logName)->info("parareal_slices : {0}", m_system->pararealSlices());
+
+    spdlog::get(m_logName)->info("GSD parsing parareal_coarse_ratio");
+    int parareal_coarse_ratio{-1};
+    return_bool = readChunk(&parareal_coarse_ratio, m_frame, "log/parameters/parareal_coarse_ratio", 4);
+    if (return_bool)
+    {
+        m_system->setPararealCoarseRatio(parareal_coarse_ratio);
+    }
+    spdlog::get(m_logName)->info("parareal_coarse_ratio : {0}", m_system->pararealCoarseRatio());
+
+    spdlog::get(m_logName)->info("GSD parsing parareal_tol");
+    double parareal_tol{-1.0};
+    return_bool = readChunk(&parareal_tol, m_frame, "log/parameters/parareal_tol", 8);
+    if (return_bool)
+    {
+        m_system->setPararealTol(parareal_tol);
+    }
+    spdlog::get(m_logName)->info("parareal_tol : {0}", m_system->pararealTol());
+
     spdlog::get(m_logName)->info("GSD parsing typeid");
     uint32_t types[m_system->numParticles()];
     return_bool =
@@ -557,6 +750,56 @@ GSDUtil::writeParameters()
                                  (void*)&e_simple);
     m_system->setReturnVal(return_val);
     checkGSDReturn();
+
+    // NOTE: periodic orbit results are only available after `PeriodicOrbit::solve()`
+    if (m_system->floquetMultipliers().size() > 0)
+    {
+        spdlog::get(m_logName)->info("GSD writing log/periodic_orbit/residual");
+        double po_res = m_system->periodicOrbitResidual();
+        return_val    = gsd_write_chunk(m_system->handle().get(), "log/periodic_orbit/residual", GSD_TYPE_DOUBLE, 1, 1,
+                                        0, (void*)&po_res);
+        m_system->setReturnVal(return_val);
+        checkGSDReturn();
+
+        spdlog::get(m_logName)->info("GSD writing log/periodic_orbit/displacement");
+        Eigen::Vector3d po_disp = m_system->periodicOrbitDisplacement();
+        return_val              = gsd_write_chunk(m_system->handle().get(), "log/periodic_orbit/displacement",
+                                                  GSD_TYPE_DOUBLE, 1, 3, 0, (void*)po_disp.data());
+        m_system->setReturnVal(return_val);
+        checkGSDReturn();
+
+        // NOTE: row-major (k x 2) array of real and imaginary parts
+        spdlog::get(m_logName)->info("GSD writing log/periodic_orbit/floquet_multipliers");
+        const uint64_t      num_multipliers = m_system->floquetMultipliers().rows();
+        std::vector<double> po_floquet(2 * num_multipliers);
+        for (uint64_t i = 0; i < num_multipliers; i++)
+        {
+            po_floquet[2 * i]     = m_system->floquetMultipliers()(i, 0);
+            po_floquet[2 * i + 1] = m_system->floquetMultipliers()(i, 1);
+        }
+        return_val = gsd_write_chunk(m_system->handle().get(), "log/periodic_orbit/floquet_multipliers",
+                                     GSD_TYPE_DOUBLE, num_multipliers, 2, 0, (void*)po_floquet.data());
+        m_system->setReturnVal(return_val);
+        checkGSDReturn();
+    }
+
+    // NOTE: steady-state results are only available once `Engine` detected the steady state
+    if (m_system->steadyStateTime() >= 0.0)
+    {
+        spdlog::get(m_logName)->info("GSD writing log/steady_state/t");
+        double ss_time = m_system->steadyStateTime();
+        return_val     = gsd_write_chunk(m_system->handle().get(), "log/steady_state/t", GSD_TYPE_DOUBLE, 1, 1, 0,
+                                         (void*)&ss_time);
+        m_system->setReturnVal(return_val);
+        checkGSDReturn();
+
+        spdlog::get(m_logName)->info("GSD writing log/steady_state/values");
+        Eigen::VectorXd ss_values = m_system->steadyStateValues();
+        return_val                = gsd_write_chunk(m_system->handle().get(), "log/steady_state/values",
+                                                    GSD_TYPE_DOUBLE, 1, ss_values.size(), 0, (void*)ss_values.data());
+        m_system->setReturnVal(return_val);
+        checkGSDReturn();
+    }
 }
 
 void
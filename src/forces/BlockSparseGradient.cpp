@@ -0,0 +1,175 @@
+//
+// Created by Alec Glisman on 11/02/21
+//
+
+#include <BlockSparseGradient.hpp>
+
+BlockSparseGradient::BlockSparseGradient(const int num_particles, const Eigen::VectorXi& alpha_vec,
+                                         const Eigen::VectorXi& beta_vec)
+    : m_num_particles(num_particles)
+{
+    setPairs(alpha_vec, beta_vec);
+}
+
+void
+BlockSparseGradient::setPairs(const Eigen::VectorXi& alpha_vec, const Eigen::VectorXi& beta_vec)
+{
+    if (alpha_vec.size() != beta_vec.size())
+    {
+        throw std::invalid_argument("BlockSparseGradient: pair vectors must have the same length");
+    }
+
+    /* lookup table from (alpha, beta) to pair number
+     * NOTE: only the entries of the previous pairs are reset, so replacing the pairs costs O(pairs) */
+    if ((m_pair_id.rows() != m_num_particles) || (m_pair_id.cols() != m_num_particles))
+    {
+        m_pair_id = Eigen::MatrixXi::Constant(m_num_particles, m_num_particles, -1);
+    }
+    else
+    {
+        for (int k = 0; k < m_num_pairs; k++)
+        {
+            m_pair_id(m_alpha_vec(k), m_beta_vec(k)) = -1;
+            m_pair_id(m_beta_vec(k), m_alpha_vec(k)) = -1;
+        }
+    }
+
+    m_num_pairs = alpha_vec.size();
+    m_alpha_vec.resize(m_num_pairs);
+    m_beta_vec.resize(m_num_pairs);
+    m_alpha_vec = alpha_vec;
+    m_beta_vec  = beta_vec;
+
+    for (int k = 0; k < m_num_pairs; k++)
+    {
+        assert(m_alpha_vec(k) != m_beta_vec(k) && "Particle pair must contain two different particles");
+
+        m_pair_id(m_alpha_vec(k), m_beta_vec(k)) = k;
+        m_pair_id(m_beta_vec(k), m_alpha_vec(k)) = k;
+    }
+
+    m_blocks.resize(m_num_pairs);
+    setZero();
+}
+
+void
+BlockSparseGradient::setZero()
+{
+    for (auto& block : m_blocks)
+    {
+        block.setZero();
+    }
+}
+
+BlockSparseGradient::Block
+BlockSparseGradient::element(const int alpha, const int beta, const int gamma) const
+{
+    Block element;
+    element.setZero();
+
+    // diagonal blocks of the added mass matrix are configuration independent
+    if (alpha == beta)
+    {
+        return element;
+    }
+
+    const int k{m_pair_id(alpha, beta)};
+
+    if (k < 0)
+    {
+        return element;
+    }
+
+    if (gamma == m_alpha_vec(k))
+    {
+        element = m_blocks[k];
+    }
+    else if (gamma == m_beta_vec(k))
+    {
+        element = -m_blocks[k];
+    }
+
+    return element;
+}
+
+void
+BlockSparseGradient::contractChi(const Eigen::Tensor<double, 2>& tens_chi,
+                                 Eigen::Tensor<double, 3>& grad_body_coords, const Eigen::ThreadPoolDevice& device) const
+{
+    const int m7{static_cast<int>(tens_chi.dimension(0))};
+    const int num_chunks{numParallelChunks(device, m_num_pairs, m_min_pairs_per_chunk)};
+
+    evaluateTensor(device, grad_body_coords.size(), grad_body_coords, grad_body_coords.constant(0.0));
+
+    parallelForChunks(device, num_chunks, m_num_pairs, [&](const int chunk_id, const int begin, const int end) {
+        for (int k = begin; k < end; k++)
+        {
+            const int i_3{3 * m_alpha_vec(k)};
+            const int j_3{3 * m_beta_vec(k)};
+
+            const int i_7{7 * m_alpha_vec(k)};
+            const int j_7{7 * m_beta_vec(k)};
+
+            const Block& B = m_blocks[k];
+
+            for (int c = 0; c < m7; c++)
+            {
+                // \chi_{c, \alpha} - \chi_{c, \beta}: gradient blocks w.r.t. \beta are the negative of those w.r.t.
+                // \alpha
+                const double d_0{tens_chi(c, i_3) - tens_chi(c, j_3)};
+                const double d_1{tens_chi(c, i_3 + 1) - tens_chi(c, j_3 + 1)};
+                const double d_2{tens_chi(c, i_3 + 2) - tens_chi(c, j_3 + 2)};
+
+                // \chi is only non-zero on the rows of the body each particle belongs to
+                if ((d_0 == 0.0) && (d_1 == 0.0) && (d_2 == 0.0))
+                {
+                    continue;
+                }
+
+                for (int q = 0; q < 3; q++)
+                {
+                    for (int p = 0; p < 3; p++)
+                    {
+                        const double val{B(p, q, 0) * d_0 + B(p, q, 1) * d_1 + B(p, q, 2) * d_2};
+
+                        grad_body_coords(i_7 + p, j_7 + q, c) = val; // M_{\alpha \beta}
+                        grad_body_coords(j_7 + p, i_7 + q, c) = val; // M_{\beta \alpha}
+                    }
+                }
+            }
+        }
+    });
+}
+
+Eigen::Tensor<double, 3>
+BlockSparseGradient::toDense() const
+{
+    const int n3{3 * m_num_particles};
+    const int n7{7 * m_num_particles};
+
+    Eigen::Tensor<double, 3> dense = Eigen::Tensor<double, 3>(n7, n7, n3);
+    dense.setZero();
+
+    const Eigen::array<Eigen::Index, 3> extents = {3, 3, 3};
+
+    for (int k = 0; k < m_num_pairs; k++)
+    {
+        const int i_3{3 * m_alpha_vec(k)};
+        const int j_3{3 * m_beta_vec(k)};
+
+        const int i_7{7 * m_alpha_vec(k)};
+        const int j_7{7 * m_beta_vec(k)};
+
+        const Eigen::array<Eigen::Index, 3> offsets_ij_i = {i_7, j_7, i_3};
+        const Eigen::array<Eigen::Index, 3> offsets_ij_j = {i_7, j_7, j_3};
+        const Eigen::array<Eigen::Index, 3> offsets_ji_i = {j_7, i_7, i_3};
+        const Eigen::array<Eigen::Index, 3> offsets_ji_j = {j_7, i_7, j_3};
+
+        dense.slice(offsets_ij_i, extents) = m_blocks[k];
+        dense.slice(offsets_ij_j, extents) = -m_blocks[k];
+        dense.slice(offsets_ji_j, extents) = -m_blocks[k];
+        dense.slice(offsets_ji_i, extents) = m_blocks[k];
+    }
+
+    return dense;
+}
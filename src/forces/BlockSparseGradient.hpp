@@ -0,0 +1,174 @@
+//
+// Created by Alec Glisman on 11/02/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_BLOCK_SPARSE_GRADIENT_H
+#define BODIES_IN_POTENTIAL_FLOW_BLOCK_SPARSE_GRADIENT_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all external project dependencies */
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// eigen3 thread-pool parallel loops
+#include <helper_eigenParallelFor.hpp>
+// eigen3 size-aware evaluation of tensor expressions
+#include <helper_eigenExecutionPolicy.hpp>
+// STL
+#include <cassert>   // assert()
+#include <stdexcept> // std::errors
+#include <vector>    // std::vector
+
+/**
+ * @class BlockSparseGradient
+ *
+ * @brief Pair-indexed block-sparse storage of the (7N x 7N x 3N) gradient of the added mass matrix with respect to the
+ * (linear) particle positions.
+ *
+ * @details Each pairwise interaction @f$ (\alpha, \beta) @f$ with @f$ \alpha < \beta @f$ only contributes four
+ * (3 x 3 x 3) blocks to the dense gradient, all of which are equal up to a sign:
+ *     @f$ \nabla_{\alpha} M_{\alpha \beta} = \nabla_{\alpha} M_{\beta \alpha} = B @f$,
+ *     @f$ \nabla_{\beta} M_{\alpha \beta} = \nabla_{\beta} M_{\beta \alpha} = -B @f$.
+ * Only @f$ B @f$ is stored for each pair, so memory scales with the number of pairs rather than @f$ N^3 @f$.
+ * Pair `k` corresponds to particles (`alpha(k)`, `beta(k)`) of the pair list in `PotentialHydrodynamics`.
+ *
+ */
+class BlockSparseGradient
+{
+  public:
+    /// (3 x 3 x 3) gradient block of a single particle pair
+    using Block = Eigen::TensorFixedSize<double, Eigen::Sizes<3, 3, 3>>;
+
+    /**
+     * @brief Construct a new (empty) block sparse gradient object
+     *
+     */
+    BlockSparseGradient() = default;
+
+    /**
+     * @brief Construct a new block sparse gradient object
+     *
+     * @param num_particles number of particles, N
+     * @param alpha_vec (s x 1) first particle number in pairwise interactions
+     * @param beta_vec (s x 1) second particle number in pairwise interactions
+     */
+    BlockSparseGradient(const int num_particles, const Eigen::VectorXi& alpha_vec, const Eigen::VectorXi& beta_vec);
+
+    /**
+     * @brief Sets the pair list that blocks are keyed by and zeros all blocks
+     *
+     * @param alpha_vec (s x 1) first particle number in pairwise interactions
+     * @param beta_vec (s x 1) second particle number in pairwise interactions
+     */
+    void
+    setPairs(const Eigen::VectorXi& alpha_vec, const Eigen::VectorXi& beta_vec);
+
+    /**
+     * @brief Sets all stored blocks to zero
+     *
+     */
+    void
+    setZero();
+
+    /**
+     * @brief (3 x 3 x 3) element of the dense gradient tensor at offset (7 `alpha`, 7 `beta`, 3 `gamma`)
+     *
+     * @param alpha first particle number (row of mass matrix)
+     * @param beta second particle number (column of mass matrix)
+     * @param gamma particle number the gradient is taken with respect to
+     * @return Block gradient block (zero if no pair contributes)
+     */
+    Block
+    element(const int alpha, const int beta, const int gamma) const;
+
+    /**
+     * @brief Contracts the gradient with the change of variable tensor @f$ \boldsymbol{\chi} @f$ to convert the
+     * gradient to body coordinates.
+     *
+     * @details Computes @f$ G_{a b c} = \sum_{l} (\nabla M)_{a b l} \, \chi_{c l} @f$ one particle pair at a time
+     * without forming the dense (7N x 7N x 3N) tensor.
+     * Particle pairs are split across the thread-pool of `device`; each pair writes to disjoint elements.
+     *
+     * @param tens_chi (7M x 3N) change of variable tensor
+     * @param grad_body_coords (output) (7N x 7N x 7M) gradient in body coordinates
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     */
+    void
+    contractChi(const Eigen::Tensor<double, 2>& tens_chi, Eigen::Tensor<double, 3>& grad_body_coords,
+                const Eigen::ThreadPoolDevice& device) const;
+
+    /**
+     * @brief Assembles the dense (7N x 7N x 3N) gradient tensor.
+     *
+     * @warning Memory scales as @f$ N^3 @f$, only intended for debugging and testing.
+     *
+     * @return Eigen::Tensor<double, 3> dense gradient tensor
+     */
+    Eigen::Tensor<double, 3>
+    toDense() const;
+
+  private:
+    /// = N
+    int m_num_particles{0};
+    /// = s. Number of stored pairs
+    int m_num_pairs{0};
+
+    /// (s x 1) first particle number in pairwise interactions
+    Eigen::VectorXi m_alpha_vec;
+    /// (s x 1) second particle number in pairwise interactions
+    Eigen::VectorXi m_beta_vec;
+    /// (N x N) pair number of particle pair (-1 if pair is not stored)
+    Eigen::MatrixXi m_pair_id;
+
+    /// (s x 1) gradient blocks @f$ B = \nabla_{\alpha} M_{\alpha \beta} @f$
+    std::vector<Block> m_blocks;
+
+    /// Minimum number of particle pairs evaluated per thread-pool task
+    static constexpr int m_min_pairs_per_chunk{64};
+
+  public:
+    int
+    numPairs() const
+    {
+        return m_num_pairs;
+    }
+
+    int
+    alpha(const int pair_id) const
+    {
+        return m_alpha_vec(pair_id);
+    }
+
+    int
+    beta(const int pair_id) const
+    {
+        return m_beta_vec(pair_id);
+    }
+
+    const Block&
+    block(const int pair_id) const
+    {
+        return m_blocks[pair_id];
+    }
+
+    Block&
+    block(const int pair_id)
+    {
+        return m_blocks[pair_id];
+    }
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_BLOCK_SPARSE_GRADIENT_H
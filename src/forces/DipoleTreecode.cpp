@@ -0,0 +1,332 @@
+//
+// Created by Alec Glisman on 11/06/21
+//
+
+#include <DipoleTreecode.hpp>
+
+DipoleTreecode::DipoleTreecode(const int num_particles, const double theta, const int leaf_size)
+    : m_num_particles(num_particles), m_theta(theta), m_leaf_size(leaf_size)
+{
+    if ((m_theta <= 0.0) || (m_theta >= 1.0))
+    {
+        throw std::invalid_argument("DipoleTreecode: opening angle must be in (0, 1)");
+    }
+    if (m_leaf_size < 1)
+    {
+        throw std::invalid_argument("DipoleTreecode: leaf size must be positive");
+    }
+
+    m_positions = Eigen::Matrix3Xd::Zero(3, m_num_particles);
+    m_order.resize(m_num_particles);
+}
+
+void
+DipoleTreecode::build(const Eigen::VectorXd& positions)
+{
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        m_positions.col(particle_id).noalias() = positions.segment<3>(3 * particle_id);
+        m_order[particle_id]                   = particle_id;
+    }
+
+    // root node: cube enclosing all particles
+    const Eigen::Vector3d lower = m_positions.rowwise().minCoeff();
+    const Eigen::Vector3d upper = m_positions.rowwise().maxCoeff();
+
+    Node root;
+    root.center = 0.50 * (lower + upper);
+    root.begin  = 0;
+    root.end    = m_num_particles;
+
+    m_nodes.clear();
+    m_nodes.push_back(root);
+
+    buildNode(0, 0.50 * (upper - lower).maxCoeff(), 0);
+
+    m_node_sum.resize(3, static_cast<Eigen::Index>(m_nodes.size()));
+    m_node_moment.resize(m_nodes.size());
+}
+
+void
+DipoleTreecode::buildNode(const int node_id, const double half_width, const int depth)
+{
+    const Eigen::Vector3d center = m_nodes[node_id].center;
+    const int             begin{m_nodes[node_id].begin};
+    const int             end{m_nodes[node_id].end};
+
+    // tight radius about bounding box center
+    double radius_sqr{0.0};
+    for (int k = begin; k < end; k++)
+    {
+        radius_sqr = std::max(radius_sqr, (m_positions.col(m_order[k]) - center).squaredNorm());
+    }
+    m_nodes[node_id].radius = std::sqrt(radius_sqr);
+
+    if ((end - begin <= m_leaf_size) || (depth >= m_max_depth))
+    {
+        return;
+    }
+
+    /* ANCHOR: sort node particles by octant */
+    const auto octant = [&](const int particle_id) {
+        const Eigen::Vector3d r = m_positions.col(particle_id) - center;
+        return (r(0) >= 0.0 ? 1 : 0) + (r(1) >= 0.0 ? 2 : 0) + (r(2) >= 0.0 ? 4 : 0);
+    };
+
+    std::array<int, 9> octant_begin{};
+    for (int k = begin; k < end; k++)
+    {
+        octant_begin[octant(m_order[k]) + 1]++;
+    }
+    octant_begin[0] = begin;
+    for (int o = 0; o < 8; o++)
+    {
+        octant_begin[o + 1] += octant_begin[o];
+    }
+
+    std::vector<int>   sorted(end - begin);
+    std::array<int, 8> octant_fill{};
+    for (int k = begin; k < end; k++)
+    {
+        const int o{octant(m_order[k])};
+        sorted[octant_begin[o] - begin + octant_fill[o]++] = m_order[k];
+    }
+    std::copy(sorted.begin(), sorted.end(), m_order.begin() + begin);
+
+    /* ANCHOR: create contiguous child nodes, then recurse */
+    const double child_half_width{0.50 * half_width};
+    const int    first_child{static_cast<int>(m_nodes.size())};
+    int          num_children{0};
+
+    for (int o = 0; o < 8; o++)
+    {
+        if (octant_begin[o + 1] == octant_begin[o])
+        {
+            continue;
+        }
+
+        Node child;
+        child.center(0) = center(0) + ((o & 1) ? child_half_width : -child_half_width);
+        child.center(1) = center(1) + ((o & 2) ? child_half_width : -child_half_width);
+        child.center(2) = center(2) + ((o & 4) ? child_half_width : -child_half_width);
+        child.begin     = octant_begin[o];
+        child.end       = octant_begin[o + 1];
+
+        m_nodes.push_back(child);
+        num_children++;
+    }
+
+    m_nodes[node_id].first_child  = first_child;
+    m_nodes[node_id].num_children = num_children;
+
+    for (int c = 0; c < num_children; c++)
+    {
+        buildNode(first_child + c, child_half_width, depth + 1);
+    }
+}
+
+void
+DipoleTreecode::calcMoments(const Eigen::VectorXd& x, const Eigen::ThreadPoolDevice& device)
+{
+    const int num_nodes{static_cast<int>(m_nodes.size())};
+    const int num_chunks{numParallelChunks(device, num_nodes, m_min_targets_per_chunk)};
+
+    // NOTE: each node writes to its own moments, so chunks never conflict
+    parallelForChunks(device, num_chunks, num_nodes, [&](const int chunk_id, const int begin, const int end) {
+        for (int n = begin; n < end; n++)
+        {
+            const Node& node = m_nodes[n];
+
+            Eigen::Vector3d sum    = Eigen::Vector3d::Zero();
+            Eigen::Matrix3d moment = Eigen::Matrix3d::Zero();
+
+            for (int k = node.begin; k < node.end; k++)
+            {
+                const int             particle_id{m_order[k]};
+                const Eigen::Vector3d x_j = x.segment<3>(3 * particle_id);
+
+                sum.noalias() += x_j;
+                moment.noalias() += (m_positions.col(particle_id) - node.center) * x_j.transpose();
+            }
+
+            m_node_sum.col(n).noalias() = sum;
+            m_node_moment[n]            = moment;
+        }
+    });
+}
+
+void
+DipoleTreecode::apply(const Eigen::VectorXd& x, Eigen::VectorXd& y, const Eigen::ThreadPoolDevice& device)
+{
+    calcMoments(x, device);
+
+    const double theta_sqr{m_theta * m_theta};
+    const int    num_chunks{numParallelChunks(device, m_num_particles, m_min_targets_per_chunk)};
+
+    if (static_cast<int>(m_chunk_num_direct.size()) < num_chunks)
+    {
+        m_chunk_num_direct.resize(num_chunks);
+        m_chunk_num_far_field.resize(num_chunks);
+    }
+
+    // NOTE: each target particle writes to its own elements of y, so chunks never conflict
+    parallelForChunks(device, num_chunks, m_num_particles, [&](const int chunk_id, const int begin, const int end) {
+        std::vector<int> stack;
+        stack.reserve(8 * m_max_depth);
+
+        long num_direct{0};
+        long num_far_field{0};
+
+        for (int i = begin; i < end; i++)
+        {
+            const Eigen::Vector3d r_i = m_positions.col(i);
+            Eigen::Vector3d       y_i = Eigen::Vector3d::Zero();
+
+            stack.clear();
+            stack.push_back(0);
+
+            while (!stack.empty())
+            {
+                const int node_id{stack.back()};
+                stack.pop_back();
+
+                const Node& node = m_nodes[node_id];
+
+                const Eigen::Vector3d d = r_i - node.center;
+                const double          d_sqr{d.squaredNorm()};
+
+                if (node.radius * node.radius < theta_sqr * d_sqr)
+                {
+                    /* far-field: K(d) S - \nabla K(d) : D */
+                    const double d_inv_sqr{1.0 / d_sqr};
+                    const double d_inv_3{d_inv_sqr * std::sqrt(d_inv_sqr)};
+                    const double d_inv_5{d_inv_3 * d_inv_sqr};
+                    const double d_inv_7{d_inv_5 * d_inv_sqr};
+
+                    const Eigen::Vector3d  S = m_node_sum.col(node_id);
+                    const Eigen::Matrix3d& D = m_node_moment[node_id];
+
+                    y_i.noalias() += (0.50 * d_inv_3) * S;
+                    y_i.noalias() -= (1.50 * d_inv_5 * d.dot(S)) * d;
+
+                    y_i.noalias() += (1.50 * d_inv_5) * (D.transpose() * d + D * d + D.trace() * d);
+                    y_i.noalias() -= (7.50 * d_inv_7 * d.dot(D * d)) * d;
+
+                    num_far_field++;
+                }
+                else if (node.num_children == 0)
+                {
+                    /* near-field: direct sum over leaf particles */
+                    for (int k = node.begin; k < node.end; k++)
+                    {
+                        const int j{m_order[k]};
+
+                        if (j == i)
+                        {
+                            continue;
+                        }
+
+                        const Eigen::Vector3d r_ij = r_i - m_positions.col(j);
+                        const Eigen::Vector3d x_j  = x.segment<3>(3 * j);
+
+                        const double r_inv_sqr{1.0 / r_ij.squaredNorm()};
+                        const double r_inv_3{r_inv_sqr * std::sqrt(r_inv_sqr)};
+                        const double r_inv_5{r_inv_3 * r_inv_sqr};
+
+                        y_i.noalias() += (0.50 * r_inv_3) * x_j;
+                        y_i.noalias() -= (1.50 * r_inv_5 * r_ij.dot(x_j)) * r_ij;
+
+                        num_direct++;
+                    }
+                }
+                else
+                {
+                    for (int c = 0; c < node.num_children; c++)
+                    {
+                        stack.push_back(node.first_child + c);
+                    }
+                }
+            }
+
+            y.segment<3>(3 * i).noalias() = y_i;
+        }
+
+        m_chunk_num_direct[chunk_id]    = num_direct;
+        m_chunk_num_far_field[chunk_id] = num_far_field;
+    });
+
+    m_num_direct    = 0;
+    m_num_far_field = 0;
+    for (int chunk_id = 0; chunk_id < num_chunks; chunk_id++)
+    {
+        m_num_direct += m_chunk_num_direct[chunk_id];
+        m_num_far_field += m_chunk_num_far_field[chunk_id];
+    }
+}
+
+void
+DipoleTreecode::nearFieldPairs(const double padding, Eigen::VectorXi& alpha_vec, Eigen::VectorXi& beta_vec)
+{
+    const double theta_sqr{m_theta * m_theta};
+
+    std::vector<int> stack;
+    stack.reserve(8 * m_max_depth);
+
+    m_near_pairs.clear();
+
+    for (int i = 0; i < m_num_particles; i++)
+    {
+        const Eigen::Vector3d r_i = m_positions.col(i);
+
+        stack.clear();
+        stack.push_back(0);
+
+        while (!stack.empty())
+        {
+            const int node_id{stack.back()};
+            stack.pop_back();
+
+            const Node&  node = m_nodes[node_id];
+            const double radius{node.radius + padding};
+
+            if (radius * radius < theta_sqr * (r_i - node.center).squaredNorm())
+            {
+                continue;
+            }
+
+            if (node.num_children == 0)
+            {
+                for (int k = node.begin; k < node.end; k++)
+                {
+                    const int j{m_order[k]};
+
+                    if (j != i)
+                    {
+                        m_near_pairs.emplace_back(std::min(i, j), std::max(i, j));
+                    }
+                }
+            }
+            else
+            {
+                for (int c = 0; c < node.num_children; c++)
+                {
+                    stack.push_back(node.first_child + c);
+                }
+            }
+        }
+    }
+
+    // NOTE: pairs in the near-field of both particles were collected twice
+    std::sort(m_near_pairs.begin(), m_near_pairs.end());
+    m_near_pairs.erase(std::unique(m_near_pairs.begin(), m_near_pairs.end()), m_near_pairs.end());
+
+    const int num_pairs{static_cast<int>(m_near_pairs.size())};
+    alpha_vec.resize(num_pairs);
+    beta_vec.resize(num_pairs);
+
+    for (int k = 0; k < num_pairs; k++)
+    {
+        alpha_vec(k) = m_near_pairs[k].first;
+        beta_vec(k)  = m_near_pairs[k].second;
+    }
+}
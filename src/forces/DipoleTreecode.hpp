@@ -0,0 +1,207 @@
+//
+// Created by Alec Glisman on 11/06/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_DIPOLE_TREECODE_H
+#define BODIES_IN_POTENTIAL_FLOW_DIPOLE_TREECODE_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all external project dependencies */
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// eigen3 thread-pool parallel loops
+#include <helper_eigenParallelFor.hpp>
+// STL
+#include <algorithm> // std::max, std::min, std::copy, std::sort, std::unique
+#include <array>     // std::array
+#include <cmath>     // std::sqrt
+#include <stdexcept> // std::errors
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+/**
+ * @class DipoleTreecode
+ *
+ * @brief Barnes-Hut treecode for matrix-vector products with the pairwise point-dipole kernel of the added mass
+ * matrix.
+ *
+ * @details Approximates @f$ y_{i} = \sum_{j \neq i} \boldsymbol{K}(\boldsymbol{r}_{i} - \boldsymbol{r}_{j}) \,
+ * x_{j} @f$, with @f$ \boldsymbol{K}(\boldsymbol{r}) = \frac{1}{2} \boldsymbol{I} / r^3 - \frac{3}{2}
+ * \boldsymbol{r} \boldsymbol{r}^{\mathrm{T}} / r^5 @f$ the (3 x 3) off-diagonal block built in
+ * `PotentialHydrodynamics::calcAddedMass()` (without mass units).
+ * Particles are sorted into an octree.
+ * Each node stores the zeroth and first moments of the source vectors about its center, so far-field node
+ * contributions are evaluated from a two-term Taylor expansion of the kernel.
+ * A node of radius @f$ R @f$ is evaluated in the far-field from a target at distance @f$ d @f$ if
+ * @f$ R < \theta \, d @f$, giving a relative error of @f$ \mathcal{O}(\theta^2) @f$ and
+ * @f$ \mathcal{O}(N \log N) @f$ cost per product. Smaller opening angles @f$ \theta @f$ are more accurate.
+ *
+ */
+class DipoleTreecode
+{
+  public:
+    /**
+     * @brief Construct a new (empty) dipole treecode object
+     *
+     */
+    DipoleTreecode() = default;
+
+    /**
+     * @brief Construct a new dipole treecode object
+     *
+     * @param num_particles number of particles, N
+     * @param theta opening angle of far-field criterion, in (0, 1)
+     * @param leaf_size maximum number of particles in a leaf node
+     */
+    DipoleTreecode(const int num_particles, const double theta, const int leaf_size = 8);
+
+    /**
+     * @brief Builds the octree at the input particle positions
+     *
+     * @param positions (3N x 1) particle positions
+     */
+    void
+    build(const Eigen::VectorXd& positions);
+
+    /**
+     * @brief Evaluates the matrix-vector product of the pairwise dipole kernel with `x` at the positions of the last
+     * `build()`
+     *
+     * @details Target particles are split across the thread-pool of `device`.
+     *
+     * @param x (3N x 1) source vectors
+     * @param y (output) (3N x 1) kernel product
+     * @param device device (CPU thread-pool or GPU) used to speed up calculations
+     */
+    void
+    apply(const Eigen::VectorXd& x, Eigen::VectorXd& y, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Collects the particle pairs in the near-field of each other at the positions of the last `build()`
+     *
+     * @details Uses the far-field criterion of `apply()` with node radii enlarged by `padding`, so pairs closer than
+     * `padding` / @f$ 	heta @f$ are always in the near-field.
+     * A pair is included if either particle is in the near-field of the other.
+     * Pairs are sorted with `alpha_vec(k)` < `beta_vec(k)`.
+     * For bounded particle densities the number of pairs is @f$ \mathcal{O}(N) @f$.
+     *
+     * @param padding distance added to node radii in the far-field criterion
+     * @param alpha_vec (output) first particle of pairs
+     * @param beta_vec (output) second particle of pairs
+     */
+    void
+    nearFieldPairs(const double padding, Eigen::VectorXi& alpha_vec, Eigen::VectorXi& beta_vec);
+
+  private:
+    /// octree node of a contiguous range of `m_order`
+    struct Node
+    {
+        /// center of node bounding box
+        Eigen::Vector3d center;
+        /// maximum distance of node particles from `center`
+        double radius{0.0};
+        /// first entry of `m_order` in node
+        int begin{0};
+        /// one past last entry of `m_order` in node
+        int end{0};
+        /// index of first child node in `m_nodes` (children are contiguous)
+        int first_child{-1};
+        /// number of child nodes (0 for leaf nodes)
+        int num_children{0};
+    };
+
+    /**
+     * @brief Recursively subdivides node `node_id` into octants
+     *
+     * @param node_id index of node in `m_nodes`
+     * @param half_width half of the node bounding box side length
+     * @param depth depth of node in tree
+     */
+    void
+    buildNode(const int node_id, const double half_width, const int depth);
+
+    /**
+     * @brief Computes the zeroth and first moments of the source vectors `x` in each node
+     *
+     * @param x (3N x 1) source vectors
+     * @param device device (CPU thread-pool or GPU) used to speed up calculations
+     */
+    void
+    calcMoments(const Eigen::VectorXd& x, const Eigen::ThreadPoolDevice& device);
+
+    /// = N
+    int m_num_particles{0};
+    /// opening angle of far-field criterion
+    double m_theta{0.5};
+    /// maximum number of particles in a leaf node
+    int m_leaf_size{8};
+    /// maximum depth of tree (limits recursion for coincident particles)
+    static constexpr int m_max_depth{32};
+    /// Minimum number of target particles evaluated per thread-pool task
+    static constexpr int m_min_targets_per_chunk{16};
+
+    /// (3 x N) particle positions at last build
+    Eigen::Matrix3Xd m_positions;
+    /// (N x 1) particle numbers, sorted such that each node is a contiguous range
+    std::vector<int> m_order;
+    /// octree nodes, root node first
+    std::vector<Node> m_nodes;
+
+    /// (3 x nodes) zeroth moment of source vectors in each node @f$ \sum_{j} x_{j} @f$
+    Eigen::Matrix3Xd m_node_sum;
+    /// first moment of source vectors in each node @f$ \sum_{j} (\boldsymbol{r}_{j} - \boldsymbol{c}) \,
+    /// x_{j}^{\mathrm{T}} @f$
+    std::vector<Eigen::Matrix3d> m_node_moment;
+
+    /// (chunks x 1) per-chunk number of direct kernel evaluations of the last `apply()`
+    std::vector<long> m_chunk_num_direct;
+    /// (chunks x 1) per-chunk number of far-field node evaluations of the last `apply()`
+    std::vector<long> m_chunk_num_far_field;
+    /// number of direct kernel evaluations of the last `apply()`
+    long m_num_direct{0};
+    /// number of far-field node evaluations of the last `apply()`
+    long m_num_far_field{0};
+    /// near-field particle pairs of `nearFieldPairs()`
+    std::vector<std::pair<int, int>> m_near_pairs;
+
+  public:
+    double
+    theta() const
+    {
+        return m_theta;
+    }
+
+    int
+    numNodes() const
+    {
+        return static_cast<int>(m_nodes.size());
+    }
+
+    long
+    numDirectEvaluations() const
+    {
+        return m_num_direct;
+    }
+
+    long
+    numFarFieldEvaluations() const
+    {
+        return m_num_far_field;
+    }
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_DIPOLE_TREECODE_H
@@ -0,0 +1,142 @@
+//
+// Created by Alec Glisman on 11/05/21
+//
+
+#include <NeighborList.hpp>
+
+NeighborList::NeighborList(const int num_particles, const double r_cut, const double r_skin)
+    : m_num_particles(num_particles), m_r_cut(r_cut), m_r_skin(r_skin), m_r_list(r_cut + r_skin)
+{
+    if (m_r_cut <= 0.0)
+    {
+        throw std::invalid_argument("NeighborList: cutoff distance must be positive");
+    }
+    if (m_r_skin < 0.0)
+    {
+        throw std::invalid_argument("NeighborList: skin distance must be non-negative");
+    }
+
+    m_positions_build = Eigen::VectorXd::Zero(3 * m_num_particles);
+}
+
+bool
+NeighborList::update(const Eigen::VectorXd& positions)
+{
+    if (m_built && !needsRebuild(positions))
+    {
+        return false;
+    }
+
+    build(positions);
+
+    return true;
+}
+
+bool
+NeighborList::needsRebuild(const Eigen::VectorXd& positions) const
+{
+    const double max_displacement_sqr{0.25 * m_r_skin * m_r_skin};
+
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_3{3 * particle_id};
+
+        const double displacement_sqr{
+            (positions.segment<3>(particle_id_3) - m_positions_build.segment<3>(particle_id_3)).squaredNorm()};
+
+        if (displacement_sqr > max_displacement_sqr)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+NeighborList::build(const Eigen::VectorXd& positions)
+{
+    using Cell = std::array<long, 3>;
+
+    const double r_list_sqr{m_r_list * m_r_list};
+
+    /* ANCHOR: bin particles into cells of side r_list */
+    std::vector<std::pair<Cell, int>> cell_particle(m_num_particles);
+
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_3{3 * particle_id};
+
+        Cell cell;
+        for (int dim = 0; dim < 3; dim++)
+        {
+            cell[dim] = static_cast<long>(std::floor(positions(particle_id_3 + dim) / m_r_list));
+        }
+
+        cell_particle[particle_id] = {cell, particle_id};
+    }
+
+    std::sort(cell_particle.begin(), cell_particle.end());
+
+    /* ANCHOR: compare particles in neighboring cells */
+    std::vector<std::pair<int, int>> pairs;
+
+    const auto cell_comp = [](const std::pair<Cell, int>& a, const std::pair<Cell, int>& b) {
+        return a.first < b.first;
+    };
+
+    for (const auto& [cell, alpha] : cell_particle)
+    {
+        const int alpha_3{3 * alpha};
+
+        for (long dx = -1; dx <= 1; dx++)
+        {
+            for (long dy = -1; dy <= 1; dy++)
+            {
+                for (long dz = -1; dz <= 1; dz++)
+                {
+                    const std::pair<Cell, int> neighbor_cell{{cell[0] + dx, cell[1] + dy, cell[2] + dz}, -1};
+                    const auto range = std::equal_range(cell_particle.begin(), cell_particle.end(), neighbor_cell,
+                                                        cell_comp);
+
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        const int beta{it->second};
+
+                        if (beta <= alpha)
+                        {
+                            continue;
+                        }
+
+                        const double r_sqr{
+                            (positions.segment<3>(alpha_3) - positions.segment<3>(3 * beta)).squaredNorm()};
+
+                        if (r_sqr < r_list_sqr)
+                        {
+                            pairs.emplace_back(alpha, beta);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // deterministic pair ordering
+    std::sort(pairs.begin(), pairs.end());
+
+    /* ANCHOR: output pair list */
+    m_num_pairs = static_cast<int>(pairs.size());
+
+    m_alpha_vec.resize(m_num_pairs);
+    m_beta_vec.resize(m_num_pairs);
+
+    for (int k = 0; k < m_num_pairs; k++)
+    {
+        m_alpha_vec(k) = pairs[k].first;
+        m_beta_vec(k)  = pairs[k].second;
+    }
+
+    m_positions_build = positions;
+    m_built           = true;
+    m_num_builds++;
+}
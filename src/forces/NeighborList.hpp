@@ -0,0 +1,155 @@
+//
+// Created by Alec Glisman on 11/05/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_NEIGHBOR_LIST_H
+#define BODIES_IN_POTENTIAL_FLOW_NEIGHBOR_LIST_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all external project dependencies */
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+// STL
+#include <algorithm> // std::sort, std::equal_range
+#include <array>     // std::array
+#include <cmath>     // std::floor
+#include <stdexcept> // std::errors
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+/**
+ * @class NeighborList
+ *
+ * @brief Verlet neighbor list of particle pairs within a cutoff distance plus a skin distance.
+ *
+ * @details The list contains all pairs @f$ (\alpha, \beta) @f$, @f$ \alpha < \beta @f$, with separation less than
+ * @f$ r_{\mathrm{list}} = r_{\mathrm{cut}} + r_{\mathrm{skin}} @f$ at the time the list was built.
+ * The list stays valid (contains all pairs within @f$ r_{\mathrm{cut}} @f$) until a particle has moved more than
+ * @f$ r_{\mathrm{skin}} / 2 @f$ from its position at the last build, at which point `update()` rebuilds it.
+ * Builds bin particles into cubic cells of side @f$ r_{\mathrm{list}} @f$ and only compare particles in neighboring
+ * cells, so the cost is @f$ \mathcal{O}(N \log N) @f$ for dilute systems.
+ *
+ */
+class NeighborList
+{
+  public:
+    /**
+     * @brief Construct a new (empty) neighbor list object
+     *
+     */
+    NeighborList() = default;
+
+    /**
+     * @brief Construct a new neighbor list object
+     *
+     * @param num_particles number of particles, N
+     * @param r_cut cutoff distance of pairwise interactions
+     * @param r_skin additional distance particles can move before list must be rebuilt
+     */
+    NeighborList(const int num_particles, const double r_cut, const double r_skin);
+
+    /**
+     * @brief Rebuilds the neighbor list if it has not been built or any particle has moved more than half the skin
+     * distance since the last build
+     *
+     * @param positions (3N x 1) particle positions
+     * @return true list was rebuilt
+     * @return false list is still valid
+     */
+    bool
+    update(const Eigen::VectorXd& positions);
+
+    /**
+     * @brief Builds the neighbor list at the input particle positions
+     *
+     * @param positions (3N x 1) particle positions
+     */
+    void
+    build(const Eigen::VectorXd& positions);
+
+  private:
+    /**
+     * @brief Checks if any particle has moved more than half the skin distance since the last build
+     *
+     * @param positions (3N x 1) particle positions
+     * @return true list must be rebuilt
+     * @return false list is still valid
+     */
+    bool
+    needsRebuild(const Eigen::VectorXd& positions) const;
+
+    /// = N
+    int m_num_particles{0};
+    /// cutoff distance of pairwise interactions
+    double m_r_cut{0.0};
+    /// skin distance
+    double m_r_skin{0.0};
+    /// = r_cut + r_skin. Distance pairs are included in list at build
+    double m_r_list{0.0};
+
+    /// if the list has been built
+    bool m_built{false};
+    /// number of times the list has been built
+    int m_num_builds{0};
+
+    /// (3N x 1) particle positions at last build
+    Eigen::VectorXd m_positions_build;
+
+    /// = s. Number of pairs in list
+    int m_num_pairs{0};
+    /// (s x 1) first particle number in pairwise interactions
+    Eigen::VectorXi m_alpha_vec;
+    /// (s x 1) second particle number in pairwise interactions
+    Eigen::VectorXi m_beta_vec;
+
+  public:
+    int
+    numPairs() const
+    {
+        return m_num_pairs;
+    }
+
+    const Eigen::VectorXi&
+    alphaVec() const
+    {
+        return m_alpha_vec;
+    }
+
+    const Eigen::VectorXi&
+    betaVec() const
+    {
+        return m_beta_vec;
+    }
+
+    double
+    rCut() const
+    {
+        return m_r_cut;
+    }
+
+    double
+    rSkin() const
+    {
+        return m_r_skin;
+    }
+
+    int
+    numBuilds() const
+    {
+        return m_num_builds;
+    }
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_NEIGHBOR_LIST_H
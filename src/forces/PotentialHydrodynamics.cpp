@@ -10,91 +10,186 @@ PotentialHydrodynamics::PotentialHydrodynamics(std::shared_ptr<SystemData> sys)
     m_system = sys;
 
     // Initialize logger
+    m_logName += m_system->logTag();
+
     m_logFile   = m_system->outputDir() + "/logs/" + m_logName + "-log.txt";
     auto logger = spdlog::basic_logger_mt(m_logName, m_logFile);
     spdlog::get(m_logName)->info("Initializing potential hydrodynamics");
 
+    /* Mirror-aware wall hydrodynamics: only the real 1/2 of an image system is stored and image particles enter
+     * analytically through the reflection z --> -z */
+    m_mirror_image = m_system->imageSystem() && m_system->mirrorHydro();
+    spdlog::get(m_logName)->info("Mirror-aware image system hydrodynamics: {0}", m_mirror_image);
+
+    m_num_particles = m_system->numParticles();
+    m_num_bodies    = m_system->numBodies();
+
+    if (m_mirror_image)
+    {
+        m_num_particles /= 2;
+        m_num_bodies /= 2;
+    }
+    spdlog::get(m_logName)->info("Number of particles (bodies) stored: {0} ({1})", m_num_particles, m_num_bodies);
+
     // Variables for for-loop
-    m_num_pair_inter = m_system->numParticles() * (m_system->numParticles() - 1) / 2; // Number of interactions to count
+    m_num_pair_inter = m_num_particles * (m_num_particles - 1) / 2; // Number of interactions to count
     spdlog::get(m_logName)->info("Setting number of interactions to count: {0}", m_num_pair_inter);
 
     // tensor variables
-    m_7N = 7 * m_system->numParticles();
+    m_7N = 7 * m_num_particles;
     spdlog::get(m_logName)->info("Length of 7N tensor quantities: {0}", m_7N);
-    m_7M = 7 * m_system->numBodies();
+    m_7M = 7 * m_num_bodies;
     spdlog::get(m_logName)->info("Length of 7M tensor quantities: {0}", m_7M);
 
-    // set identity matrices
-    m_I7N_linear  = Eigen::MatrixXd::Zero(m_7N, m_7N);
-    m_I7N_angular = Eigen::MatrixXd::Zero(m_7N, m_7N);
+    // NOTE: image couplings are only applied as particle pair products, so mirror mode is always matrix-free
+    m_matrix_free = m_system->matrixFreeHydro() || m_mirror_image;
+    spdlog::get(m_logName)->info("Matrix-free hydrodynamic forces: {0}", m_matrix_free);
 
-    const Eigen::Matrix3d i3       = Eigen::Matrix3d::Identity(3, 3);
-    Eigen::Matrix4d       i4_tilde = Eigen::Matrix4d::Identity(4, 4);
-    i4_tilde(0, 0)                 = m_scalar_w;
+    // NOTE: treecode only replaces dense added mass products in the matrix-free force evaluation
+    m_use_treecode = m_matrix_free && !m_mirror_image && (m_system->treecodeTheta() > 0.0);
+    spdlog::get(m_logName)->info("Treecode added mass products: {0}", m_use_treecode);
 
-    for (int particle_id = 0; particle_id < m_system->numParticles(); particle_id++)
+    if (!m_matrix_free && (m_system->treecodeTheta() > 0.0))
     {
-        const int particle_id_7{7 * particle_id};
+        spdlog::get(m_logName)->warn("Treecode requires matrix-free hydrodynamic forces, using dense products");
+    }
+    if (m_mirror_image && (m_system->treecodeTheta() > 0.0))
+    {
+        spdlog::get(m_logName)->warn("Treecode does not support mirror-aware image systems, using dense products");
+    }
+
+    // NOTE: treecode near-field pairs are set in the first `update()`
+    if (m_use_treecode)
+    {
+        m_num_pair_inter = 0;
+    }
+
+    // diagonal of intrinsic mass and moment of inertia matrices
+    m_M_intrinsic_diag = Eigen::VectorXd::Zero(m_7N);
 
-        m_I7N_linear.block<3, 3>(particle_id_7, particle_id_7).noalias() = i3;
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int    particle_id_7{7 * particle_id};
+        const double mass{m_system->particleDensity() * m_unit_sphere_volume};
 
-        m_I7N_angular.block<4, 4>(particle_id_7 + 3, particle_id_7 + 3).noalias() = i4_tilde;
+        m_M_intrinsic_diag.segment<3>(particle_id_7).setConstant(mass);
+        m_M_intrinsic_diag.segment<4>(particle_id_7 + 3).setConstant(m_scalar_moment_inertia * mass);
+        m_M_intrinsic_diag(particle_id_7 + 3) *= m_scalar_w;
     }
 
-    m_c1_2_I7N_linear = m_c1_2 * m_I7N_linear;
+    if (m_use_treecode)
+    {
+        /* NOTE: added mass products, body mass and near-field pairs are evaluated with the treecode, so no (7N x 7N)
+         * matrix is allocated */
+        spdlog::get(m_logName)->info("Treecode opening angle: {0}", m_system->treecodeTheta());
+        m_treecode       = DipoleTreecode(m_num_particles, m_system->treecodeTheta());
+        m_tc_vel         = Eigen::VectorXd::Zero(3 * m_num_particles);
+        m_tc_M_vel       = Eigen::VectorXd::Zero(3 * m_num_particles);
+        m_tc_sigma_col   = Eigen::VectorXd::Zero(m_7N);
+        m_tc_M_sigma_col = Eigen::VectorXd::Zero(m_7N);
+    }
+    else
+    {
+        // set identity matrices
+        m_I7N_linear  = Eigen::MatrixXd::Zero(m_7N, m_7N);
+        m_I7N_angular = Eigen::MatrixXd::Zero(m_7N, m_7N);
 
-    // Initialize mass matrices
-    spdlog::get(m_logName)->info("Initializing mass matrices");
+        const Eigen::Matrix3d i3       = Eigen::Matrix3d::Identity(3, 3);
+        Eigen::Matrix4d       i4_tilde = Eigen::Matrix4d::Identity(4, 4);
+        i4_tilde(0, 0)                 = m_scalar_w;
 
-    m_M_intrinsic = (m_system->particleDensity() * m_unit_sphere_volume) * m_I7N_linear;
+        for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+        {
+            const int particle_id_7{7 * particle_id};
 
-    m_J_intrinsic = (m_scalar_moment_inertia * m_system->particleDensity() * m_unit_sphere_volume) *
-                    m_I7N_angular; // intrinsic moment of inertia for spheres
+            m_I7N_linear.block<3, 3>(particle_id_7, particle_id_7).noalias() = i3;
 
-    m_M_added = Eigen::MatrixXd::Zero(m_7N, m_7N);
+            m_I7N_angular.block<4, 4>(particle_id_7 + 3, particle_id_7 + 3).noalias() = i4_tilde;
+        }
 
-    m_M_total.noalias() = m_M_added;
-    m_M_total.noalias() += m_M_intrinsic;
-    m_M_total.noalias() += m_J_intrinsic;
+        m_c1_2_I7N_linear = m_c1_2 * m_I7N_linear;
+
+        // Initialize mass matrices
+        spdlog::get(m_logName)->info("Initializing mass matrices");
 
-    spdlog::get(m_logName)->info("Initializing mass tensors");
-    m_grad_M_added = Eigen::Tensor<double, 3>(m_7N, m_7N, 3 * m_system->numParticles());
-    m_grad_M_added.setZero();
-    m_grad_M_added_body_coords = Eigen::Tensor<double, 3>(m_7N, m_7N, m_7M);
-    m_grad_M_added_body_coords.setZero();
-    m_tens_M_total = Eigen::Tensor<double, 2>(m_7N, m_7N);
-    m_tens_M_total.setZero();
-
-    spdlog::get(m_logName)->info("Initializing tensors used in hydrodynamic force calculations.");
-    m_N1 = Eigen::Tensor<double, 3>(m_7N, m_7N, m_7M);
-    m_N1.setZero();
-    m_N2 = Eigen::Tensor<double, 3>(m_7M, m_7N, m_7M);
-    m_N2.setZero();
-    m_N3 = Eigen::Tensor<double, 3>(m_7M, m_7M, m_7M);
-    m_N3.setZero();
-
-    m_M2 = Eigen::Tensor<double, 2>(m_7M, m_7N);
-    m_M2.setZero();
-    m_mat_M2 = Eigen::MatrixXd::Zero(m_7M, m_7N);
+        m_M_intrinsic = (m_system->particleDensity() * m_unit_sphere_volume) * m_I7N_linear;
+
+        m_J_intrinsic = (m_scalar_moment_inertia * m_system->particleDensity() * m_unit_sphere_volume) *
+                        m_I7N_angular; // intrinsic moment of inertia for spheres
+
+        m_M_added = Eigen::MatrixXd::Zero(m_7N, m_7N);
+
+        m_M_total.noalias() = m_M_added;
+        m_M_total.noalias() += m_M_intrinsic;
+        m_M_total.noalias() += m_J_intrinsic;
+
+        spdlog::get(m_logName)->info("Initializing mass tensors");
+
+        m_M2 = Eigen::Tensor<double, 2>(m_7M, m_7N);
+        m_M2.setZero();
+        m_mat_M2 = Eigen::MatrixXd::Zero(m_7M, m_7N);
+    }
 
     m_M3 = Eigen::Tensor<double, 2>(m_7M, m_7M);
     m_M3.setZero();
     m_mat_M3 = Eigen::MatrixXd::Zero(m_7M, m_7M);
 
-    // N^{(2)}
-    m_N2_term1_preshuffle = Eigen::Tensor<double, 3>(m_7M, m_7M, m_7N);
-    m_N2_term1_preshuffle.setZero();
+    m_F_hydro          = Eigen::VectorXd::Zero(m_7M);
+    m_F_hydroNoInertia = Eigen::VectorXd::Zero(m_7M);
+
+    spdlog::get(m_logName)->info("Initializing vectors used in matrix-free hydrodynamic force calculations.");
+    m_mf_vel            = Eigen::VectorXd::Zero(m_7N);
+    m_mf_acc            = Eigen::VectorXd::Zero(m_7N);
+    m_mf_acc_loc        = Eigen::VectorXd::Zero(m_7N);
+    m_mf_x_dot          = Eigen::VectorXd::Zero(3 * m_num_particles);
+    m_mf_M_vel          = Eigen::VectorXd::Zero(m_7N);
+    m_mf_M_acc          = Eigen::VectorXd::Zero(m_7N);
+    m_mf_M_acc_loc      = Eigen::VectorXd::Zero(m_7N);
+    m_mf_M_dot_vel      = Eigen::VectorXd::Zero(m_7N);
+    m_mf_grad_M_vel_vel = Eigen::VectorXd::Zero(3 * m_num_particles);
+
+    // NOTE: rank-3 tensors are only allocated for the tensor force evaluation
+    if (!m_matrix_free)
+    {
+        spdlog::get(m_logName)->info("Initializing tensors used in hydrodynamic force calculations.");
+        m_grad_M_added_body_coords = Eigen::Tensor<double, 3>(m_7N, m_7N, m_7M);
+        m_grad_M_added_body_coords.setZero();
+
+        m_N1 = Eigen::Tensor<double, 3>(m_7N, m_7N, m_7M);
+        m_N1.setZero();
+        m_N2 = Eigen::Tensor<double, 3>(m_7M, m_7N, m_7M);
+        m_N2.setZero();
+        m_N3 = Eigen::Tensor<double, 3>(m_7M, m_7M, m_7M);
+        m_N3.setZero();
+
+        m_hf_V_V           = Eigen::MatrixXd::Zero(m_7N, m_7N);
+        m_hf_xi_dot_xi_dot = Eigen::MatrixXd::Zero(m_7M, m_7M);
+        m_hf_xi_dot_V      = Eigen::MatrixXd::Zero(m_7M, m_7N);
+        m_hf_V_xi_dot      = Eigen::MatrixXd::Zero(m_7N, m_7M);
+        m_hf_inertia_loc   = Eigen::VectorXd::Zero(m_7M);
+    }
 
-    // N^{(3)}
-    m_N3_terms12_preshuffle = Eigen::Tensor<double, 3>(m_7M, m_7M, m_7M);
-    m_N3_terms12_preshuffle.setZero();
+    spdlog::get(m_logName)->info("Initializing vectors used in hydrodynamic energy calculations.");
+    m_en_V         = Eigen::VectorXd::Zero(m_7N);
+    m_en_vel       = Eigen::VectorXd::Zero(m_7N);
+    m_en_u         = Eigen::VectorXd::Zero(m_7N);
+    m_en_M_V       = Eigen::VectorXd::Zero(m_7N);
+    m_en_M_vel     = Eigen::VectorXd::Zero(m_7N);
+    m_en_M_u       = Eigen::VectorXd::Zero(m_7N);
+    m_en_M3_xi_dot = Eigen::VectorXd::Zero(m_7M);
+    m_en_M2_V      = Eigen::VectorXd::Zero(m_7M);
 
     // Assign particle pair information
     spdlog::get(m_logName)->info("Initializing particle pair information vectors");
-    m_alphaVec = Eigen::VectorXi::Zero(m_num_pair_inter);
-    m_betaVec  = Eigen::VectorXi::Zero(m_num_pair_inter);
-    m_r_mag_ab = Eigen::VectorXd::Zero(m_num_pair_inter);
-    m_r_ab     = Eigen::MatrixXd::Zero(3, m_num_pair_inter);
+    m_alphaVec  = Eigen::VectorXi::Zero(m_num_pair_inter);
+    m_betaVec   = Eigen::VectorXi::Zero(m_num_pair_inter);
+    m_r_mag_ab  = Eigen::VectorXd::Zero(m_num_pair_inter);
+    m_r_ab      = Eigen::Matrix<double, Eigen::Dynamic, 3>::Zero(m_num_pair_inter, 3);
+    m_r_inv3_ab = Eigen::ArrayXd::Zero(m_num_pair_inter);
+    m_r_inv5_ab = Eigen::ArrayXd::Zero(m_num_pair_inter);
+    m_r_inv7_ab = Eigen::ArrayXd::Zero(m_num_pair_inter);
+    m_M1_ab      = Eigen::Matrix<double, Eigen::Dynamic, 6>::Zero(m_num_pair_inter, 6);
+    m_grad_M1_ab = Eigen::Matrix<double, Eigen::Dynamic, 10>::Zero(m_num_pair_inter, 10);
 
     /* Fill the particle index vectors
      * Calculate ahead of time to save time during runtime
@@ -106,13 +201,13 @@ PotentialHydrodynamics::PotentialHydrodynamics(std::shared_ptr<SystemData> sys)
          * @Source:
          * https://stackoverflow.com/questions/33810187/openmp-and-c-private-variables/33836073#33836073
          */
-        int alpha = i / m_system->numParticles();
-        int beta  = i % m_system->numParticles();
+        int alpha = i / m_num_particles;
+        int beta  = i % m_num_particles;
 
         if (beta <= alpha)
         {
-            alpha = m_system->numParticles() - alpha - 2;
-            beta  = m_system->numParticles() - beta - 1;
+            alpha = m_num_particles - alpha - 2;
+            beta  = m_num_particles - beta - 1;
         }
 
         assert(alpha >= 0 && "Calculated alpha must be non-negative");
@@ -122,6 +217,48 @@ PotentialHydrodynamics::PotentialHydrodynamics(std::shared_ptr<SystemData> sys)
         m_betaVec(i)  = beta;
     }
 
+    // (real, image) particle pairs
+    if (m_mirror_image)
+    {
+        spdlog::get(m_logName)->info("Initializing image particle pair information");
+        m_num_image_pair = m_num_particles * m_num_particles;
+
+        m_img_r_ab       = Eigen::Matrix<double, Eigen::Dynamic, 3>::Zero(m_num_image_pair, 3);
+        m_img_r_mag_ab   = Eigen::VectorXd::Zero(m_num_image_pair);
+        m_img_r_inv3_ab  = Eigen::ArrayXd::Zero(m_num_image_pair);
+        m_img_r_inv5_ab  = Eigen::ArrayXd::Zero(m_num_image_pair);
+        m_img_r_inv7_ab  = Eigen::ArrayXd::Zero(m_num_image_pair);
+        m_img_M1_ab      = Eigen::Matrix<double, Eigen::Dynamic, 6>::Zero(m_num_image_pair, 6);
+        m_img_grad_M1_ab = Eigen::Matrix<double, Eigen::Dynamic, 10>::Zero(m_num_image_pair, 10);
+        m_M_image        = Eigen::MatrixXd::Zero(m_7N, m_7N);
+        m_grad_M_image.resize(m_num_image_pair);
+    }
+
+    // block sparse added mass gradient is keyed by the particle pairs
+    spdlog::get(m_logName)->info("Initializing block sparse added mass gradient");
+    m_grad_M_added = BlockSparseGradient(m_num_particles, m_alphaVec, m_betaVec);
+
+    /* Far-field cutoff of pairwise interactions
+     * The largest eigenvalue of the (3 x 3) off-diagonal added mass block M^{(1)}_{ij} is 1 / r^3, relative to 1/2
+     * for the diagonal blocks, so neglected elements have a relative error of at most 2 / r_cut^3 = tolerance */
+    m_use_neighbor_list = (m_system->pairTolerance() > 0.0) && !m_use_treecode;
+    spdlog::get(m_logName)->info("Truncating pairwise interactions with neighbor list: {0}", m_use_neighbor_list);
+
+    if (m_use_treecode && (m_system->pairTolerance() > 0.0))
+    {
+        spdlog::get(m_logName)->warn("Treecode near-field pairs replace the neighbor list, ignoring pair tolerance");
+    }
+
+    if (m_use_neighbor_list)
+    {
+        m_r_cut = std::cbrt(2.0 / m_system->pairTolerance());
+        spdlog::get(m_logName)->info("Pair tolerance: {0}, cutoff distance: {1}, skin distance: {2}",
+                                     m_system->pairTolerance(), m_r_cut, m_system->neighborSkin());
+
+        m_neighbor_list = NeighborList(m_num_particles, m_r_cut, m_system->neighborSkin());
+        updatePairList();
+    }
+
     // Compute all relevant quantities
     spdlog::get(m_logName)->critical("Setting up temporary single-thread eigen device");
     Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
@@ -144,296 +281,1063 @@ PotentialHydrodynamics::~PotentialHydrodynamics()
 void
 PotentialHydrodynamics::update(const Eigen::ThreadPoolDevice& device)
 {
-    calcParticleDistances();
+    /* NOTE: each group is only evaluated if the system state it depends on changed since its last evaluation,
+     * dependencies are defined in `m_update_graph` */
+    const UpdateGraph::Versions& versions = m_system->updatedVersions();
+
+    if (m_update_graph.outdated(StageDistances, versions))
+    {
+        updatePairList();
+
+        if (m_use_treecode)
+        {
+            m_treecode.build(m_system->positionsParticles());
+            updateTreecodePairs();
+        }
+
+        calcParticleDistances(device);
+
+        m_update_graph.markCurrent(StageDistances, versions);
+    }
+
+    /* ANCHOR: mass matrices, added mass gradient is independent of the mass matrix chain */
+    const auto mass_task = [this, &device, &versions]() {
+        // NOTE: treecode products replace the dense added and total mass matrices
+        if (m_update_graph.outdated(StageAddedMass, versions))
+        {
+            if (!m_use_treecode)
+            {
+                calcAddedMass(device);
+            }
+
+            m_update_graph.markCurrent(StageAddedMass, versions);
+        }
 
-    calcAddedMass();
-    calcAddedMassGrad(device);
+        if (m_update_graph.outdated(StageTotalMass, versions))
+        {
+            if (!m_use_treecode)
+            {
+                calcTotalMass();
+            }
 
-    calcTotalMass();
+            m_update_graph.markCurrent(StageTotalMass, versions);
+        }
 
-    calcBodyMass(device);
-    calcBodyMassGrad(device);
+        if (m_update_graph.outdated(StageBodyMass, versions))
+        {
+            calcBodyMass(device);
+            m_update_graph.markCurrent(StageBodyMass, versions);
+        }
+    };
 
-    calcHydroForces(device);
+    const auto mass_grad_task = [this, &device, &versions]() {
+        if (m_update_graph.outdated(StageAddedMassGrad, versions))
+        {
+            calcAddedMassGrad(device);
+            m_update_graph.markCurrent(StageAddedMassGrad, versions);
+        }
+    };
+
+    parallelInvoke(device, mass_task, mass_grad_task);
+
+    /* ANCHOR: forces and energies */
+    const auto force_task = [this, &device, &versions]() {
+        if (m_update_graph.outdated(StageBodyMassGrad, versions))
+        {
+            if (!m_matrix_free)
+            {
+                calcBodyMassGrad(device);
+            }
+
+            m_update_graph.markCurrent(StageBodyMassGrad, versions);
+        }
 
-    calcHydroEnergy(device);
+        if (m_update_graph.outdated(StageForces, versions))
+        {
+            if (m_matrix_free)
+            {
+                calcHydroForcesMatrixFree(device);
+            }
+            else
+            {
+                calcHydroForces(device);
+            }
+
+            m_update_graph.markCurrent(StageForces, versions);
+        }
+    };
+
+    const auto energy_task = [this, &device, &versions]() {
+        if (m_update_graph.outdated(StageEnergy, versions))
+        {
+            calcHydroEnergy(device);
+            m_update_graph.markCurrent(StageEnergy, versions);
+        }
+    };
+
+    // NOTE: treecode and mirror mode energies reuse the mass matrix-vector products of the matrix-free forces
+    if (m_use_treecode || m_mirror_image)
+    {
+        force_task();
+        energy_task();
+    }
+    else
+    {
+        parallelInvoke(device, force_task, energy_task);
+    }
+}
+
+Eigen::Matrix3d
+PotentialHydrodynamics::mTotalLinearBlock(const int alpha, const int beta) const
+{
+    if (!m_use_treecode)
+    {
+        return m_M_total.block<3, 3>(7 * alpha, 7 * beta);
+    }
+
+    const double mass_units{m_system->fluidDensity() * m_unit_sphere_volume};
+
+    // M = M_intrinsic + 1/2 I + M^{(1)}, see `calcAddedMass()`
+    if (alpha == beta)
+    {
+        return (m_M_intrinsic_diag(7 * alpha) + m_c1_2 * mass_units) * Eigen::Matrix3d::Identity();
+    }
+
+    const Eigen::Vector3d r_ab = m_system->positionsParticles().segment<3>(3 * alpha) -
+                                 m_system->positionsParticles().segment<3>(3 * beta);
+    const double          r_mag{r_ab.norm()};
+
+    Eigen::Matrix3d M1_ab = (-m_c3_2 / std::pow(r_mag, 5)) * r_ab * r_ab.transpose();
+    M1_ab.diagonal().array() += m_c1_2 / std::pow(r_mag, 3);
+
+    return mass_units * M1_ab;
 }
 
 void
-PotentialHydrodynamics::calcParticleDistances()
+PotentialHydrodynamics::updatePairList()
 {
-    /* NOTE: Fill Mass matrix elements one (3 x 3) block at a time (matrix elements between
-     * particles \alpha and \beta) */
-    for (int i = 0; i < m_num_pair_inter; i++)
+    if (!m_use_neighbor_list)
+    {
+        return;
+    }
+
+    if (!m_neighbor_list.update(m_system->positionsParticles()))
+    {
+        return;
+    }
+
+    setPairs(m_neighbor_list.alphaVec(), m_neighbor_list.betaVec());
+
+    spdlog::get(m_logName)->info("Neighbor list build {0}: {1} particle pairs", m_neighbor_list.numBuilds(),
+                                 m_num_pair_inter);
+}
+
+void
+PotentialHydrodynamics::updateTreecodePairs()
+{
+    m_treecode.nearFieldPairs(m_treecode_padding, m_tc_alpha_vec, m_tc_beta_vec);
+
+    if ((m_tc_alpha_vec.size() == m_num_pair_inter) && (m_tc_alpha_vec == m_alphaVec) && (m_tc_beta_vec == m_betaVec))
     {
-        m_r_ab.col(i).noalias() = m_system->positionsParticles().segment<3>(3 * m_alphaVec(i));
-        m_r_ab.col(i).noalias() -= m_system->positionsParticles().segment<3>(3 * m_betaVec(i));
+        return;
+    }
+
+    setPairs(m_tc_alpha_vec, m_tc_beta_vec);
 
-        m_r_mag_ab(i) = m_r_ab.col(i).norm(); //(1); |r| between 2 particles
+    spdlog::get(m_logName)->info("Treecode near-field: {0} particle pairs", m_num_pair_inter);
+}
+
+void
+PotentialHydrodynamics::setPairs(const Eigen::VectorXi& alpha_vec, const Eigen::VectorXi& beta_vec)
+{
+    // NOTE: explicit resize, as pair vectors change length between neighbor list builds
+    m_num_pair_inter = static_cast<int>(alpha_vec.size());
+
+    m_alphaVec.resize(m_num_pair_inter);
+    m_betaVec.resize(m_num_pair_inter);
+    m_alphaVec = alpha_vec;
+    m_betaVec  = beta_vec;
+
+    m_r_mag_ab.resize(m_num_pair_inter);
+    m_r_ab.resize(m_num_pair_inter, 3);
+    m_r_inv3_ab.resize(m_num_pair_inter);
+    m_r_inv5_ab.resize(m_num_pair_inter);
+    m_r_inv7_ab.resize(m_num_pair_inter);
+    m_M1_ab.resize(m_num_pair_inter, 6);
+    m_grad_M1_ab.resize(m_num_pair_inter, 10);
+
+    m_grad_M_added.setPairs(m_alphaVec, m_betaVec);
+}
+
+void
+PotentialHydrodynamics::calcParticleDistances(const Eigen::ThreadPoolDevice& device)
+{
+    const int num_chunks{numParallelChunks(device, m_num_pair_inter, m_min_pairs_per_chunk)};
+
+    /* NOTE: Each pair writes to its own row of the structure-of-arrays pair data, so chunks never conflict. */
+    parallelForChunks(device, num_chunks, m_num_pair_inter, [this](const int chunk_id, const int begin, const int end) {
+        const Eigen::VectorXd& positions = m_system->positionsParticles();
+        const int              num_pairs{end - begin};
+
+        // gather displacements of pairs into contiguous columns
+        for (int i = begin; i < end; i++)
+        {
+            const int alpha_3{3 * m_alphaVec(i)};
+            const int beta_3{3 * m_betaVec(i)};
+
+            m_r_ab(i, 0) = positions(alpha_3) - positions(beta_3);
+            m_r_ab(i, 1) = positions(alpha_3 + 1) - positions(beta_3 + 1);
+            m_r_ab(i, 2) = positions(alpha_3 + 2) - positions(beta_3 + 2);
+        }
+
+        // distances and inverse powers, vectorized over consecutive pairs
+        calcInversePowers(begin, num_pairs, m_r_ab, m_r_mag_ab, m_r_inv3_ab, m_r_inv5_ab, m_r_inv7_ab);
 
 #if !defined(NDEBUG)
-        spdlog::get(m_logName)->critical("Checking distance between particle pair [{0}, {1}]: {2:.3f}", m_alphaVec(i),
-                                         m_betaVec(i), m_r_mag_ab(i));
-        spdlog::get(m_logName)->flush();
+        for (int i = begin; i < end; i++)
+        {
+            spdlog::get(m_logName)->critical("Checking distance between particle pair [{0}, {1}]: {2:.3f}",
+                                             m_alphaVec(i), m_betaVec(i), m_r_mag_ab(i));
+            spdlog::get(m_logName)->flush();
+        }
 #endif
+    });
+
+    if (!m_mirror_image)
+    {
+        return;
     }
+
+    /* ANCHOR: (real, image) particle pairs: image of particle q is at R x_q */
+    const int num_img_chunks{numParallelChunks(device, m_num_image_pair, m_min_pairs_per_chunk)};
+
+    parallelForChunks(device, num_img_chunks, m_num_image_pair,
+                      [this](const int chunk_id, const int begin, const int end) {
+                          const Eigen::VectorXd& positions = m_system->positionsParticles();
+
+                          for (int k = begin; k < end; k++)
+                          {
+                              const int p_3{3 * (k / m_num_particles)};
+                              const int q_3{3 * (k % m_num_particles)};
+
+                              m_img_r_ab.row(k) = (positions.segment<3>(p_3) -
+                                                   m_reflect.cwiseProduct(positions.segment<3>(q_3)))
+                                                      .transpose();
+                          }
+
+                          calcInversePowers(begin, end - begin, m_img_r_ab, m_img_r_mag_ab, m_img_r_inv3_ab,
+                                            m_img_r_inv5_ab, m_img_r_inv7_ab);
+                      });
 }
 
 void
-PotentialHydrodynamics::calcAddedMass()
+PotentialHydrodynamics::calcInversePowers(const int begin, const int num_pairs,
+                                          const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab,
+                                          Eigen::VectorXd& r_mag_ab, Eigen::ArrayXd& r_inv3_ab,
+                                          Eigen::ArrayXd& r_inv5_ab, Eigen::ArrayXd& r_inv7_ab)
 {
-    // set matrices to zero
-    m_M_added.setZero();
+    const auto r_x = r_ab.col(0).segment(begin, num_pairs).array();
+    const auto r_y = r_ab.col(1).segment(begin, num_pairs).array();
+    const auto r_z = r_ab.col(2).segment(begin, num_pairs).array();
 
-    /* Fill off-diagonal elements (without units ) */
-    /* NOTE: Fill Mass matrix elements one (3 x 3) block at a time (matrix elements between
-     * particles \alpha and \beta) */
-    for (int k = 0; k < m_num_pair_inter; k++)
-    {
-        // Convert (\alpha, \beta) --> (i, j) by factor of 3
-        const int i_7{7 * m_alphaVec(k)};
-        const int j_7{7 * m_betaVec(k)};
+    r_mag_ab.segment(begin, num_pairs).array() = (r_x.square() + r_y.square() + r_z.square()).sqrt();
 
-        // Full distance between particles \alpha and \beta
-        const Eigen::Vector3d r_ij = m_r_ab.col(k);    // (1)
-        const double          r_mag_ij{m_r_mag_ab(k)}; //(1); |r| between 2 particles
+    r_inv3_ab.segment(begin, num_pairs) = r_mag_ab.segment(begin, num_pairs).array().cube().inverse();
+    r_inv5_ab.segment(begin, num_pairs) =
+        r_inv3_ab.segment(begin, num_pairs) / r_mag_ab.segment(begin, num_pairs).array().square();
+    r_inv7_ab.segment(begin, num_pairs) =
+        r_inv5_ab.segment(begin, num_pairs) / r_mag_ab.segment(begin, num_pairs).array().square();
+}
 
-        // M^{(1)} Matrix Element Constants:
-        const double M1_c1{-m_c3_2 / std::pow(r_mag_ij, 5)}; // (1)
-        const double M1_c2{m_c1_2 / std::pow(r_mag_ij, 3)};  // (1)
+void
+PotentialHydrodynamics::calcAddedMass(const Eigen::ThreadPoolDevice& device)
+{
+    const int num_chunks{numParallelChunks(device, m_num_pair_inter, m_min_pairs_per_chunk)};
 
-        // Full matrix elements for M^{(1)}_{ij} (NOTE: missing factor of 1/2)
-        Eigen::Matrix3d Mij = r_ij * r_ij.transpose(); //(1); Outer product of \bm{r} \bm{r}
-        Mij *= M1_c1;
-        Mij.noalias() += M1_c2 * m_system->i3();
+    // set matrices to zero
+    m_M_added.setZero();
 
-        // Output added mass element (symmetry of mass matrix)
-        m_M_added.block<3, 3>(i_7, j_7).noalias() = Mij;
-        m_M_added.block<3, 3>(j_7, i_7).noalias() = Mij;
-    }
+    /* Fill off-diagonal elements (without units ) */
+    /* NOTE: Block elements are evaluated vectorized over consecutive pairs, then scattered into the Mass matrix one
+     * (3 x 3) block at a time (matrix elements between particles \alpha and \beta). Each pair writes to its own
+     * (\alpha, \beta) and (\beta, \alpha) blocks, so chunks never conflict. */
+    parallelForChunks(device, num_chunks, m_num_pair_inter, [this](const int chunk_id, const int begin, const int end) {
+        calcAddedMassCoefficients(begin, end - begin, m_r_ab, m_r_mag_ab, m_r_inv3_ab, m_r_inv5_ab, m_M1_ab);
+
+        for (int k = begin; k < end; k++)
+        {
+            // far-field cutoff: pair is in neighbor list skin
+            if (m_r_mag_ab(k) >= m_r_cut)
+            {
+                continue;
+            }
+
+            // Convert (\alpha, \beta) --> (i, j) by factor of 7
+            const int i_7{7 * m_alphaVec(k)};
+            const int j_7{7 * m_betaVec(k)};
+
+            // Output added mass element (symmetry of mass matrix)
+            for (int j = 0; j < 3; j++)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    const double M1_ij{m_M1_ab(k, m_sym_ij[i][j])};
+
+                    m_M_added(i_7 + i, j_7 + j) = M1_ij;
+                    m_M_added(j_7 + i, i_7 + j) = M1_ij;
+                }
+            }
+        }
+    });
 
     /* Construct full added mass matrix
      * M = 1/2 I + M^{(1)}
      */
     m_M_added.noalias() += m_c1_2_I7N_linear;                       // Add diagonal elements
     m_M_added *= (m_system->fluidDensity() * m_unit_sphere_volume); // mass units
+
+    if (!m_mirror_image)
+    {
+        return;
+    }
+
+    /* ANCHOR: coupling to image particles, M_{p q'} R (image velocity of particle q is R w_q) */
+    const int num_img_chunks{numParallelChunks(device, m_num_image_pair, m_min_pairs_per_chunk)};
+
+    m_M_image.setZero();
+
+    parallelForChunks(device, num_img_chunks, m_num_image_pair,
+                      [this](const int chunk_id, const int begin, const int end) {
+                          const double mass_units{m_system->fluidDensity() * m_unit_sphere_volume};
+
+                          calcAddedMassCoefficients(begin, end - begin, m_img_r_ab, m_img_r_mag_ab, m_img_r_inv3_ab,
+                                                    m_img_r_inv5_ab, m_img_M1_ab);
+
+                          for (int k = begin; k < end; k++)
+                          {
+                              // far-field cutoff
+                              if (m_img_r_mag_ab(k) >= m_r_cut)
+                              {
+                                  continue;
+                              }
+
+                              const int p_7{7 * (k / m_num_particles)};
+                              const int q_7{7 * (k % m_num_particles)};
+
+                              for (int j = 0; j < 3; j++)
+                              {
+                                  for (int i = 0; i < 3; i++)
+                                  {
+                                      m_M_image(p_7 + i, q_7 + j) =
+                                          mass_units * m_img_M1_ab(k, m_sym_ij[i][j]) * m_reflect(j);
+                                  }
+                              }
+                          }
+                      });
 }
 
 void
 PotentialHydrodynamics::calcAddedMassGrad(const Eigen::ThreadPoolDevice& device)
 {
-    // `Eigen::Tensor` contraction indices
-    const Eigen::array<Eigen::IndexPair<int>, 1>  contract_ijl_kl = {Eigen::IndexPair<int>(2, 1)};
-    const Eigen::array<Eigen::IndexPair<long>, 0> outer_product   = {};
-
-    // `Eigen::Tensor` permutation indices
-    const Eigen::array<int, 3> permute_ijk_kij({2, 0, 1}); // {i, j, k} --> {k, i, j}
-    const Eigen::array<int, 3> permute_ijk_jki({1, 2, 1}); // {i, j, k} --> {j, k, i}
-
-    // set matrices to zero
-    m_grad_M_added.setZero();
+    const int num_chunks{numParallelChunks(device, m_num_pair_inter, m_min_pairs_per_chunk)};
 
     /* NOTE: Fill Mass matrix elements one (3 x 3 x 3) block at a time (matrix elements between
-     * particles \alpha and \beta) */
+     * particles \alpha and \beta). Only M_{ij, i} is stored, as the other three non-zero blocks
+     * (M_{ji, i} = M_{ij, i}, M_{ij, j} = M_{ji, j} = - M_{ij, i}) follow from symmetry.
+     * Each pair writes to its own block, so chunks never conflict. */
+    parallelForChunks(device, num_chunks, m_num_pair_inter, [this](const int chunk_id, const int begin, const int end) {
+        calcAddedMassGradCoefficients(begin, end - begin, m_r_ab, m_r_mag_ab, m_r_inv5_ab, m_r_inv7_ab, m_grad_M1_ab);
+
+        // NOTE: pairs in neighbor list skin (far-field cutoff) have zero elements
+        for (int k = begin; k < end; k++)
+        {
+            unpackAddedMassGradBlock(m_grad_M1_ab, k, m_grad_M_added.block(k));
+        }
+    });
 
-    for (int k = 0; k < m_num_pair_inter; k++)
+    // NOTE: (real, image) pairs only store the gradient w.r.t. the real particle
+    if (m_mirror_image)
     {
-        const int i_3{3 * m_alphaVec(k)};
-        const int j_3{3 * m_betaVec(k)};
+        const int num_img_chunks{numParallelChunks(device, m_num_image_pair, m_min_pairs_per_chunk)};
+
+        parallelForChunks(device, num_img_chunks, m_num_image_pair,
+                          [this](const int chunk_id, const int begin, const int end) {
+                              calcAddedMassGradCoefficients(begin, end - begin, m_img_r_ab, m_img_r_mag_ab,
+                                                            m_img_r_inv5_ab, m_img_r_inv7_ab, m_img_grad_M1_ab);
+
+                              for (int k = begin; k < end; k++)
+                              {
+                                  unpackAddedMassGradBlock(m_img_grad_M1_ab, k, m_grad_M_image[k]);
+                              }
+                          });
+    }
 
-        const int i_7{7 * m_alphaVec(k)};
-        const int j_7{7 * m_betaVec(k)};
+    // NOTE: body coordinate gradient only used in (N1, N2, N3) tensor force evaluation
+    if (!m_matrix_free)
+    {
+        m_grad_M_added.contractChi(m_system->tensChi(), m_grad_M_added_body_coords, device);
+    }
+}
 
-        const Eigen::array<Eigen::Index, 3> offsets_ij_i = {i_7, j_7, i_3};
-        const Eigen::array<Eigen::Index, 3> offsets_ij_j = {i_7, j_7, j_3};
-        const Eigen::array<Eigen::Index, 3> offsets_ji_i = {j_7, i_7, i_3};
-        const Eigen::array<Eigen::Index, 3> offsets_ji_j = {j_7, i_7, j_3};
+void
+PotentialHydrodynamics::calcAddedMassCoefficients(const int begin, const int num_pairs,
+                                                  const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab,
+                                                  const Eigen::VectorXd& r_mag_ab, const Eigen::ArrayXd& r_inv3_ab,
+                                                  const Eigen::ArrayXd& r_inv5_ab,
+                                                  Eigen::Matrix<double, Eigen::Dynamic, 6>& M1_ab) const
+{
+    const auto r_x = r_ab.col(0).segment(begin, num_pairs).array();
+    const auto r_y = r_ab.col(1).segment(begin, num_pairs).array();
+    const auto r_z = r_ab.col(2).segment(begin, num_pairs).array();
+
+    // far-field cutoff: zero pairs in neighbor list skin
+    const auto in_range = (r_mag_ab.segment(begin, num_pairs).array() < m_r_cut).cast<double>();
+
+    // M^{(1)} Matrix Element Constants: c1 r_i r_j + c2 I_{i j} (NOTE: missing factor of 1/2)
+    const auto M1_c1 = (-m_c3_2 * r_inv5_ab.segment(begin, num_pairs)) * in_range;
+    const auto M1_c2 = (m_c1_2 * r_inv3_ab.segment(begin, num_pairs)) * in_range;
+
+    M1_ab.col(0).segment(begin, num_pairs).array() = M1_c1 * r_x * r_x + M1_c2;
+    M1_ab.col(1).segment(begin, num_pairs).array() = M1_c1 * r_x * r_y;
+    M1_ab.col(2).segment(begin, num_pairs).array() = M1_c1 * r_x * r_z;
+    M1_ab.col(3).segment(begin, num_pairs).array() = M1_c1 * r_y * r_y + M1_c2;
+    M1_ab.col(4).segment(begin, num_pairs).array() = M1_c1 * r_y * r_z;
+    M1_ab.col(5).segment(begin, num_pairs).array() = M1_c1 * r_z * r_z + M1_c2;
+}
 
-        const Eigen::array<Eigen::Index, 3> extents = {3, 3, 3};
+void
+PotentialHydrodynamics::calcAddedMassGradCoefficients(const int begin, const int num_pairs,
+                                                      const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab,
+                                                      const Eigen::VectorXd& r_mag_ab, const Eigen::ArrayXd& r_inv5_ab,
+                                                      const Eigen::ArrayXd& r_inv7_ab,
+                                                      Eigen::Matrix<double, Eigen::Dynamic, 10>& grad_M1_ab) const
+{
+    const double mass_units{m_system->fluidDensity() * m_unit_sphere_volume};
+
+    const auto r_x = r_ab.col(0).segment(begin, num_pairs).array();
+    const auto r_y = r_ab.col(1).segment(begin, num_pairs).array();
+    const auto r_z = r_ab.col(2).segment(begin, num_pairs).array();
+
+    // far-field cutoff: zero pairs in neighbor list skin
+    const auto in_range = (r_mag_ab.segment(begin, num_pairs).array() < m_r_cut).cast<double>();
+
+    const auto gradM1_c1 = (-mass_units * m_c3_2 * r_inv5_ab.segment(begin, num_pairs)) * in_range; // mass units
+    const auto gradM1_c2 = (mass_units * m_c15_2 * r_inv7_ab.segment(begin, num_pairs)) * in_range; // mass units
+
+    /* NOTE: full matrix element for M_{i j, i}: c1 (I_{i j} r_k + I_{j k} r_i + I_{k i} r_j) + c2 r_i r_j r_k
+     * (Anti-Symmetric upon exchange of derivative, Symmetric upon exchange of first two indices).
+     * Fully symmetric in (i, j, k), so only the 10 unique elements are evaluated */
+    grad_M1_ab.col(0).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_x * r_x + 3.0 * gradM1_c1 * r_x;
+    grad_M1_ab.col(1).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_x * r_y + gradM1_c1 * r_y;
+    grad_M1_ab.col(2).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_x * r_z + gradM1_c1 * r_z;
+    grad_M1_ab.col(3).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_y * r_y + gradM1_c1 * r_x;
+    grad_M1_ab.col(4).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_y * r_z;
+    grad_M1_ab.col(5).segment(begin, num_pairs).array() = gradM1_c2 * r_x * r_z * r_z + gradM1_c1 * r_x;
+    grad_M1_ab.col(6).segment(begin, num_pairs).array() = gradM1_c2 * r_y * r_y * r_y + 3.0 * gradM1_c1 * r_y;
+    grad_M1_ab.col(7).segment(begin, num_pairs).array() = gradM1_c2 * r_y * r_y * r_z + gradM1_c1 * r_z;
+    grad_M1_ab.col(8).segment(begin, num_pairs).array() = gradM1_c2 * r_y * r_z * r_z + gradM1_c1 * r_y;
+    grad_M1_ab.col(9).segment(begin, num_pairs).array() = gradM1_c2 * r_z * r_z * r_z + 3.0 * gradM1_c1 * r_z;
+}
 
-        // Full distance between particles \alpha and \beta
-        const Eigen::Vector3d                           r_ij = m_r_ab.col(k); // (1)
-        Eigen::TensorFixedSize<double, Eigen::Sizes<3>> tens_r;
-        tens_r.setValues({r_ij(0), r_ij(1), r_ij(2)});
+void
+PotentialHydrodynamics::unpackAddedMassGradBlock(const Eigen::Matrix<double, Eigen::Dynamic, 10>& grad_M1_ab,
+                                                 const int k, BlockSparseGradient::Block& grad_block)
+{
+    // NOTE: element-wise, as fixed-size tensor shuffles evaluate into heap temporaries
+    for (int c = 0; c < 3; c++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                grad_block(i, j, c) = grad_M1_ab(k, m_sym_ijk[i][j][c]);
+            }
+        }
+    }
+}
 
-        const double r_mag_ij{m_r_mag_ab(k)}; //(1); |r| between 2 particles
+void
+PotentialHydrodynamics::calcTotalMass()
+{
+    m_M_total.noalias() = m_M_intrinsic;
+    m_M_total.noalias() += m_J_intrinsic;
+    m_M_total.noalias() += m_M_added;
+}
 
-        const double gradM1_c1{-(m_system->fluidDensity() * m_unit_sphere_volume) * m_c3_2 *
-                               std::pow(r_mag_ij, -5)}; // mass units
-        const double gradM1_c2{(m_system->fluidDensity() * m_unit_sphere_volume) * m_c15_2 *
-                               std::pow(r_mag_ij, -7)}; // mass units
+void
+PotentialHydrodynamics::calcBodyMass(const Eigen::ThreadPoolDevice& device)
+{
+    // NOTE: compile-time sizes for collinear swimmer systems (isolated, and with image system)
+    if (m_use_treecode)
+    {
+        calcBodyMassTreecode(device);
+    }
+    else if ((m_7N == 21) && (m_7M == 7))
+    {
+        calcBodyMassSized<21, 7>();
+    }
+    else if ((m_7N == 42) && (m_7M == 14))
+    {
+        calcBodyMassSized<42, 14>();
+    }
+    else
+    {
+        calcBodyMassDynamic(device);
+    }
+}
 
-        const Eigen::TensorFixedSize<double, Eigen::Sizes<3, 3>> c2_tens_rr =
-            gradM1_c2 * tens_r.contract(tens_r, outer_product);
+template <int Size7N, int Size7M>
+void
+PotentialHydrodynamics::calcBodyMassSized()
+{
+    const Eigen::Map<const Eigen::Matrix<double, Size7N, Size7N>> M_total(m_M_total.data());
 
-        // outer products (I_{i j} r_{k}) and permutations
-        Eigen::TensorFixedSize<double, Eigen::Sizes<3, 3, 3>> delta_ij_r_k;
-        delta_ij_r_k.device(device) = gradM1_c1 * m_system->tensI3().contract(tens_r, outer_product);
+    Eigen::Map<Eigen::Matrix<double, Size7M, Size7N>> M2(m_mat_M2.data());
+    Eigen::Map<Eigen::Matrix<double, Size7M, Size7M>> M3(m_mat_M3.data());
 
-        // full matrix element for M_{i j, i}
-        Eigen::TensorFixedSize<double, Eigen::Sizes<3, 3, 3>> Mij_i;
-        Mij_i.device(device) = delta_ij_r_k;
-        // shuffle all dimensions to the right by 1: (i, j, k) --> (k, i, j), (2, 0, 1)
-        Mij_i.device(device) += delta_ij_r_k.shuffle(permute_ijk_kij);
-        // shuffle all dimensions to the left by 1: (i, j, k) --> (k, i, j), (1, 2, 0)
-        Mij_i.device(device) += delta_ij_r_k.shuffle(permute_ijk_jki);
-        Mij_i.device(device) += c2_tens_rr.contract(tens_r, outer_product);
+    /* ANCHOR: Compute linear combinations of total mass matrix and zeta, one particle block of zeta at a time (see
+     * `SystemData::rbmConnBlock()`) */
+    M2.setZero();
+    M3.setZero();
 
-        // M_{ij, i}: Matrix Element (Anti-Symmetric upon exchange of derivative, Symmetric upon
-        // exchange of first two indices)
-        m_grad_M_added.slice(offsets_ij_i, extents).device(device) = Mij_i;
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
 
-        // M_{ij, j} = - M_{ij, i}
-        m_grad_M_added.slice(offsets_ij_j, extents).device(device) = -Mij_i;
+        M2.template middleRows<7>(body_id_7).noalias() +=
+            m_system->rbmConnBlock(particle_id) * M_total.template middleRows<7>(7 * particle_id);
+    }
 
-        // M_{ji, j} = - M_{ij, i}
-        m_grad_M_added.slice(offsets_ji_j, extents).device(device) = -Mij_i;
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
 
-        // M_{ji, i} = M_{ij, i}
-        m_grad_M_added.slice(offsets_ji_i, extents).device(device) = Mij_i;
+        M3.template middleCols<7>(body_id_7).noalias() +=
+            M2.template middleCols<7>(7 * particle_id) * m_system->rbmConnBlock(particle_id).transpose();
     }
 
-    m_grad_M_added_body_coords.device(device) = m_grad_M_added.contract(m_system->tensChi(), contract_ijl_kl);
+    m_M2 = Eigen::TensorMap<const Eigen::Tensor<double, 2>>(m_mat_M2.data(), m_7M, m_7N);
+    m_M3 = Eigen::TensorMap<const Eigen::Tensor<double, 2>>(m_mat_M3.data(), m_7M, m_7M);
 }
 
 void
-PotentialHydrodynamics::calcTotalMass()
+PotentialHydrodynamics::calcBodyMassDynamic(const Eigen::ThreadPoolDevice& device)
 {
-    m_M_total.noalias() = m_M_intrinsic;
-    m_M_total.noalias() += m_J_intrinsic;
-    m_M_total.noalias() += m_M_added;
+    /* ANCHOR: Compute linear combinations of total mass matrix and zeta, one particle block of zeta at a time (see
+     * `SystemData::rbmConnBlock()`)
+     * NOTE: columns of M2 (= columns of M) are independent and split across the thread-pool of `device` in blocks of
+     * the 7 columns of a particle. Only the real particles are stored in mirror mode, and they belong to the real
+     * bodies */
+    const int num_chunks{numParallelChunks(device, m_num_particles, m_min_particles_per_chunk)};
 
-    m_tens_M_total = TensorCast(m_M_total, m_7N, m_7N);
+    parallelForChunks(device, num_chunks, m_num_particles, [this](const int chunk_id, const int begin, const int end) {
+        const int col_begin{7 * begin};
+        const int num_cols{7 * (end - begin)};
+
+        m_mat_M2.middleCols(col_begin, num_cols).setZero();
+
+        for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+        {
+            const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+            m_mat_M2.block(body_id_7, col_begin, 7, num_cols).noalias() +=
+                m_system->rbmConnBlock(particle_id) * m_M_total.block(7 * particle_id, col_begin, 7, num_cols);
+        }
+    });
+
+    m_mat_M3.setZero();
+
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+        m_mat_M3.middleCols<7>(body_id_7).noalias() +=
+            m_mat_M2.middleCols<7>(7 * particle_id) * m_system->rbmConnBlock(particle_id).transpose();
+    }
+
+    m_M2 = Eigen::TensorMap<const Eigen::Tensor<double, 2>>(m_mat_M2.data(), m_7M, m_7N);
+    m_M3 = Eigen::TensorMap<const Eigen::Tensor<double, 2>>(m_mat_M3.data(), m_7M, m_7M);
 }
 
 void
-PotentialHydrodynamics::calcBodyMass(const Eigen::ThreadPoolDevice& device)
+PotentialHydrodynamics::calcBodyMassTreecode(const Eigen::ThreadPoolDevice& device)
 {
-    // `Eigen::Tensor` contraction indices
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_lj = {Eigen::IndexPair<int>(1, 0)}; // = A B
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_jl = {Eigen::IndexPair<int>(1, 1)}; // = A B^T
+    /* ANCHOR: column c of M3 is \Sigma M u_c with u_c = \Sigma^T e_c, one treecode product per column
+     * NOTE: u_c is only non-zero on the particles of the body of column c */
+    for (int col = 0; col < m_7M; col++)
+    {
+        const int body_id{col / 7};
+        const int c{col % 7};
+
+        m_tc_sigma_col.setZero();
+
+        for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+        {
+            if (m_system->particleGroupId()(particle_id) == body_id)
+            {
+                m_tc_sigma_col.segment<7>(7 * particle_id).noalias() =
+                    m_system->rbmConnBlock(particle_id).row(c).transpose();
+            }
+        }
+
+        applyTotalMass(m_tc_sigma_col, m_tc_M_sigma_col, device);
+
+        m_mat_M3.col(col).setZero();
+
+        for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+        {
+            const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
 
-    /* ANCHOR: Compute linear combinations of total mass matrix and zeta */
-    m_M2.device(device) = m_system->tensRbmConn().contract(m_tens_M_total, contract_il_lj);
-    m_mat_M2            = MatrixCast(m_M2, m_7M, m_7N, device);
+            m_mat_M3.col(col).segment<7>(body_id_7).noalias() +=
+                m_system->rbmConnBlock(particle_id) * m_tc_M_sigma_col.segment<7>(7 * particle_id);
+        }
+    }
+
+    // NOTE: far-field products are not exactly symmetric, symmetrize in place
+    for (int j = 0; j < m_7M; j++)
+    {
+        for (int i = j + 1; i < m_7M; i++)
+        {
+            const double M3_ij{m_c1_2 * (m_mat_M3(i, j) + m_mat_M3(j, i))};
 
-    m_M3.device(device) = m_M2.contract(m_system->tensRbmConn(), contract_il_jl);
-    m_mat_M3            = MatrixCast(m_M3, m_7M, m_7M, device);
+            m_mat_M3(i, j) = M3_ij;
+            m_mat_M3(j, i) = M3_ij;
+        }
+    }
+
+    m_M3 = Eigen::TensorMap<const Eigen::Tensor<double, 2>>(m_mat_M3.data(), m_7M, m_7M);
 }
 
 void
 PotentialHydrodynamics::calcBodyMassGrad(const Eigen::ThreadPoolDevice& device)
 {
-    // `Eigen::Tensor` contraction indices
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_lj = {Eigen::IndexPair<int>(1, 0)}; // = A B
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_jl = {Eigen::IndexPair<int>(1, 1)}; // = A B^T
-
-    // `Eigen::Tensor` permutation indices
-    const Eigen::array<int, 3> permute_ikj_ijk({0, 2, 1}); // (i, j, k) --> (i, j, k)
-
     /* ANCHOR: Compute linear combinations of GRADIENTS of total mass matrix and zeta */
     // N^{(1)}
-    m_N1.device(device) = m_grad_M_added_body_coords;
+    evaluateTensor(device, m_N1.size(), m_N1, m_grad_M_added_body_coords);
+
+    /* NOTE: slice k of each rank-3 tensor (last index fixed) is a contiguous column-major matrix, so
+     * N^{(2)}_k = (grad zeta)_k M + zeta N^{(1)}_k and N^{(3)}_k = N^{(2)}_k zeta^T + M2 (grad zeta)_k^T are matrix
+     * products into the members. zeta and grad zeta are contracted one particle block at a time (see
+     * `SystemData::rbmConnBlock()`), and (grad zeta)_k only has blocks for the particles of the body of coordinate k.
+     * Slices are independent and split across the thread-pool of `device` */
+    const int num_chunks{numParallelChunks(device, m_7M, m_min_slices_per_chunk)};
 
-    // N^{(2)}
-    m_N2_term1_preshuffle.device(device) = m_system->tensGradRbmConn().contract(m_tens_M_total, contract_il_lj);
+    parallelForChunks(device, num_chunks, m_7M, [this](const int chunk_id, const int begin, const int end) {
+        for (int k = begin; k < end; k++)
+        {
+            const int body_id_k{k / 7};
+            const int k_7{k % 7}; // body coordinate derivative within its body
+
+            const Eigen::Map<const Eigen::MatrixXd> N1_k(m_N1.data() + static_cast<long>(k) * m_7N * m_7N, m_7N,
+                                                         m_7N);
+
+            Eigen::Map<Eigen::MatrixXd> N2_k(m_N2.data() + static_cast<long>(k) * m_7M * m_7N, m_7M, m_7N);
+            Eigen::Map<Eigen::MatrixXd> N3_k(m_N3.data() + static_cast<long>(k) * m_7M * m_7M, m_7M, m_7M);
+
+            // N^{(2)}
+            N2_k.setZero();
+
+            for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+            {
+                const int particle_id_7{7 * particle_id};
+                const int body_id{m_system->particleGroupId()(particle_id)};
+                const int body_id_7{7 * body_id};
+
+                N2_k.middleRows<7>(body_id_7).noalias() +=
+                    m_system->rbmConnBlock(particle_id) * N1_k.middleRows<7>(particle_id_7);
 
-    m_N2.device(device) = m_N2_term1_preshuffle.shuffle(permute_ikj_ijk);
-    m_N2.device(device) += m_system->tensRbmConn().contract(m_N1, contract_il_lj);
+                if (body_id == body_id_k)
+                {
+                    const Eigen::Map<const SystemData::RbmConnBlock> grad_rbm_conn_k(
+                        m_system->gradRbmConnBlock(particle_id).data() + 49 * k_7);
 
-    // N^{(3)}
-    m_N3_terms12_preshuffle.device(device) = m_N2.contract(m_system->tensRbmConn(), contract_il_jl);
+                    N2_k.middleRows<7>(body_id_7).noalias() += grad_rbm_conn_k * m_M_total.middleRows<7>(particle_id_7);
+                }
+            }
 
-    m_N3.device(device) = m_N3_terms12_preshuffle.shuffle(permute_ikj_ijk);
-    m_N3.device(device) += m_M2.contract(m_system->tensGradRbmConn(), contract_il_jl);
+            // N^{(3)}
+            N3_k.setZero();
+
+            for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+            {
+                const int particle_id_7{7 * particle_id};
+                const int body_id{m_system->particleGroupId()(particle_id)};
+                const int body_id_7{7 * body_id};
+
+                N3_k.middleCols<7>(body_id_7).noalias() +=
+                    N2_k.middleCols<7>(particle_id_7) * m_system->rbmConnBlock(particle_id).transpose();
+
+                if (body_id == body_id_k)
+                {
+                    const Eigen::Map<const SystemData::RbmConnBlock> grad_rbm_conn_k(
+                        m_system->gradRbmConnBlock(particle_id).data() + 49 * k_7);
+
+                    N3_k.middleCols<7>(body_id_7).noalias() +=
+                        m_mat_M2.middleCols<7>(particle_id_7) * grad_rbm_conn_k.transpose();
+                }
+            }
+        }
+    });
 }
 
 void
 PotentialHydrodynamics::calcHydroForces(const Eigen::ThreadPoolDevice& device)
 {
-    // `Eigen::Tensor` contraction indices
-    // 0th order contraction
-    const Eigen::array<Eigen::IndexPair<int>, 0> outer_product = {};
-    // 1st order contraction
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_ij_j = {Eigen::IndexPair<int>(1, 0)};
-    // 2nd order contraction
-    const Eigen::array<Eigen::IndexPair<int>, 2> contract_jki_jk = {Eigen::IndexPair<int>(0, 0),
-                                                                    Eigen::IndexPair<int>(1, 1)};
-    const Eigen::array<Eigen::IndexPair<int>, 2> contract_ijk_jk = {Eigen::IndexPair<int>(1, 0),
-                                                                    Eigen::IndexPair<int>(2, 1)};
-
-    // `Eigen::Tensor` permutation indices
-    const Eigen::array<int, 3> permute_ij_ji({1, 0});
-    const Eigen::array<int, 3> permute_ijk_jik({1, 0, 2});
-
-    // get kinematic tensors from SystemData class
-    Eigen::Tensor<double, 1> xi_dot  = TensorCast(m_system->velocitiesBodies(), m_7M);    // (7M x 1)
-    Eigen::Tensor<double, 1> xi_ddot = TensorCast(m_system->accelerationsBodies(), m_7M); // (7M x 1)
-
-    Eigen::Tensor<double, 1> V     = TensorCast(m_system->velocitiesParticlesArticulation(), m_7N);    // (7N x 1)
-    Eigen::Tensor<double, 1> V_dot = TensorCast(m_system->accelerationsParticlesArticulation(), m_7N); // (7N x 1)
+    /* NOTE: 2nd order contractions of the rank-3 tensors are matrix-vector products of their flattened forms,
+     * T_{j k i} X_{j k} = T_{(jk), i}^T vec(X) and T_{i j k} X_{j k} = T_{i, (jk)} vec(X), with the outer products X
+     * of the kinematic vectors evaluated into preallocated members */
+    const Eigen::VectorXd& xi_dot  = m_system->velocitiesBodies();                    // (7M x 1)
+    const Eigen::VectorXd& xi_ddot = m_system->accelerationsBodies();                 // (7M x 1)
+    const Eigen::VectorXd& V       = m_system->velocitiesParticlesArticulation();    // (7N x 1)
+    const Eigen::VectorXd& V_dot   = m_system->accelerationsParticlesArticulation(); // (7N x 1)
+
+    const long n_7M_7M{static_cast<long>(m_7M) * m_7M};
+    const long n_7M_7N{static_cast<long>(m_7M) * m_7N};
+    const long n_7N_7N{static_cast<long>(m_7N) * m_7N};
 
     // calculate 2nd order kinematic tensors
-    Eigen::Tensor<double, 2> V_V = Eigen::Tensor<double, 2>(m_7N, m_7N); // (7N x 7N)
-    V_V.device(device)           = V.contract(V, outer_product);
-
-    Eigen::Tensor<double, 2> xi_dot_xi_dot = Eigen::Tensor<double, 2>(m_7M, m_7M); // (7M x 7M)
-    xi_dot_xi_dot.device(device)           = xi_dot.contract(xi_dot, outer_product);
-
-    Eigen::Tensor<double, 2> xi_dot_V = Eigen::Tensor<double, 2>(m_7M, m_7N); // (7M x 7N)
-    xi_dot_V.device(device)           = xi_dot.contract(V, outer_product);
-
-    Eigen::Tensor<double, 2> V_xi_dot = Eigen::Tensor<double, 2>(m_7N, m_7M); // (7N x 7M)
-    V_xi_dot.device(device)           = xi_dot_V.shuffle(permute_ij_ji);
+    m_hf_V_V.noalias()           = V * V.transpose();           // (7N x 7N)
+    m_hf_xi_dot_xi_dot.noalias() = xi_dot * xi_dot.transpose(); // (7M x 7M)
+    m_hf_xi_dot_V.noalias()      = xi_dot * V.transpose();      // (7M x 7N)
+    m_hf_V_xi_dot.noalias()      = V * xi_dot.transpose();      // (7N x 7M)
+
+    const Eigen::Map<const Eigen::VectorXd> vec_V_V(m_hf_V_V.data(), n_7N_7N);
+    const Eigen::Map<const Eigen::VectorXd> vec_xi_dot_xi_dot(m_hf_xi_dot_xi_dot.data(), n_7M_7M);
+    const Eigen::Map<const Eigen::VectorXd> vec_xi_dot_V(m_hf_xi_dot_V.data(), n_7M_7N);
+    const Eigen::Map<const Eigen::VectorXd> vec_V_xi_dot(m_hf_V_xi_dot.data(), n_7M_7N);
+
+    // flattened rank-3 tensors
+    const Eigen::Map<const Eigen::MatrixXd> N1_jk_i(m_N1.data(), n_7N_7N, m_7M);
+    const Eigen::Map<const Eigen::MatrixXd> N2_jk_i(m_N2.data(), n_7M_7N, m_7M);
+    const Eigen::Map<const Eigen::MatrixXd> N2_i_jk(m_N2.data(), m_7M, n_7M_7N);
+    const Eigen::Map<const Eigen::MatrixXd> N3_jk_i(m_N3.data(), n_7M_7M, m_7M);
+    const Eigen::Map<const Eigen::MatrixXd> N3_i_jk(m_N3.data(), m_7M, n_7M_7M);
 
     // hydrodynamic forces arising from locater point motion (3 terms; contains locater inertia term)
-    Eigen::Tensor<double, 1> inertia_loc = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    inertia_loc.device(device)           = -m_M3.contract(xi_ddot, contract_ij_j);
+    m_hf_inertia_loc.noalias() = -m_mat_M3 * xi_ddot;
 
-    Eigen::Tensor<double, 1> F_loc = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    F_loc.device(device)           = inertia_loc;
-    F_loc.device(device) += 0.50 * m_N3.contract(xi_dot_xi_dot, contract_jki_jk);
-    F_loc.device(device) -= m_N3.contract(xi_dot_xi_dot, contract_ijk_jk);
+    m_F_hydroNoInertia.noalias() = 0.50 * N3_jk_i.transpose() * vec_xi_dot_xi_dot;
+    m_F_hydroNoInertia.noalias() -= N3_i_jk * vec_xi_dot_xi_dot;
 
     // hydrodynamic forces arising from coupling of locater and internal D.o.F. motion (2 terms)
-    Eigen::Tensor<double, 1> F_loc_int = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    F_loc_int.device(device)           = m_N2.contract(xi_dot_V, contract_jki_jk);
-    F_loc_int.device(device) -= m_N2.contract(V_xi_dot, contract_ijk_jk);
+    m_F_hydroNoInertia.noalias() += N2_jk_i.transpose() * vec_xi_dot_V;
+    m_F_hydroNoInertia.noalias() -= N2_i_jk * vec_V_xi_dot;
 
     // hydrodynamic forces arising from internal D.o.F. motion (2 terms; contains internal inertia term)
-    Eigen::Tensor<double, 1> F_int = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    F_int.device(device)           = 0.50 * m_N1.contract(V_V, contract_jki_jk);
-    F_int.device(device) -= m_M2.contract(V_dot, contract_ij_j);
+    m_F_hydroNoInertia.noalias() += 0.50 * N1_jk_i.transpose() * vec_V_V;
+    m_F_hydroNoInertia.noalias() -= m_mat_M2 * V_dot;
 
     // compute complete potential flow hydrodynamic force
-    Eigen::Tensor<double, 1> F_hydro = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    F_hydro.device(device)           = F_loc;
-    F_hydro.device(device) += F_loc_int;
-    F_hydro.device(device) += F_int;
-    m_F_hydro.noalias() = MatrixCast(F_hydro, m_7M, 1, device);
-
-    // Compute non-inertial part of force (include internal D.o.F. inertia)
-    Eigen::Tensor<double, 1> F_hydro_no_inertia = Eigen::Tensor<double, 1>(m_7M); // (7M x 1)
-    F_hydro_no_inertia.device(device)           = F_hydro;
-    F_hydro_no_inertia.device(device) -= inertia_loc;
-    m_F_hydroNoInertia.noalias() = MatrixCast(F_hydro_no_inertia, m_7M, 1, device);
+    m_F_hydro.noalias() = m_F_hydroNoInertia;
+    m_F_hydro.noalias() += m_hf_inertia_loc;
+}
+
+void
+PotentialHydrodynamics::calcHydroForcesMatrixFree(const Eigen::ThreadPoolDevice& device)
+{
+    // get kinematic vectors from SystemData class
+    const Eigen::VectorXd& xi_dot  = m_system->velocitiesBodies();                   // (7M x 1)
+    const Eigen::VectorXd& xi_ddot = m_system->accelerationsBodies();                // (7M x 1)
+    const Eigen::VectorXd& V       = m_system->velocitiesParticlesArticulation();    // (7N x 1)
+    const Eigen::VectorXd& V_dot   = m_system->accelerationsParticlesArticulation(); // (7N x 1)
+
+    /* NOTE: \Sigma, \chi and \nabla \Sigma only couple a particle to the body it belongs to, so all products with
+     * them are computed from their per-particle blocks in `SystemData` */
+
+    /* ANCHOR: particle velocities and accelerations from body kinematics */
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_3{3 * particle_id};
+        const int particle_id_7{7 * particle_id};
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+        const SystemData::RbmConnBlock&     sigma         = m_system->rbmConnBlock(particle_id);
+        const SystemData::GradRbmConnBlock& grad_rbm_conn = m_system->gradRbmConnBlock(particle_id);
+
+        // \dot{\Sigma}_{j c} = \partial_{k} \Sigma_{j c} \dot{\xi}_{k}
+        Eigen::Matrix<double, 7, 7> sigma_dot = Eigen::Matrix<double, 7, 7>::Zero();
+        for (int k = 0; k < 7; k++)
+        {
+            sigma_dot.noalias() +=
+                xi_dot(body_id_7 + k) * Eigen::Map<const SystemData::RbmConnBlock>(grad_rbm_conn.data() + 49 * k);
+        }
+
+        m_mf_vel.segment<7>(particle_id_7).noalias() = sigma.transpose() * xi_dot.segment<7>(body_id_7);
+        m_mf_vel.segment<7>(particle_id_7).noalias() += V.segment<7>(particle_id_7);
+
+        m_mf_acc.segment<7>(particle_id_7).noalias() = sigma_dot.transpose() * xi_dot.segment<7>(body_id_7);
+        m_mf_acc.segment<7>(particle_id_7).noalias() += V_dot.segment<7>(particle_id_7);
+
+        m_mf_acc_loc.segment<7>(particle_id_7).noalias() = sigma.transpose() * xi_ddot.segment<7>(body_id_7);
+
+        m_mf_x_dot.segment<3>(particle_id_3).noalias() =
+            m_system->chiBlock(particle_id).transpose() * xi_dot.segment<7>(body_id_7);
+    }
+
+    /* ANCHOR: mass matrix-vector products */
+    applyTotalMass(m_mf_vel, m_mf_M_vel, device);
+    applyTotalMass(m_mf_acc, m_mf_M_acc, device);
+    applyTotalMass(m_mf_acc_loc, m_mf_M_acc_loc, device);
+
+    /* ANCHOR: mass gradient quadratic forms, one particle pair at a time */
+    /* NOTE: pairs sharing a particle accumulate into the same elements, so each chunk accumulates into its own
+     * column of the partial sum matrices, which are reduced afterwards */
+    const int num_chunks{numParallelChunks(device, m_num_pair_inter, m_min_pairs_per_chunk)};
+
+    if (m_mf_M_dot_vel_partial.cols() < num_chunks)
+    {
+        m_mf_M_dot_vel_partial.resize(m_7N, num_chunks);
+        m_mf_grad_M_vel_vel_partial.resize(3 * m_num_particles, num_chunks);
+    }
+
+    parallelForChunks(device, num_chunks, m_num_pair_inter, [this](const int chunk_id, const int begin, const int end) {
+        auto M_dot_vel       = m_mf_M_dot_vel_partial.col(chunk_id);
+        auto grad_M_vel_vel = m_mf_grad_M_vel_vel_partial.col(chunk_id);
+
+        M_dot_vel.setZero();
+        grad_M_vel_vel.setZero();
+
+        for (int k = begin; k < end; k++)
+        {
+            // far-field cutoff: gradient block is zero
+            if (m_r_mag_ab(k) >= m_r_cut)
+            {
+                continue;
+            }
+
+            const int i_3{3 * m_alphaVec(k)};
+            const int j_3{3 * m_betaVec(k)};
+
+            const int i_7{7 * m_alphaVec(k)};
+            const int j_7{7 * m_betaVec(k)};
+
+            const BlockSparseGradient::Block& B = m_grad_M_added.block(k);
+
+            const Eigen::Vector3d dx_dot = m_mf_x_dot.segment<3>(i_3) - m_mf_x_dot.segment<3>(j_3);
+            const Eigen::Vector3d w_i    = m_mf_vel.segment<3>(i_7);
+            const Eigen::Vector3d w_j    = m_mf_vel.segment<3>(j_7);
+
+            // \dot{M}_{ij} = \nabla_{i} M_{ij} (\dot{x}_{i} - \dot{x}_{j}) and w_i \nabla_{i} M_{ij} w_j
+            Eigen::Matrix3d M_dot_ij = Eigen::Matrix3d::Zero();
+            Eigen::Vector3d w_grad_M_w;
+
+            for (int r = 0; r < 3; r++)
+            {
+                Eigen::Matrix3d B_r;
+                B_r << B(0, 0, r), B(0, 1, r), B(0, 2, r), B(1, 0, r), B(1, 1, r), B(1, 2, r), B(2, 0, r),
+                    B(2, 1, r), B(2, 2, r);
+
+                M_dot_ij.noalias() += dx_dot(r) * B_r;
+                w_grad_M_w(r) = 2.0 * w_i.dot(B_r * w_j);
+            }
+
+            M_dot_vel.segment<3>(i_7).noalias() += M_dot_ij * w_j;
+            M_dot_vel.segment<3>(j_7).noalias() += M_dot_ij.transpose() * w_i;
+
+            grad_M_vel_vel.segment<3>(i_3).noalias() += w_grad_M_w;
+            grad_M_vel_vel.segment<3>(j_3).noalias() -= w_grad_M_w;
+        }
+    });
+
+    m_mf_M_dot_vel.noalias()      = m_mf_M_dot_vel_partial.leftCols(num_chunks).rowwise().sum();
+    m_mf_grad_M_vel_vel.noalias() = m_mf_grad_M_vel_vel_partial.leftCols(num_chunks).rowwise().sum();
+
+    /* ANCHOR: (real, image) particle pairs, image particle q' has velocity R w_q and position R x_q */
+    /* NOTE: only the gradient w.r.t. the real particle p is needed, so chunks over p never conflict */
+    if (m_mirror_image)
+    {
+        const int num_img_chunks{numParallelChunks(device, m_num_particles, 1)};
+
+        parallelForChunks(device, num_img_chunks, m_num_particles,
+                          [this](const int chunk_id, const int begin, const int end) {
+                              for (int p = begin; p < end; p++)
+                              {
+                                  const int p_3{3 * p};
+                                  const int p_7{7 * p};
+
+                                  const Eigen::Vector3d w_p = m_mf_vel.segment<3>(p_7);
+
+                                  for (int q = 0; q < m_num_particles; q++)
+                                  {
+                                      const int k{p * m_num_particles + q};
+
+                                      if (m_img_r_mag_ab(k) >= m_r_cut)
+                                      {
+                                          continue;
+                                      }
+
+                                      const int q_3{3 * q};
+                                      const int q_7{7 * q};
+
+                                      const BlockSparseGradient::Block& B = m_grad_M_image[k];
+
+                                      const Eigen::Vector3d dx_dot =
+                                          m_mf_x_dot.segment<3>(p_3) -
+                                          m_reflect.cwiseProduct(m_mf_x_dot.segment<3>(q_3));
+                                      const Eigen::Vector3d w_q = m_reflect.cwiseProduct(m_mf_vel.segment<3>(q_7));
+
+                                      Eigen::Matrix3d M_dot_pq = Eigen::Matrix3d::Zero();
+
+                                      for (int r = 0; r < 3; r++)
+                                      {
+                                          Eigen::Matrix3d B_r;
+                                          B_r << B(0, 0, r), B(0, 1, r), B(0, 2, r), B(1, 0, r), B(1, 1, r),
+                                              B(1, 2, r), B(2, 0, r), B(2, 1, r), B(2, 2, r);
+
+                                          M_dot_pq.noalias() += dx_dot(r) * B_r;
+                                          m_mf_grad_M_vel_vel(p_3 + r) += 2.0 * w_p.dot(B_r * w_q);
+                                      }
+
+                                      m_mf_M_dot_vel.segment<3>(p_7).noalias() += M_dot_pq * w_q;
+                                  }
+                              }
+                          });
+    }
+
+    /* ANCHOR: project particle forces onto body coordinates */
+    m_F_hydroNoInertia.setZero();
+    m_F_hydro.setZero(); // locater inertia term
+
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_3{3 * particle_id};
+        const int particle_id_7{7 * particle_id};
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+        const SystemData::RbmConnBlock&     sigma         = m_system->rbmConnBlock(particle_id);
+        const SystemData::GradRbmConnBlock& grad_rbm_conn = m_system->gradRbmConnBlock(particle_id);
+
+        // (P - \dot{\Sigma}) M w, with P_{k c} = \partial_{k} \Sigma_{j c} \dot{\xi}_{j}
+        const Eigen::Matrix<double, 7, 1> M_vel = m_mf_M_vel.segment<7>(particle_id_7);
+        Eigen::Matrix<double, 7, 1>       P_M_vel = Eigen::Matrix<double, 7, 1>::Zero();
+
+        for (int k = 0; k < 7; k++)
+        {
+            for (int c = 0; c < 7; c++)
+            {
+                for (int j = 0; j < 7; j++)
+                {
+                    const double grad_sigma_jck{grad_rbm_conn(j, c, k)};
+
+                    P_M_vel(k) += grad_sigma_jck * xi_dot(body_id_7 + j) * M_vel(c);
+                    P_M_vel(j) -= grad_sigma_jck * xi_dot(body_id_7 + k) * M_vel(c);
+                }
+            }
+        }
+
+        m_F_hydroNoInertia.segment<7>(body_id_7).noalias() += P_M_vel;
+        m_F_hydroNoInertia.segment<7>(body_id_7).noalias() +=
+            0.50 * m_system->chiBlock(particle_id) * m_mf_grad_M_vel_vel.segment<3>(particle_id_3);
+        m_F_hydroNoInertia.segment<7>(body_id_7).noalias() -= sigma * m_mf_M_dot_vel.segment<7>(particle_id_7);
+        m_F_hydroNoInertia.segment<7>(body_id_7).noalias() -= sigma * m_mf_M_acc.segment<7>(particle_id_7);
+
+        m_F_hydro.segment<7>(body_id_7).noalias() -= sigma * m_mf_M_acc_loc.segment<7>(particle_id_7);
+    }
+
+    m_F_hydro.noalias() += m_F_hydroNoInertia;
+}
+
+void
+PotentialHydrodynamics::applyAddedMass(const Eigen::VectorXd& vel, Eigen::VectorXd& M_vel,
+                                       const Eigen::ThreadPoolDevice& device)
+{
+    if (!m_use_treecode)
+    {
+        M_vel.noalias() = m_M_added * vel;
+
+        if (m_mirror_image)
+        {
+            M_vel.noalias() += m_M_image * vel;
+        }
+
+        return;
+    }
+
+    const double mass_units{m_system->fluidDensity() * m_unit_sphere_volume};
+
+    // only linear components couple through the added mass
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        m_tc_vel.segment<3>(3 * particle_id).noalias() = vel.segment<3>(7 * particle_id);
+    }
+
+    m_treecode.apply(m_tc_vel, m_tc_M_vel, device);
+
+    // M = 1/2 I + M^{(1)}
+    M_vel.setZero();
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        M_vel.segment<3>(7 * particle_id).noalias() = m_c1_2 * m_tc_vel.segment<3>(3 * particle_id);
+        M_vel.segment<3>(7 * particle_id).noalias() += m_tc_M_vel.segment<3>(3 * particle_id);
+        M_vel.segment<3>(7 * particle_id) *= mass_units;
+    }
+}
+
+void
+PotentialHydrodynamics::applyTotalMass(const Eigen::VectorXd& vel, Eigen::VectorXd& M_vel,
+                                       const Eigen::ThreadPoolDevice& device)
+{
+    if (!m_use_treecode)
+    {
+        M_vel.noalias() = m_M_total * vel;
+
+        if (m_mirror_image)
+        {
+            M_vel.noalias() += m_M_image * vel;
+        }
+
+        return;
+    }
+
+    applyAddedMass(vel, M_vel, device);
+    M_vel.noalias() += m_M_intrinsic_diag.cwiseProduct(vel);
 }
 
 void
 PotentialHydrodynamics::calcHydroEnergy(const Eigen::ThreadPoolDevice& device)
 {
+    if (m_use_treecode || m_mirror_image)
+    {
+        /* NOTE: with u = \Sigma^T \dot{\xi}, the body mass quadratic forms are
+         * \dot{\xi}^T M3 \dot{\xi} = u^T M u and \dot{\xi}^T M2 V = u^T M V */
+        const auto V   = m_system->velocitiesParticlesArticulation().head(m_7N);
+        const auto vel = m_system->velocitiesParticles().head(m_7N);
+
+        m_en_V.noalias()   = V;
+        m_en_vel.noalias() = vel;
+
+        applyTotalMass(m_en_V, m_en_M_V, device);
+        applyAddedMass(m_en_vel, m_en_M_vel, device);
+
+        m_en_u.noalias()   = m_mf_vel - V;
+        m_en_M_u.noalias() = m_mf_M_vel - m_en_M_V;
+
+        // NOTE: image 1/2 of the system carries the same kinetic energy as the real 1/2
+        const double image_factor{m_mirror_image ? 2.0 : 1.0};
+
+        double e_simple = 0.50 * vel.dot(m_en_M_vel);
+        e_simple += (0.50 * m_system->particleDensity() * m_unit_sphere_volume) * vel.dot(vel);
+
+        m_system->setEHydroLoc(image_factor * 0.50 * m_en_u.dot(m_en_M_u));
+        m_system->setEHydroLocInt(image_factor * m_en_u.dot(m_en_M_V));
+        m_system->setEHydroInt(image_factor * 0.50 * V.dot(m_en_M_V));
+        m_system->setEHydroSimple(image_factor * e_simple);
+
+        return;
+    }
+
     // matrix vector reduction
-    const Eigen::VectorXd m3_xi_dot = m_mat_M3 * m_system->velocitiesBodies();
-    const Eigen::VectorXd m2_v      = m_mat_M2 * m_system->velocitiesParticlesArticulation();
-    const Eigen::VectorXd m_v       = m_M_total * m_system->velocitiesParticlesArticulation();
-    const Eigen::VectorXd m_vel     = m_M_added * m_system->velocitiesParticles();
+    m_en_M3_xi_dot.noalias() = m_mat_M3 * m_system->velocitiesBodies();
+    m_en_M2_V.noalias()      = m_mat_M2 * m_system->velocitiesParticlesArticulation();
+    m_en_M_V.noalias()       = m_M_total * m_system->velocitiesParticlesArticulation();
+    m_en_M_vel.noalias()     = m_M_added * m_system->velocitiesParticles();
 
     // contractions to produce energies
-    const double e_loc{0.50 * m_system->velocitiesBodies().dot(m3_xi_dot)};
-    const double e_loc_int{m_system->velocitiesBodies().dot(m2_v)};
-    const double e_int{0.50 * m_system->velocitiesParticlesArticulation().dot(m_v)};
+    const double e_loc{0.50 * m_system->velocitiesBodies().dot(m_en_M3_xi_dot)};
+    const double e_loc_int{m_system->velocitiesBodies().dot(m_en_M2_V)};
+    const double e_int{0.50 * m_system->velocitiesParticlesArticulation().dot(m_en_M_V)};
 
-    double e_simple = 0.50 * m_system->velocitiesParticles().dot(m_vel);
+    double e_simple = 0.50 * m_system->velocitiesParticles().dot(m_en_M_vel);
     e_simple += (0.50 * m_system->particleDensity() * m_unit_sphere_volume) *
                 m_system->velocitiesParticles().dot(m_system->velocitiesParticles());
 
@@ -10,6 +10,9 @@
 #error This header cannot be compiled by nvcc
 #endif
 /* Include all internal project dependencies */
+#include <BlockSparseGradient.hpp>
+#include <DipoleTreecode.hpp>
+#include <NeighborList.hpp>
 #include <SystemData.hpp>
 
 /* Include all external project dependencies */
@@ -28,12 +31,20 @@
 #include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
 // eigen3 conversion between Eigen::Tensor (unsupported) and Eigen::Matrix
 #include <helper_eigenTensorConversion.hpp>
+// eigen3 thread-pool parallel loops
+#include <helper_eigenParallelFor.hpp>
+// eigen3 size-aware evaluation of tensor expressions
+#include <helper_eigenExecutionPolicy.hpp>
 // Logging
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
+// STL
+#include <limits> // std::numeric_limits
+#include <vector> // std::vector
 
 /* Forward declarations */
 class SystemData;
+class TestPotentialHydrodynamics;
 
 /**
  * @class PotentialHydrodynamics
@@ -43,6 +54,8 @@ class SystemData;
  */
 class PotentialHydrodynamics
 {
+    friend class TestPotentialHydrodynamics;
+
   public:
     /**
      * @brief Construct a new potential hydrodynamics object
@@ -63,12 +76,25 @@ class PotentialHydrodynamics
      * @details Functions must be called in a certain grouping.
      * Functions within a group can be called in any order.
      * Groups must be called in ascending order.
-     * (1) `calcParticleDistances()`.
+     * (0) `updatePairList()`.
+     * (1) `calcParticleDistances()`, `DipoleTreecode::build()`.
      * (2) `calcAddedMass()`, `calcAddedMassGrad()`.
      * (3) `calcTotalMass()`.
      * (4) `calcBodyMass()`.
-     * (5) `calcHydroForces()`.
-     * (6) `calcHydroEnergy()`
+     * (5) `calcBodyMassGrad()`.
+     * (6) `calcHydroForces()` or `calcHydroForcesMatrixFree()`.
+     * (7) `calcHydroEnergy()`.
+     * If `SystemData::matrixFreeHydro()` is set, `calcBodyMassGrad()` and `calcHydroForces()` are replaced by
+     * `calcHydroForcesMatrixFree()`.
+     * Groups are only evaluated if the `SystemData` state they depend on changed since their last evaluation (see
+     * `m_update_graph`): groups (0) - (5) depend on time and body positions, forces also on body velocities and
+     * accelerations, and energies also on body velocities.
+     * Independent stages run concurrently on the thread-pool of `device` (see `parallelInvoke()`): `calcAddedMass()`,
+     * `calcTotalMass()` and `calcBodyMass()` with `calcAddedMassGrad()`, and `calcBodyMassGrad()` and the forces with
+     * `calcHydroEnergy()` (unless the energies reuse the matrix-free force products).
+     * If `m_use_treecode`, no (7N x 7N) matrix is formed: `calcAddedMass()` and `calcTotalMass()` are skipped,
+     * `calcBodyMass()` is evaluated from treecode products (see `calcBodyMassTreecode()`) and the pair loops only
+     * visit the near-field pairs of `m_treecode` (see `updateTreecodePairs()`).
      *
      * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
@@ -76,25 +102,99 @@ class PotentialHydrodynamics
     void
     update(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Computes the (3 x 3) translation-translation block @f$ \boldsymbol{M}_{\alpha \beta} @f$ of the total
+     * mass matrix
+     *
+     * @details Read from `m_M_total`, or evaluated from the particle positions if `m_use_treecode`.
+     *
+     * @param alpha first particle
+     * @param beta second particle
+     * @return Eigen::Matrix3d mass block
+     */
+    Eigen::Matrix3d
+    mTotalLinearBlock(const int alpha, const int beta) const;
+
   private:
     /**
-     * @brief Calculates `m_r_mag_ab` and `m_r_ab` at current configuration
+     * @brief Updates the neighbor list and, if it was rebuilt, the particle pairs of all pair loops
+     *
+     * @details Only active if `SystemData::pairTolerance()` is positive, otherwise all @f$ 1/2 \, N \, (N - 1) @f$
+     * pairs are always evaluated.
+     * Pairs in the list with separation larger than `m_r_cut` are skipped by the pair loops, so results do not depend
+     * on when the list was last rebuilt.
+     *
+     */
+    void
+    updatePairList();
+
+    /**
+     * @brief Replaces the particle pairs of all pair loops with the near-field pairs of `m_treecode`
+     *
+     * @details Only active if `m_use_treecode`, must call `DipoleTreecode::build()` before.
+     * Added mass gradient blocks decay as @f$ r^{-4} @f$ and are only evaluated for near-field pairs, so the pair
+     * loops are @f$ \mathcal{O}(N) @f$ instead of @f$ \mathcal{O}(N^2) @f$.
+     * Node radii are enlarged by `m_treecode_padding` in the far-field criterion, so pairs closer than
+     * `m_treecode_padding` / @f$ \theta @f$ are always evaluated.
+     * Pairs are only replaced if the near-field changed since the last call.
+     *
+     */
+    void
+    updateTreecodePairs();
+
+    /**
+     * @brief Resizes the particle pair data of all pair loops to `alpha_vec.size()` pairs and copies the pairs
+     *
+     * @param alpha_vec first particle of pairs
+     * @param beta_vec second particle of pairs
+     */
+    void
+    setPairs(const Eigen::VectorXi& alpha_vec, const Eigen::VectorXi& beta_vec);
+
+    /**
+     * @brief Calculates `m_r_ab`, `m_r_mag_ab` and the inverse powers of `m_r_mag_ab` at current configuration
+     *
+     * @details Configuration specified in `SystemData` class.
+     * Particle pairs are split across the thread-pool of `device`.
+     * Pair displacements are gathered into structure-of-arrays storage, so distances and inverse powers are evaluated
+     * as `Eigen::Array` expressions that are vectorized over consecutive pairs (SSE/AVX/AVX-512 packets as enabled
+     * by the compiler flags, scalar otherwise).
      *
-     * @details Configuration specified in `SystemData` class
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
      */
     void
-    calcParticleDistances();
+    calcParticleDistances(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Calculates the distances and inverse powers of pairs [`begin`, `begin` + `num_pairs`) from their
+     * displacements
+     *
+     * @param begin first pair
+     * @param num_pairs number of consecutive pairs
+     * @param r_ab (s x 3) pair displacements
+     * @param r_mag_ab (output) (s x 1) pair distances
+     * @param r_inv3_ab (output) (s x 1) @f$ r^{-3} @f$ of pairs
+     * @param r_inv5_ab (output) (s x 1) @f$ r^{-5} @f$ of pairs
+     * @param r_inv7_ab (output) (s x 1) @f$ r^{-7} @f$ of pairs
+     */
+    static void
+    calcInversePowers(const int begin, const int num_pairs, const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab,
+                      Eigen::VectorXd& r_mag_ab, Eigen::ArrayXd& r_inv3_ab, Eigen::ArrayXd& r_inv5_ab,
+                      Eigen::ArrayXd& r_inv7_ab);
 
     /**
      * @brief Calculates `m_M_added`
      *
      * @details Must call `calcParticleDistances()` before.
      * Configuration specified in `SystemData` class.
+     * Particle pairs are split across the thread-pool of `device`.
+     *
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
      */
     void
-    calcAddedMass();
+    calcAddedMass(const Eigen::ThreadPoolDevice& device);
 
     /**
      * @brief Calculates `m_M_added`
@@ -106,10 +206,11 @@ class PotentialHydrodynamics
     calcTotalMass();
 
     /**
-     * @brief Calculates `m_M_added`
+     * @brief Calculates `m_grad_M_added` and `m_grad_M_added_body_coords`
      *
      * @details Must call `calcParticleDistances()` before.
-     * Configuration specified in `SystemData` class
+     * Configuration specified in `SystemData` class.
+     * Particle pairs are split across the thread-pool of `device`.
      *
      * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
@@ -117,10 +218,66 @@ class PotentialHydrodynamics
     void
     calcAddedMassGrad(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Calculates the unique elements of the (3 x 3) added mass blocks @f$ M^{(1)}_{\alpha \beta} @f$ of pairs
+     * [`begin`, `begin` + `num_pairs`) (without mass units), vectorized over the pairs
+     *
+     * @details Pairs outside the far-field cutoff have zero elements.
+     *
+     * @param begin first pair
+     * @param num_pairs number of consecutive pairs
+     * @param r_ab (s x 3) pair displacements
+     * @param r_mag_ab (s x 1) pair distances
+     * @param r_inv3_ab (s x 1) @f$ r^{-3} @f$ of pairs
+     * @param r_inv5_ab (s x 1) @f$ r^{-5} @f$ of pairs
+     * @param M1_ab (output) (s x 6) symmetric block elements (xx, xy, xz, yy, yz, zz) of pairs
+     */
+    void
+    calcAddedMassCoefficients(const int begin, const int num_pairs,
+                              const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab, const Eigen::VectorXd& r_mag_ab,
+                              const Eigen::ArrayXd& r_inv3_ab, const Eigen::ArrayXd& r_inv5_ab,
+                              Eigen::Matrix<double, Eigen::Dynamic, 6>& M1_ab) const;
+
+    /**
+     * @brief Calculates the unique elements of the (3 x 3 x 3) added mass gradient blocks
+     * @f$ \nabla_{\alpha} M_{\alpha \beta} @f$ of pairs [`begin`, `begin` + `num_pairs`) (with mass units), vectorized
+     * over the pairs
+     *
+     * @details Pairs outside the far-field cutoff have zero elements.
+     *
+     * @param begin first pair
+     * @param num_pairs number of consecutive pairs
+     * @param r_ab (s x 3) pair displacements
+     * @param r_mag_ab (s x 1) pair distances
+     * @param r_inv5_ab (s x 1) @f$ r^{-5} @f$ of pairs
+     * @param r_inv7_ab (s x 1) @f$ r^{-7} @f$ of pairs
+     * @param grad_M1_ab (output) (s x 10) fully symmetric block elements (xxx, xxy, xxz, xyy, xyz, xzz, yyy, yyz, yzz,
+     * zzz) of pairs
+     */
+    void
+    calcAddedMassGradCoefficients(const int begin, const int num_pairs,
+                                  const Eigen::Matrix<double, Eigen::Dynamic, 3>& r_ab, const Eigen::VectorXd& r_mag_ab,
+                                  const Eigen::ArrayXd& r_inv5_ab, const Eigen::ArrayXd& r_inv7_ab,
+                                  Eigen::Matrix<double, Eigen::Dynamic, 10>& grad_M1_ab) const;
+
+    /**
+     * @brief Expands the unique elements of an added mass gradient block (see `calcAddedMassGradCoefficients()`) into
+     * the (3 x 3 x 3) block
+     *
+     * @param grad_M1_ab (s x 10) fully symmetric block elements of pairs
+     * @param k pair
+     * @param grad_block (output) gradient block
+     */
+    static void
+    unpackAddedMassGradBlock(const Eigen::Matrix<double, Eigen::Dynamic, 10>& grad_M1_ab, const int k,
+                             BlockSparseGradient::Block& grad_block);
+
     /**
      * @brief Calculates \{`m_M2`, `m_M3`\}
      *
      * @details Must call `calcTotalMass()` and assumes `SystemData` rigid body motion tensors are up to date.
+     * Dispatches to `calcBodyMassSized()` for the collinear swimmer system sizes (N = 3, M = 1 and N = 6, M = 2),
+     * to `calcBodyMassTreecode()` if `m_use_treecode`, and to `calcBodyMassDynamic()` otherwise.
      *
      * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
@@ -128,10 +285,53 @@ class PotentialHydrodynamics
     void
     calcBodyMass(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Implementation of `calcBodyMass()` with column blocks of `m_mat_M2` split across the thread-pool of
+     * `device`
+     *
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     *
+     */
+    void
+    calcBodyMassDynamic(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Implementation of `calcBodyMass()` with matrix sizes fixed at compile-time
+     *
+     * @details Evaluated as fixed-size matrix products on the calling thread, without heap allocations or thread-pool
+     * dispatch.
+     *
+     * @tparam Size7N = 7N
+     * @tparam Size7M = 7M
+     */
+    template <int Size7N, int Size7M>
+    void
+    calcBodyMassSized();
+
+    /**
+     * @brief Implementation of `calcBodyMass()` from treecode products, only `m_M3` is evaluated
+     *
+     * @details Column @f$ c @f$ of @f$ \boldsymbol{M}_3 = \boldsymbol{\Sigma} \boldsymbol{M}
+     * \boldsymbol{\Sigma}^{\mathrm{T}} @f$ is @f$ \boldsymbol{\Sigma} \boldsymbol{M} \boldsymbol{u}_{c} @f$ with
+     * @f$ \boldsymbol{u}_{c} = \boldsymbol{\Sigma}^{\mathrm{T}} \boldsymbol{e}_{c} @f$, evaluated with
+     * `applyTotalMass()`.
+     * Costs 7M treecode products, @f$ \mathcal{O}(M N \log N) @f$, and @f$ \mathcal{O}(N + M^2) @f$ memory,
+     * instead of the @f$ \mathcal{O}(N^2) @f$ fill of the dense `m_M_total`.
+     * The result is symmetrized, as treecode products are only symmetric up to the far-field error.
+     *
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     *
+     */
+    void
+    calcBodyMassTreecode(const Eigen::ThreadPoolDevice& device);
+
     /**
      * @brief Calculates \{`m_N1`, `m_N2`, `m_N3`\}
      *
-     * @details Must call `calcTotalMass()` and assumes `SystemData` rigid body motion tensors are up to date.
+     * @details Must call `calcTotalMass()` and `calcBodyMass()` before and assumes `SystemData` rigid body motion
+     * tensors are up to date.
+     * Each slice of the rank-3 tensors along the last index is evaluated as matrix products into the member tensors,
+     * with slices split across the thread-pool of `device`.
      *
      * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
      *
@@ -151,6 +351,59 @@ class PotentialHydrodynamics
     void
     calcHydroForces(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Calculates `m_F_hydro` and `m_F_hydroNoInertia` without forming \{`m_N1`, `m_N2`, `m_N3`\}
+     *
+     * @details Must call `calcAddedMassGrad()` and `calcTotalMass()` before.
+     * Kinematics specified in `SystemData` class.
+     * Evaluates the same forces as `calcHydroForces()` as quadratic forms in the total particle velocity
+     * @f$ \boldsymbol{w} = \boldsymbol{\Sigma}^{\mathrm{T}} \dot{\boldsymbol{\xi}} + \boldsymbol{V} @f$:
+     * @f$ \boldsymbol{F} = (\boldsymbol{P} - \dot{\boldsymbol{\Sigma}}) \boldsymbol{M} \boldsymbol{w}
+     * + \frac{1}{2} \boldsymbol{\chi} \, (\boldsymbol{w} \cdot \nabla_{x} \boldsymbol{M} \cdot \boldsymbol{w})
+     * - \boldsymbol{\Sigma} \dot{\boldsymbol{M}} \boldsymbol{w} - \boldsymbol{\Sigma} \boldsymbol{M}
+     * \boldsymbol{a} @f$,
+     * where @f$ P_{k b} = \partial_{k} \Sigma_{j b} \, \dot{\xi}_{j} @f$ and @f$ \boldsymbol{a} @f$ is the
+     * total particle acceleration.
+     * Rigid body motion tensors are applied one particle block at a time and mass gradients one particle pair at a
+     * time, so cost and memory are quadratic in the number of particles.
+     * Mass matrix-vector products are evaluated with `applyTotalMass()`.
+     * If `m_mirror_image`, image particles add @f$ \dot{\boldsymbol{M}} \boldsymbol{w} @f$ and
+     * @f$ \boldsymbol{w} \cdot \nabla_{x} \boldsymbol{M} \cdot \boldsymbol{w} @f$ terms to every real particle
+     * through the reflected velocities @f$ \boldsymbol{R} \boldsymbol{w} @f$.
+     *
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     *
+     */
+    void
+    calcHydroForcesMatrixFree(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Computes the added mass matrix-vector product @f$ \boldsymbol{M}_{\mathrm{added}} \, \boldsymbol{v}
+     * @f$
+     *
+     * @details Evaluated with `m_treecode` if `m_use_treecode`, otherwise with the dense `m_M_added`.
+     * If `m_mirror_image`, the coupling to the image particles `m_M_image` is included.
+     * Must call `calcAddedMass()` (dense) or `DipoleTreecode::build()` (treecode) before.
+     *
+     * @param vel (7N x 1) particle velocity-like vector
+     * @param M_vel (output) (7N x 1) product
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     */
+    void
+    applyAddedMass(const Eigen::VectorXd& vel, Eigen::VectorXd& M_vel, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Computes the total mass matrix-vector product @f$ \boldsymbol{M} \, \boldsymbol{v} @f$
+     *
+     * @details Intrinsic mass and moment of inertia matrices are diagonal, see `applyAddedMass()` for the added mass.
+     *
+     * @param vel (7N x 1) particle velocity-like vector
+     * @param M_vel (output) (7N x 1) product
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     */
+    void
+    applyTotalMass(const Eigen::VectorXd& vel, Eigen::VectorXd& M_vel, const Eigen::ThreadPoolDevice& device);
+
     /**
      * @brief Calculates and sets energetic components in `SystemData` class
      *
@@ -170,11 +423,50 @@ class PotentialHydrodynamics
     /// path of logfile for spdlog to write to
     std::string m_logFile;
     /// filename of logfile for spdlog to write to
-    const std::string m_logName{"PotentialHydrodynamics"};
+    std::string m_logName{"PotentialHydrodynamics"};
 
     // For-loop variables
-    /// = s. Number of pairwise interactions to count: @f$s = 1/2 \, N \, (N - 1) @f$
+    /// = s. Number of pairwise interactions to count: @f$s = 1/2 \, N \, (N - 1) @f$ (without far-field cutoff)
     int m_num_pair_inter{-1};
+    /// Minimum number of particle pairs evaluated per thread-pool task in pair loops
+    const int m_min_pairs_per_chunk{64};
+
+    // ANCHOR: mirror-aware image system
+    /// If only the real 1/2 of an image system is stored and image particles are added through the reflection
+    /// @f$ \boldsymbol{R} = \mathrm{diag}(1, 1, -1) @f$. Set from `SystemData` during construction
+    bool m_mirror_image{false};
+    /// = N. Number of particles stored (real particles only if `m_mirror_image`)
+    int m_num_particles{-1};
+    /// = M. Number of bodies stored (real bodies only if `m_mirror_image`)
+    int m_num_bodies{-1};
+    /// = N^2. Number of (real, image) particle pairs; pair k couples real particle k / N to the image of k % N
+    int m_num_image_pair{0};
+    /// (N^2 x 3) displacement from image particle to real particle
+    Eigen::Matrix<double, Eigen::Dynamic, 3> m_img_r_ab;
+    /// (N^2 x 1) distance from image particle to real particle
+    Eigen::VectorXd m_img_r_mag_ab;
+    /// (N^2 x 1) @f$ r^{-3} @f$ of (real, image) particle pairs
+    Eigen::ArrayXd m_img_r_inv3_ab;
+    /// (N^2 x 1) @f$ r^{-5} @f$ of (real, image) particle pairs
+    Eigen::ArrayXd m_img_r_inv5_ab;
+    /// (N^2 x 1) @f$ r^{-7} @f$ of (real, image) particle pairs
+    Eigen::ArrayXd m_img_r_inv7_ab;
+    /// (N^2 x 6) unique elements of @f$ M^{(1)} @f$ blocks of (real, image) particle pairs (without mass units)
+    Eigen::Matrix<double, Eigen::Dynamic, 6> m_img_M1_ab;
+    /// (N^2 x 10) unique elements of @f$ \nabla M^{(1)} @f$ blocks of (real, image) particle pairs (with mass units)
+    Eigen::Matrix<double, Eigen::Dynamic, 10> m_img_grad_M1_ab;
+    /// (7N x 7N) added mass coupling through image particles: block (p, q) is @f$ M_{p q'} \boldsymbol{R} @f$
+    Eigen::MatrixXd m_M_image;
+    /// (N^2 x 1) gradient blocks @f$ \nabla_{p} M_{p q'} @f$ of (real, image) particle pairs
+    std::vector<BlockSparseGradient::Block> m_grad_M_image;
+
+    // ANCHOR: far-field cutoff of pairwise interactions
+    /// If pairwise interactions are truncated at `m_r_cut` and pairs are taken from `m_neighbor_list`
+    bool m_use_neighbor_list{false};
+    /// Cutoff distance of pairwise interactions. Set from `SystemData::pairTolerance()` during construction
+    double m_r_cut{std::numeric_limits<double>::infinity()};
+    /// Verlet neighbor list of particle pairs within `m_r_cut` (only used if `m_use_neighbor_list`)
+    NeighborList m_neighbor_list;
 
     // tensor variables
     /// 7N length of tensor quantities
@@ -189,10 +481,21 @@ class PotentialHydrodynamics
     Eigen::VectorXi m_betaVec;
     /// (s x 1) relative displacement between particle pairs
     Eigen::VectorXd m_r_mag_ab;
-    /// (3 x s) relative displacement between particle pairs
-    Eigen::MatrixXd m_r_ab;
+    /// (s x 3) relative displacement between particle pairs (structure-of-arrays: one contiguous column per dimension)
+    Eigen::Matrix<double, Eigen::Dynamic, 3> m_r_ab;
+    /// (s x 1) @f$ r^{-3} @f$ of particle pairs
+    Eigen::ArrayXd m_r_inv3_ab;
+    /// (s x 1) @f$ r^{-5} @f$ of particle pairs
+    Eigen::ArrayXd m_r_inv5_ab;
+    /// (s x 1) @f$ r^{-7} @f$ of particle pairs
+    Eigen::ArrayXd m_r_inv7_ab;
+    /// (s x 6) unique elements of @f$ M^{(1)} @f$ blocks of particle pairs (without mass units)
+    Eigen::Matrix<double, Eigen::Dynamic, 6> m_M1_ab;
+    /// (s x 10) unique elements of @f$ \nabla M^{(1)} @f$ blocks of particle pairs (with mass units)
+    Eigen::Matrix<double, Eigen::Dynamic, 10> m_grad_M1_ab;
 
     // ANCHOR: identity Matrices
+    // NOTE: (7N x 7N) matrices, (7M x 7N) `m_M2` and `m_mat_M2` are empty if `m_use_treecode`
     /// (7N x 7N) identity matrix for (3N x 3N) subset of linear elements
     Eigen::MatrixXd m_I7N_linear;
     /// (7N x 7N) identity matrix for (3N x 3N) subset of angular elements
@@ -210,10 +513,9 @@ class PotentialHydrodynamics
     /// (7N x 7N) total mass matrix
     Eigen::MatrixXd m_M_total;
 
-    /// (7N x 7N) tensor version of total mass matrix
-    Eigen::Tensor<double, 2> m_tens_M_total;
-    /// (7N x 7N x 3N) gradient of total mass matrix (only added mass components) in particle coordinates
-    Eigen::Tensor<double, 3> m_grad_M_added;
+    /// (7N x 7N x 3N) gradient of total mass matrix (only added mass components) in particle coordinates, stored as
+    /// one (3 x 3 x 3) block per particle pair
+    BlockSparseGradient m_grad_M_added;
 
     /// (7N x 7N x 7M) gradient of total mass matrix (only added mass components) in body coordinates
     Eigen::Tensor<double, 3> m_grad_M_added_body_coords;
@@ -242,9 +544,116 @@ class PotentialHydrodynamics
     /// (7M x 7N) `Eigen::Matrix` form of `m_M2`
     Eigen::MatrixXd m_mat_M2;
 
-    // ANCHOR: N sub-terms
-    Eigen::Tensor<double, 3> m_N2_term1_preshuffle;
-    Eigen::Tensor<double, 3> m_N3_terms12_preshuffle;
+    /// Minimum number of tensor slices evaluated per thread-pool task in `calcBodyMassGrad()`
+    const int m_min_slices_per_chunk{4};
+    /// Minimum number of particle column blocks of `m_mat_M2` evaluated per thread-pool task in `calcBodyMassDynamic()`
+    const int m_min_particles_per_chunk{16};
+
+    // ANCHOR: preallocated kinematic tensors of `calcHydroForces()`
+    /// (7N x 7N) @f$ \boldsymbol{V} \boldsymbol{V}^{\mathrm{T}} @f$
+    Eigen::MatrixXd m_hf_V_V;
+    /// (7M x 7M) @f$ \dot{\boldsymbol{\xi}} \dot{\boldsymbol{\xi}}^{\mathrm{T}} @f$
+    Eigen::MatrixXd m_hf_xi_dot_xi_dot;
+    /// (7M x 7N) @f$ \dot{\boldsymbol{\xi}} \boldsymbol{V}^{\mathrm{T}} @f$
+    Eigen::MatrixXd m_hf_xi_dot_V;
+    /// (7N x 7M) @f$ \boldsymbol{V} \dot{\boldsymbol{\xi}}^{\mathrm{T}} @f$
+    Eigen::MatrixXd m_hf_V_xi_dot;
+    /// (7M x 1) locater inertia force @f$ -\boldsymbol{M}_3 \ddot{\boldsymbol{\xi}} @f$
+    Eigen::VectorXd m_hf_inertia_loc;
+
+    // ANCHOR: preallocated vectors of `calcHydroEnergy()`
+    /// (7N x 1) copies of the articulation and total particle velocities
+    Eigen::VectorXd m_en_V;
+    Eigen::VectorXd m_en_vel;
+    /// (7N x 1) particle velocities from body motion (mirror and treecode modes)
+    Eigen::VectorXd m_en_u;
+    /// (7N x 1) total mass products with `m_en_V` and `m_en_u`, added mass product with `m_en_vel`
+    Eigen::VectorXd m_en_M_V;
+    Eigen::VectorXd m_en_M_u;
+    Eigen::VectorXd m_en_M_vel;
+    /// (7M x 1) body mass products @f$ \boldsymbol{M}_3 \dot{\boldsymbol{\xi}} @f$ and
+    /// @f$ \boldsymbol{M}_2 \boldsymbol{V} @f$
+    Eigen::VectorXd m_en_M3_xi_dot;
+    Eigen::VectorXd m_en_M2_V;
+
+    // ANCHOR: matrix-free hydrodynamic force variables
+    /// If forces are evaluated with `calcHydroForcesMatrixFree()`. Set from `SystemData` during construction
+    bool m_matrix_free{false};
+    /// (7N x 1) total particle velocities @f$ \boldsymbol{\Sigma}^{\mathrm{T}} \dot{\boldsymbol{\xi}} +
+    /// \boldsymbol{V} @f$
+    Eigen::VectorXd m_mf_vel;
+    /// (7N x 1) particle accelerations without locater inertia @f$ \dot{\boldsymbol{\Sigma}}^{\mathrm{T}}
+    /// \dot{\boldsymbol{\xi}} + \dot{\boldsymbol{V}} @f$
+    Eigen::VectorXd m_mf_acc;
+    /// (7N x 1) particle accelerations from locater inertia @f$ \boldsymbol{\Sigma}^{\mathrm{T}}
+    /// \ddot{\boldsymbol{\xi}} @f$
+    Eigen::VectorXd m_mf_acc_loc;
+    /// (3N x 1) linear particle velocities from body motion @f$ \boldsymbol{\chi}^{\mathrm{T}}
+    /// \dot{\boldsymbol{\xi}} @f$
+    Eigen::VectorXd m_mf_x_dot;
+    /// (7N x 1) @f$ \boldsymbol{M} \boldsymbol{w} @f$
+    Eigen::VectorXd m_mf_M_vel;
+    /// (7N x 1) @f$ \boldsymbol{M} \boldsymbol{a} @f$ (without locater inertia)
+    Eigen::VectorXd m_mf_M_acc;
+    /// (7N x 1) @f$ \boldsymbol{M} \boldsymbol{\Sigma}^{\mathrm{T}} \ddot{\boldsymbol{\xi}} @f$
+    Eigen::VectorXd m_mf_M_acc_loc;
+    /// (7N x 1) @f$ \dot{\boldsymbol{M}} \boldsymbol{w} @f$
+    Eigen::VectorXd m_mf_M_dot_vel;
+    /// (3N x 1) @f$ \boldsymbol{w} \cdot \nabla_{x} \boldsymbol{M} \cdot \boldsymbol{w} @f$
+    Eigen::VectorXd m_mf_grad_M_vel_vel;
+    /// (7N x chunks) per-chunk partial sums of `m_mf_M_dot_vel`
+    Eigen::MatrixXd m_mf_M_dot_vel_partial;
+    /// (3N x chunks) per-chunk partial sums of `m_mf_grad_M_vel_vel`
+    Eigen::MatrixXd m_mf_grad_M_vel_vel_partial;
+
+    // ANCHOR: treecode added mass matrix-vector products
+    /// If added mass products in matrix-free mode are evaluated with `m_treecode`. Set from `SystemData` during
+    /// construction
+    bool m_use_treecode{false};
+    /// Treecode for products with the pairwise dipole kernel of the added mass matrix
+    DipoleTreecode m_treecode;
+    /// (7N x 1) diagonal of intrinsic mass and moment of inertia matrices
+    Eigen::VectorXd m_M_intrinsic_diag;
+    /// (3N x 1) linear components of treecode source vector
+    Eigen::VectorXd m_tc_vel;
+    /// (3N x 1) treecode product
+    Eigen::VectorXd m_tc_M_vel;
+    /// (7N x 1) column of @f$ \boldsymbol{\Sigma}^{\mathrm{T}} @f$ in `calcBodyMassTreecode()`
+    Eigen::VectorXd m_tc_sigma_col;
+    /// (7N x 1) total mass product of `m_tc_sigma_col`
+    Eigen::VectorXd m_tc_M_sigma_col;
+    /// near-field pairs of `m_treecode`, first particle
+    Eigen::VectorXi m_tc_alpha_vec;
+    /// near-field pairs of `m_treecode`, second particle
+    Eigen::VectorXi m_tc_beta_vec;
+    /// distance added to node radii when collecting near-field pairs (one particle diameter)
+    const double m_treecode_padding{2.0};
+
+    // ANCHOR: update dependency graph
+    /// Stages of `update()`, in evaluation order
+    enum UpdateStage : int
+    {
+        StageDistances     = 0, ///< neighbor list, particle distances and treecode
+        StageAddedMass     = 1, ///< added mass matrix
+        StageAddedMassGrad = 2, ///< added mass gradient
+        StageTotalMass     = 3, ///< total mass matrix
+        StageBodyMass      = 4, ///< body mass matrix
+        StageBodyMassGrad  = 5, ///< body mass gradient
+        StageForces        = 6, ///< hydrodynamic forces
+        StageEnergy        = 7, ///< hydrodynamic energies
+    };
+
+    /// dependency graph of the stages of `update()`, input versions from `SystemData::updatedVersions()`
+    UpdateGraph m_update_graph{{
+        {UpdateGraph::Time | UpdateGraph::Positions, {}},                            // StageDistances
+        {0, {StageDistances}},                                                       // StageAddedMass
+        {0, {StageDistances}},                                                       // StageAddedMassGrad
+        {0, {StageAddedMass}},                                                       // StageTotalMass
+        {UpdateGraph::Time | UpdateGraph::Positions, {StageTotalMass}},              // StageBodyMass
+        {0, {StageBodyMass, StageAddedMassGrad}},                                    // StageBodyMassGrad
+        {UpdateGraph::Velocities | UpdateGraph::Accelerations, {StageBodyMassGrad}}, // StageForces
+        {UpdateGraph::Velocities, {StageBodyMass}},                                  // StageEnergy
+    }};
 
     // ANCHOR: constants
     /// volume of a unit sphere
@@ -260,6 +669,14 @@ class PotentialHydrodynamics
     const double m_c3_2{1.50};
     /// = 15/2
     const double m_c15_2{7.50};
+    /// diagonal of reflection about the xy-plane
+    const Eigen::Vector3d m_reflect{1.0, 1.0, -1.0};
+    /// column of element (i, j) of a symmetric (3 x 3) block in its unique elements
+    static constexpr int m_sym_ij[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+    /// column of element (i, j, k) of a fully symmetric (3 x 3 x 3) block in its unique elements
+    static constexpr int m_sym_ijk[3][3][3] = {{{0, 1, 2}, {1, 3, 4}, {2, 4, 5}},
+                                              {{1, 3, 4}, {3, 6, 7}, {4, 7, 8}},
+                                              {{2, 4, 5}, {4, 7, 8}, {5, 8, 9}}};
 
   public:
     const Eigen::VectorXd&
@@ -286,7 +703,7 @@ class PotentialHydrodynamics
         return m_mat_M3;
     }
 
-    const Eigen::Tensor<double, 3>&
+    const BlockSparseGradient&
     gradMAdded() const
     {
         return m_grad_M_added;
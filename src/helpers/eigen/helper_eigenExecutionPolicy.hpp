@@ -0,0 +1,147 @@
+//
+// Created by Alec Glisman on 11/08/21
+//
+
+#ifndef HELPER_EIGEN_EXECUTION_POLICY_H
+#define HELPER_EIGEN_EXECUTION_POLICY_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// STL
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <chrono>    // std::chrono
+#include <limits>    // std::numeric_limits
+
+/**
+ * @brief Minimum work of a tensor expression, in scalar operations, to be evaluated on a thread-pool
+ *
+ * @details Smaller expressions are evaluated inline on the calling thread, as dispatching them to the thread-pool
+ * costs more than the expression itself. The default can be replaced with `calibrateExecutionPolicy()` at startup.
+ *
+ * @return std::atomic<long>& threshold shared by all thread-pool devices
+ */
+inline std::atomic<long>&
+minParallelTensorWork()
+{
+    static std::atomic<long> min_work{32768};
+    return min_work;
+}
+
+/**
+ * @brief Checks if a tensor expression should be evaluated on the thread-pool of `device`
+ *
+ * @details Returns false when called from inside one of the thread-pool worker threads (see `numParallelChunks()`).
+ *
+ * @param device thread-pool device expression would be evaluated on
+ * @param work number of scalar operations of the expression, e.g. the number of coefficients of an assignment or
+ * @f$ m \, n \, k @f$ for a contraction of @f$ (m \times k) @f$ and @f$ (k \times n) @f$ operands
+ * @return true if the expression should be evaluated on the thread-pool
+ */
+inline bool
+useThreadPool(const Eigen::ThreadPoolDevice& device, const long work)
+{
+    return (device.numThreads() > 1) && (device.currentThreadId() == -1) &&
+           (work >= minParallelTensorWork().load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Evaluates the tensor expression `lhs = expr` on the thread-pool of `device` or inline on the calling thread,
+ * depending on its work (see `useThreadPool()`)
+ *
+ * @tparam Lhs writable tensor (or tensor operation, e.g. a slice) type
+ * @tparam Expr tensor expression type
+ * @param device thread-pool device expression may be evaluated on
+ * @param work number of scalar operations of the expression
+ * @param lhs tensor to write to
+ * @param expr tensor expression to evaluate
+ */
+template <typename Lhs, typename Expr>
+void
+evaluateTensor(const Eigen::ThreadPoolDevice& device, const long work, Lhs&& lhs, const Expr& expr)
+{
+    if (useThreadPool(device, work))
+    {
+        lhs.device(device) = expr;
+    }
+    else
+    {
+        lhs = expr;
+    }
+}
+
+/**
+ * @brief Sets `minParallelTensorWork()` to the smallest (n x n) by (n x n) tensor contraction that is faster on the
+ * thread-pool of `device` than inline
+ *
+ * @details Each size is timed as the best of a few repetitions. If no size is faster on the thread-pool, tensor
+ * expressions are always evaluated inline. Must not be called concurrently with tensor evaluations.
+ *
+ * @param device thread-pool device to calibrate for
+ * @return long calibrated threshold
+ */
+inline long
+calibrateExecutionPolicy(const Eigen::ThreadPoolDevice& device)
+{
+    if (device.numThreads() <= 1)
+    {
+        return minParallelTensorWork().load();
+    }
+
+    const int                                      sizes[7] = {8, 16, 24, 32, 48, 64, 96};
+    const int                                      num_repeats{5};
+    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_lj = {Eigen::IndexPair<int>(1, 0)}; // = A B
+
+    long min_work{std::numeric_limits<long>::max()};
+
+    for (const int n : sizes)
+    {
+        Eigen::Tensor<double, 2> a(n, n);
+        Eigen::Tensor<double, 2> b(n, n);
+        Eigen::Tensor<double, 2> c(n, n);
+        a.setRandom();
+        b.setRandom();
+
+        double time_inline{std::numeric_limits<double>::max()};
+        double time_pool{std::numeric_limits<double>::max()};
+
+        for (int repeat = 0; repeat < num_repeats; repeat++)
+        {
+            const auto start_inline = std::chrono::steady_clock::now();
+            c                       = a.contract(b, contract_il_lj);
+            const auto start_pool   = std::chrono::steady_clock::now();
+            c.device(device)        = a.contract(b, contract_il_lj);
+            const auto end_pool     = std::chrono::steady_clock::now();
+
+            time_inline = std::min(time_inline, std::chrono::duration<double>(start_pool - start_inline).count());
+            time_pool   = std::min(time_pool, std::chrono::duration<double>(end_pool - start_pool).count());
+        }
+
+        if (time_pool < time_inline)
+        {
+            min_work = static_cast<long>(n) * n * n;
+            break;
+        }
+    }
+
+    minParallelTensorWork().store(min_work);
+
+    return min_work;
+}
+
+#endif
@@ -0,0 +1,152 @@
+//
+// Created by Alec Glisman on 11/04/21
+//
+
+#ifndef HELPER_EIGEN_PARALLEL_FOR_H
+#define HELPER_EIGEN_PARALLEL_FOR_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// STL
+#include <algorithm> // std::min, std::max
+
+/**
+ * @brief Number of chunks to split `num_items` loop iterations into on the thread-pool of `device`
+ *
+ * @details Chunks contain at least `min_chunk_size` iterations, so small loops (e.g. a single swimmer) are evaluated
+ * on the calling thread without any thread-pool dispatch.
+ * Returns 1 when called from inside one of the thread-pool worker threads to prevent nested parallel loops from
+ * blocking the thread-pool.
+ *
+ * @param device thread-pool device loop will be evaluated on
+ * @param num_items number of loop iterations
+ * @param min_chunk_size minimum number of loop iterations per chunk
+ * @return int number of chunks, in [1, `device.numThreads()`]
+ */
+inline int
+numParallelChunks(const Eigen::ThreadPoolDevice& device, const int num_items, const int min_chunk_size)
+{
+    if (device.currentThreadId() != -1)
+    {
+        return 1;
+    }
+
+    const int max_chunks{num_items / std::max(1, min_chunk_size)};
+
+    return std::max(1, std::min(device.numThreads(), max_chunks));
+}
+
+/**
+ * @brief Evaluates the loop iterations [0, `num_items`) in `num_chunks` contiguous chunks on the thread-pool of
+ * `device` and blocks until all chunks are complete
+ *
+ * @details `func(chunk_id, begin, end)` is called once per chunk with iterations [`begin`, `end`).
+ * Chunk 0 is evaluated on the calling thread.
+ * `chunk_id` can be used to index per-chunk partial results when iterations do not write to disjoint memory.
+ *
+ * @tparam Function callable with signature `void(int chunk_id, int begin, int end)`
+ * @param device thread-pool device loop will be evaluated on
+ * @param num_chunks number of chunks (see `numParallelChunks()`)
+ * @param num_items number of loop iterations
+ * @param func loop body
+ */
+template <typename Function>
+void
+parallelForChunks(const Eigen::ThreadPoolDevice& device, const int num_chunks, const int num_items, Function&& func)
+{
+    if (num_chunks <= 1)
+    {
+        func(0, 0, num_items);
+        return;
+    }
+
+    Eigen::Barrier barrier(static_cast<unsigned int>(num_chunks - 1));
+
+    /* NOTE: tasks only capture a reference to the loop context and the chunk index, which fits in the local buffer of
+     * `std::function`, so dispatching chunks does not allocate */
+    struct ChunkContext
+    {
+        Function&       func;
+        Eigen::Barrier& barrier;
+        const int       num_chunks;
+        const int       num_items;
+    };
+    const ChunkContext context{func, barrier, num_chunks, num_items};
+
+    for (int chunk_id = 1; chunk_id < num_chunks; chunk_id++)
+    {
+        device.enqueueNoNotification([&context, chunk_id]() {
+            const long num_items_l{context.num_items};
+            const int  begin{static_cast<int>((chunk_id * num_items_l) / context.num_chunks)};
+            const int  end{static_cast<int>(((chunk_id + 1) * num_items_l) / context.num_chunks)};
+
+            context.func(chunk_id, begin, end);
+            context.barrier.Notify();
+        });
+    }
+
+    func(0, 0, static_cast<int>(num_items / num_chunks));
+
+    barrier.Wait();
+}
+
+/**
+ * @brief Evaluates independent tasks concurrently on the thread-pool of `device` and blocks until all tasks are
+ * complete
+ *
+ * @details The first task is evaluated on the calling thread and the others are enqueued on the thread-pool, so
+ * loops of the first task can still be split with `parallelForChunks()`, while loops of the enqueued tasks run on
+ * their worker thread (see `numParallelChunks()`).
+ * Tasks are evaluated in order on the calling thread if it is a thread-pool worker (nested task groups) or if the
+ * thread-pool does not have more threads than tasks, so that enqueued tasks can never occupy all worker threads.
+ * Tasks must not write to memory read or written by another task.
+ *
+ * @tparam First callable with signature `void()`
+ * @tparam Rest callables with signature `void()`
+ * @param device thread-pool device tasks will be evaluated on
+ * @param first task evaluated on the calling thread
+ * @param rest tasks enqueued on the thread-pool
+ */
+template <typename First, typename... Rest>
+void
+parallelInvoke(const Eigen::ThreadPoolDevice& device, First&& first, Rest&&... rest)
+{
+    constexpr int num_enqueued{static_cast<int>(sizeof...(Rest))};
+
+    if ((num_enqueued == 0) || (device.currentThreadId() != -1) || (device.numThreads() <= num_enqueued))
+    {
+        first();
+        (rest(), ...);
+        return;
+    }
+
+    Eigen::Barrier barrier(static_cast<unsigned int>(num_enqueued));
+
+    // NOTE: tasks only capture two references, which fit in the local buffer of `std::function` (no allocation)
+    (device.enqueueNoNotification([&rest, &barrier]() {
+        rest();
+        barrier.Notify();
+    }),
+     ...);
+
+    first();
+
+    barrier.Wait();
+}
+
+#endif
@@ -0,0 +1,278 @@
+//
+// Created by Alec Glisman on 10/18/21
+//
+
+#include <Parareal.hpp>
+
+Parareal::Parareal(std::shared_ptr<SystemData> sys)
+{
+    // save classes
+    m_system = sys;
+
+    // initialize logger
+    m_logFile   = m_system->outputDir() + "/logs/" + m_logName + "-log.txt";
+    auto logger = spdlog::basic_logger_mt(m_logName, m_logFile);
+    spdlog::get(m_logName)->info("Initializing parareal integrator");
+
+    m_num_slices = m_system->pararealSlices();
+    spdlog::get(m_logName)->info("Number of time slices: {0}", m_num_slices);
+
+    if (m_num_slices < 1)
+    {
+        spdlog::get(m_logName)->error("Number of time slices must be positive: {0}", m_num_slices);
+        throw std::invalid_argument("Number of parareal time slices must be positive");
+    }
+
+    // NOTE: same number of time steps as `Engine::run()`
+    const int num_steps{static_cast<int>(std::ceil((m_system->tf() - m_system->t()) / m_system->dt()))};
+    m_slice_steps = num_steps / m_num_slices;
+    spdlog::get(m_logName)->info("Fine time steps: {0}, per slice: {1}", num_steps, m_slice_steps);
+
+    if ((m_slice_steps < 1) || (m_slice_steps * m_num_slices != num_steps))
+    {
+        spdlog::get(m_logName)->error("{0} time steps cannot be split into {1} slices", num_steps, m_num_slices);
+        throw std::invalid_argument("Number of time steps must be a multiple of the number of parareal slices");
+    }
+
+    const int coarse_ratio{m_system->pararealCoarseRatio()};
+    m_coarse_steps = (coarse_ratio > 0) ? m_slice_steps / coarse_ratio : 0;
+    spdlog::get(m_logName)->info("Coarse time step ratio: {0}, coarse steps per slice: {1}", coarse_ratio,
+                                 m_coarse_steps);
+
+    if ((m_coarse_steps < 1) || (m_coarse_steps * coarse_ratio != m_slice_steps))
+    {
+        spdlog::get(m_logName)->error("Coarse time step ratio {0} does not divide {1} time steps per slice",
+                                      coarse_ratio, m_slice_steps);
+        throw std::invalid_argument("Coarse time step ratio must divide the number of time steps per slice");
+    }
+
+    /* ANCHOR: worker copies */
+    spdlog::get(m_logName)->info("Initializing coarse propagator");
+    m_coarse_system = std::make_shared<SystemData>(*m_system, "-parareal-coarse");
+    m_coarse_system->setDt(coarse_ratio * m_system->dt());
+    m_coarse_hydro = std::make_shared<PotentialHydrodynamics>(m_coarse_system);
+    m_coarse_rk4   = std::make_shared<RungeKutta4>(m_coarse_system, m_coarse_hydro);
+
+    spdlog::get(m_logName)->info("Initializing fine propagators");
+    for (int k = 0; k < m_num_slices; k++)
+    {
+        auto fine_system = std::make_shared<SystemData>(*m_system, "-parareal-" + std::to_string(k));
+        auto fine_hydro  = std::make_shared<PotentialHydrodynamics>(fine_system);
+        auto fine_rk4    = std::make_shared<RungeKutta4>(fine_system, fine_hydro);
+
+        m_fine_systems.push_back(fine_system);
+        m_fine_hydros.push_back(fine_hydro);
+        m_fine_rk4s.push_back(fine_rk4);
+    }
+
+    spdlog::get(m_logName)->info("Constructor complete");
+    spdlog::get(m_logName)->flush();
+}
+
+Parareal::~Parareal()
+{
+    spdlog::get(m_logName)->info("Destructing parareal integrator");
+    spdlog::get(m_logName)->flush();
+    spdlog::drop(m_logName);
+}
+
+bool
+Parareal::run(const Eigen::ThreadPoolDevice& device, const int write_step)
+{
+    spdlog::get(m_logName)->info("Starting parareal run at t = {0}", m_system->t());
+    spdlog::get(m_logName)->info("Slices distributed over {0} threads", device.numThreads());
+
+    const int n14{2 * 7 * m_system->numBodies()};
+    m_t0 = m_system->t();
+
+    m_slice_states = Eigen::MatrixXd::Zero(n14, m_num_slices + 1);
+    m_slice_states.col(0) << m_system->positionsBodies(), m_system->velocitiesBodies();
+
+    /* ANCHOR: output time steps, same as `Engine::run()` */
+    m_first_step = m_system->timestep();
+    m_write_step = write_step;
+    const int num_steps{m_num_slices * m_slice_steps};
+
+    m_frame_steps.clear();
+    m_slice_frame_steps.assign(m_num_slices, std::vector<int>());
+    m_slice_frame_begin.assign(m_num_slices, 0);
+
+    for (int k = 0; k < m_num_slices; k++)
+    {
+        m_slice_frame_begin[k] = static_cast<int>(m_frame_steps.size());
+
+        for (int slice_step = 1; slice_step <= m_slice_steps; slice_step++)
+        {
+            const int step{k * m_slice_steps + slice_step};
+
+            if (((m_first_step + step) % write_step == 0) || (step == num_steps))
+            {
+                m_frame_steps.push_back(step);
+
+                // NOTE: slice ends are taken from the corrected slice states
+                if (slice_step < m_slice_steps)
+                {
+                    m_slice_frame_steps[k].push_back(slice_step);
+                }
+            }
+        }
+    }
+
+    m_frame_states = Eigen::MatrixXd::Zero(n14, static_cast<int>(m_frame_steps.size()));
+    spdlog::get(m_logName)->info("Output frames: {0}", m_frame_steps.size());
+
+    // coarse and fine propagation of each slice from the slice states of the current iteration
+    Eigen::MatrixXd coarse = Eigen::MatrixXd::Zero(n14, m_num_slices);
+    Eigen::MatrixXd fine   = Eigen::MatrixXd::Zero(n14, m_num_slices);
+
+    // NOTE: slices run on the threads of `device`, so their tensor computations must not dispatch to its thread-pool
+    Eigen::ThreadPoolDevice fine_device(device.getPool(), 1);
+
+    const std::vector<int> no_records;
+
+    /* ANCHOR: initial coarse prediction */
+    Eigen::VectorXd state = Eigen::VectorXd::Zero(n14);
+    for (int k = 0; k < m_num_slices; k++)
+    {
+        state.noalias() = m_slice_states.col(k);
+        propagate(m_coarse_system, m_coarse_rk4, k * m_slice_steps, m_coarse_steps, state, device, no_records,
+                  m_frame_states.leftCols(0));
+
+        coarse.col(k)             = state;
+        m_slice_states.col(k + 1) = state;
+    }
+
+    /* ANCHOR: parareal iterations */
+    bool converged{false};
+    m_num_iterations = 0;
+
+    // NOTE: slices [0, j] start from the exact state in iteration j
+    for (int j = 0; (j < m_num_slices) && !converged; j++)
+    {
+        m_num_iterations++;
+
+        // fine propagation of the remaining slices, concurrently
+        const int                       num_active{m_num_slices - j};
+        std::vector<std::exception_ptr> errors(num_active);
+
+        parallelForChunks(device, numParallelChunks(device, num_active, 1), num_active,
+                          [&](const int chunk_id, const int begin, const int end) {
+                              for (int i = begin; i < end; i++)
+                              {
+                                  const int k{j + i};
+
+                                  // NOTE: exceptions must not escape thread-pool tasks
+                                  try
+                                  {
+                                      Eigen::VectorXd fine_state = m_slice_states.col(k);
+
+                                      // NOTE: each slice records into its own columns of `m_frame_states`
+                                      propagate(m_fine_systems[k], m_fine_rk4s[k], k * m_slice_steps,
+                                                m_slice_steps, fine_state, fine_device, m_slice_frame_steps[k],
+                                                m_frame_states.middleCols(m_slice_frame_begin[k],
+                                                                          m_slice_frame_steps[k].size()));
+                                      fine.col(k) = fine_state;
+                                  }
+                                  catch (...)
+                                  {
+                                      errors[i] = std::current_exception();
+                                  }
+                              }
+                          });
+
+        for (const auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // sequential coarse correction
+        double max_change{0.0};
+        for (int k = j; k < m_num_slices; k++)
+        {
+            // NOTE: start of slice j did not change, so neither did its coarse propagation
+            if (k > j)
+            {
+                state.noalias() = m_slice_states.col(k);
+                propagate(m_coarse_system, m_coarse_rk4, k * m_slice_steps, m_coarse_steps, state, device,
+                          no_records, m_frame_states.leftCols(0));
+            }
+            else
+            {
+                state.noalias() = coarse.col(k);
+            }
+
+            Eigen::VectorXd corrected = state + fine.col(k) - coarse.col(k);
+            coarse.col(k)             = state;
+
+            const double change{(corrected - m_slice_states.col(k + 1)).lpNorm<Eigen::Infinity>() /
+                                (1.0 + corrected.lpNorm<Eigen::Infinity>())};
+            max_change = std::max(max_change, change);
+
+            m_slice_states.col(k + 1) = corrected;
+        }
+
+        converged = (max_change <= m_system->pararealTol());
+        spdlog::get(m_logName)->info("Parareal iteration {0}: maximum relative change of slice states {1}",
+                                     m_num_iterations, max_change);
+    }
+
+    if (!converged)
+    {
+        spdlog::get(m_logName)->warn("Parareal did not converge in {0} iterations, slice states are exact",
+                                     m_num_iterations);
+    }
+
+    /* ANCHOR: output frames at slice ends */
+    for (std::size_t frame = 0; frame < m_frame_steps.size(); frame++)
+    {
+        if (m_frame_steps[frame] % m_slice_steps == 0)
+        {
+            m_frame_states.col(frame) = m_slice_states.col(m_frame_steps[frame] / m_slice_steps);
+        }
+    }
+
+    spdlog::get(m_logName)->flush();
+    return converged;
+}
+
+void
+Parareal::propagate(std::shared_ptr<SystemData> sys, std::shared_ptr<RungeKutta4> rk4, const int start_step,
+                    const int num_steps, Eigen::VectorXd& state, const Eigen::ThreadPoolDevice& device,
+                    const std::vector<int>& record_steps, Eigen::Ref<Eigen::MatrixXd> records) const
+{
+    const int n7{static_cast<int>(state.size()) / 2};
+    const int step_ratio{m_slice_steps / num_steps}; // fine time steps per time step of `sys`
+    const int last_step{m_num_slices * m_slice_steps};
+
+    sys->setT(m_t0 + start_step * m_system->dt());
+    sys->setPositionsBodies(state.head(n7));
+    sys->setVelocitiesBodies(state.tail(n7));
+
+    // NOTE: the first step re-evaluates its initial acceleration, see `RungeKutta4::fsalValid()`
+    std::size_t record{0};
+    for (int step = 1; step <= num_steps; step++)
+    {
+        rk4->integrate(device);
+        sys->setT(sys->t() + sys->dt());
+
+        // NOTE: same output time steps as `Engine::run()`, which normalizes quaternions before writing a frame
+        const int prev_fine_step{m_first_step + start_step + (step - 1) * step_ratio};
+        const int fine_step{m_first_step + start_step + step * step_ratio};
+        if ((fine_step / m_write_step > prev_fine_step / m_write_step) ||
+            (fine_step == m_first_step + last_step))
+        {
+            sys->normalizeQuaternions();
+        }
+
+        if ((record < record_steps.size()) && (record_steps[record] == step))
+        {
+            records.col(record) << sys->positionsBodies(), sys->velocitiesBodies();
+            record++;
+        }
+    }
+
+    state << sys->positionsBodies(), sys->velocitiesBodies();
+}
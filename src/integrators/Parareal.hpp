@@ -0,0 +1,211 @@
+//
+// Created by Alec Glisman on 10/18/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_PARAREAL_H
+#define BODIES_IN_POTENTIAL_FLOW_PARAREAL_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all internal project dependencies */
+#include <PotentialHydrodynamics.hpp>
+#include <RungeKutta4.hpp>
+#include <SystemData.hpp>
+
+/* Include all external project dependencies */
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// eigen3 thread-pool parallel loops
+#include <helper_eigenParallelFor.hpp>
+// Logging
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+// STL
+#include <algorithm> // std::min, std::max
+#include <cmath>     // std::ceil
+#include <memory>    // for std::unique_ptr and std::shared_ptr
+#include <stdexcept> // std::errors
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+/* Forward declarations */
+class SystemData;
+
+/**
+ * @class Parareal
+ *
+ * @brief Parallel-in-time integration of the body dynamics from `SystemData::t()` to `SystemData::tf()`.
+ *
+ * @details The time interval is split into @f$ K @f$ = `SystemData::pararealSlices()` slices of equal numbers of time
+ * steps. A coarse propagator @f$ \mathcal{G} @f$ (`RungeKutta4` with time step `SystemData::pararealCoarseRatio()`
+ * times `SystemData::dt()`) predicts the body state at the start of each slice, and the fine propagator
+ * @f$ \mathcal{F} @f$ (`RungeKutta4` with time step `SystemData::dt()`) integrates all slices concurrently from those
+ * predictions. The predictions are corrected sequentially,
+ * @f$ \boldsymbol{U}^{j+1}_{k+1} = \mathcal{G}(\boldsymbol{U}^{j+1}_k) + \mathcal{F}(\boldsymbol{U}^{j}_k) -
+ * \mathcal{G}(\boldsymbol{U}^{j}_k) @f$,
+ * until the largest change of a slice state, relative to @f$ 1 + |\boldsymbol{U}| @f$ (maximum norm), is at most
+ * `SystemData::pararealTol()`. After @f$ j @f$ iterations the first @f$ j @f$ slices are exact, so at most @f$ K @f$
+ * iterations are needed, and only unconverged slices are integrated by the fine propagator.
+ *
+ * Each slice and the coarse propagator integrate a worker copy of `SystemData` (see
+ * `SystemData::SystemData(const SystemData&, const std::string&)`) with its own `PotentialHydrodynamics` and
+ * `RungeKutta4`. Slices are distributed over the threads of the device passed to `run()` (the thread-pool of
+ * `Engine`), and the tensor computations of each slice run on the thread of its slice.
+ *
+ * The fine propagators also record the body state at each output time step inside their slice, so a run can be
+ * written with the same frames as a serial run (see `frameSteps()`).
+ *
+ * @see **Reference:** Lions, Jacques-Louis, Yvon Maday, and Gabriel Turinici. "Résolution d'EDP par un schéma en
+ * temps pararéel." Comptes Rendus de l'Académie des Sciences-Series I-Mathematics 332.7 (2001): 661-668.
+ *
+ */
+class Parareal
+{
+  public:
+    /**
+     * @brief Construct a new parareal object
+     *
+     * @param sys SystemData class to integrate. Must be fully initialized, worker copies are made of its current data.
+     */
+    explicit Parareal(std::shared_ptr<SystemData> sys);
+
+    /**
+     * @brief Destroy the parareal object
+     *
+     */
+    ~Parareal();
+
+    /**
+     * @brief Parareal iterations from the current body state of `SystemData` to the final time.
+     *
+     * @details `SystemData` itself is not modified; the state at the start of each slice and at the final time is
+     * available from `sliceStates()` afterwards, and the state at each output time step from `frameStates()`.
+     * Output time steps are those at which `SystemData::timestep()` is a multiple of `write_step`, as in
+     * `Engine::run()`, and the final time step. States inside a slice come from its last fine propagation, so they
+     * converged along with the slice states.
+     *
+     * @param device device the slices are distributed over. The coarse propagator uses all of its threads.
+     * @param write_step number of time steps between output frames
+     * @return true slice states converged to `SystemData::pararealTol()`
+     * @return false maximum number of iterations reached (slice states are then exact up to time integration error)
+     */
+    bool
+    run(const Eigen::ThreadPoolDevice& device, const int write_step);
+
+  private:
+    /**
+     * @brief Integrates a body state `num_steps` time steps with a worker copy
+     *
+     * @details Quaternions are normalized after each time step that reaches or passes an output time step of the run,
+     * as `Engine::run()` does, so converged states match a serial run.
+     *
+     * @param sys worker copy of `SystemData`
+     * @param rk4 integrator of `sys`
+     * @param start_step initial (fine) time step, counted from the first time step of the run
+     * @param num_steps number of time steps of `sys`
+     * @param state (input/output) (14M x 1) body positions and velocities
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     * @param record_steps (ascending) time steps, counted from 1, after which to record the body state
+     * @param records (output) (14M x `record_steps.size()`) recorded body states
+     */
+    void
+    propagate(std::shared_ptr<SystemData> sys, std::shared_ptr<RungeKutta4> rk4, const int start_step,
+              const int num_steps, Eigen::VectorXd& state, const Eigen::ThreadPoolDevice& device,
+              const std::vector<int>& record_steps, Eigen::Ref<Eigen::MatrixXd> records) const;
+
+    // classes
+    std::shared_ptr<SystemData> m_system;
+
+    // logging
+    std::string       m_logFile;
+    const std::string m_logName{"Parareal"};
+
+    /// = K. Number of time slices
+    int m_num_slices{-1};
+    /// Number of fine time steps per slice
+    int m_slice_steps{-1};
+    /// Number of coarse time steps per slice
+    int m_coarse_steps{-1};
+    /// Time of the first slice start
+    double m_t0{0.0};
+    /// `SystemData::timestep()` at the first slice start
+    int m_first_step{0};
+    /// Number of time steps between output frames of the last run
+    int m_write_step{1};
+
+    // worker copies of the simulation framework
+    std::shared_ptr<SystemData>             m_coarse_system;
+    std::shared_ptr<PotentialHydrodynamics> m_coarse_hydro;
+    std::shared_ptr<RungeKutta4>            m_coarse_rk4;
+
+    std::vector<std::shared_ptr<SystemData>>             m_fine_systems;
+    std::vector<std::shared_ptr<PotentialHydrodynamics>> m_fine_hydros;
+    std::vector<std::shared_ptr<RungeKutta4>>            m_fine_rk4s;
+
+    /// (14M x (K + 1)) body positions and velocities at the start of each slice and at the final time
+    Eigen::MatrixXd m_slice_states;
+
+    /// Output time steps of the last run, counted from its first time step
+    std::vector<int> m_frame_steps;
+    /// (14M x `m_frame_steps.size()`) body positions and velocities at the output time steps
+    Eigen::MatrixXd m_frame_states;
+    /// Output time steps inside each slice, counted from the slice start
+    std::vector<std::vector<int>> m_slice_frame_steps;
+    /// Index of the first output time step inside each slice in `m_frame_steps`
+    std::vector<int> m_slice_frame_begin;
+
+    /// Number of parareal iterations of the last run
+    int m_num_iterations{0};
+
+  public:
+    const Eigen::MatrixXd&
+    sliceStates() const
+    {
+        return m_slice_states;
+    }
+
+    const std::vector<int>&
+    frameSteps() const
+    {
+        return m_frame_steps;
+    }
+
+    const Eigen::MatrixXd&
+    frameStates() const
+    {
+        return m_frame_states;
+    }
+
+    int
+    numSlices() const
+    {
+        return m_num_slices;
+    }
+
+    int
+    sliceSteps() const
+    {
+        return m_slice_steps;
+    }
+
+    int
+    numIterations() const
+    {
+        return m_num_iterations;
+    }
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_PARAREAL_H
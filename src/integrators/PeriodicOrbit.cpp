@@ -0,0 +1,342 @@
+//
+// Created by Alec Glisman on 10/17/21
+//
+
+#include <PeriodicOrbit.hpp>
+
+PeriodicOrbit::PeriodicOrbit(std::shared_ptr<SystemData> sys, std::shared_ptr<PotentialHydrodynamics> hydro,
+                             std::shared_ptr<RungeKutta4> rk4)
+{
+    // save classes
+    m_system   = sys;
+    m_potHydro = hydro;
+    m_rk4      = rk4;
+
+    // initialize logger
+    m_logFile   = m_system->outputDir() + "/logs/" + m_logName + "-log.txt";
+    auto logger = spdlog::basic_logger_mt(m_logName, m_logFile);
+    spdlog::get(m_logName)->info("Initializing periodic orbit solver");
+
+    m_tol = m_system->periodicOrbitTol();
+    spdlog::get(m_logName)->info("Newton residual tolerance: {0}", m_tol);
+
+    if (m_tol <= 0.0)
+    {
+        spdlog::get(m_logName)->error("Periodic orbit tolerance must be positive: {0}", m_tol);
+        throw std::invalid_argument("Periodic orbit tolerance must be positive");
+    }
+
+    m_period           = 2.0 * M_PI / (m_system->sysSpecOmega() * m_system->tau());
+    m_steps_per_period = static_cast<int>(std::round(m_period / m_system->dt()));
+    spdlog::get(m_logName)->info("Gait period: {0}, time steps per period: {1}", m_period, m_steps_per_period);
+
+    if ((m_steps_per_period < 1) || (std::abs(m_steps_per_period * m_system->dt() - m_period) > 1.0e-8 * m_period))
+    {
+        spdlog::get(m_logName)->error("Gait period {0} is not a multiple of dt {1}", m_period, m_system->dt());
+        throw std::invalid_argument("Periodic orbit requires an integer number of time steps per period");
+    }
+
+    // NOTE: image systems are only invariant to translations parallel to the wall (xy-plane)
+    m_num_invariant = m_system->imageSystem() ? 2 : 3;
+    spdlog::get(m_logName)->info("Translation invariant directions: {0}", m_num_invariant);
+
+    m_7M = 7 * m_system->numBodies();
+    int body_dof{m_system->numBodies()}; // = m
+    if (m_system->imageSystem())
+    {
+        body_dof /= 2;
+    }
+
+    // unknowns: linear positions (except the first body along invariant directions) and linear velocities
+    for (int body_id = 0; body_id < body_dof; body_id++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            if ((body_id > 0) || (i >= m_num_invariant))
+            {
+                m_unknown_index.push_back(7 * body_id + i);
+            }
+        }
+    }
+    for (int body_id = 0; body_id < body_dof; body_id++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            m_unknown_index.push_back(m_7M + 7 * body_id + i);
+        }
+    }
+    m_num_unknowns = static_cast<int>(m_unknown_index.size());
+    spdlog::get(m_logName)->info("Number of unknowns: {0}", m_num_unknowns);
+
+    m_displacement.setZero();
+}
+
+PeriodicOrbit::~PeriodicOrbit()
+{
+    spdlog::get(m_logName)->info("Destructing periodic orbit solver");
+    spdlog::get(m_logName)->flush();
+    spdlog::drop(m_logName);
+}
+
+bool
+PeriodicOrbit::solve(const Eigen::ThreadPoolDevice& device)
+{
+    spdlog::get(m_logName)->info("Starting periodic orbit solve at t = {0}", m_system->t());
+
+    m_t0     = m_system->t();
+    m_state0 = Eigen::VectorXd::Zero(2 * m_7M);
+    m_state0 << m_system->positionsBodies(), m_system->velocitiesBodies();
+    m_state = m_state0;
+
+    Eigen::VectorXd u = Eigen::VectorXd::Zero(m_num_unknowns);
+    for (int k = 0; k < m_num_unknowns; k++)
+    {
+        u(k) = m_state0(m_unknown_index[k]);
+    }
+
+    Eigen::VectorXd res = Eigen::VectorXd::Zero(m_num_unknowns);
+    residual(u, res, device);
+    double res_norm{res.norm()};
+    spdlog::get(m_logName)->info("Newton iteration 0: residual norm {0}", res_norm);
+
+    /* ANCHOR: Newton-Krylov iterations */
+    Eigen::VectorXd du        = Eigen::VectorXd::Zero(m_num_unknowns);
+    Eigen::VectorXd u_trial   = Eigen::VectorXd::Zero(m_num_unknowns);
+    Eigen::VectorXd res_trial = Eigen::VectorXd::Zero(m_num_unknowns);
+
+    m_num_newton_iterations = 0;
+    while ((res_norm > m_tol) && (m_num_newton_iterations < m_max_newton))
+    {
+        m_num_newton_iterations++;
+        gmres(u, res, du, device);
+
+        // backtracking line search on the residual norm
+        double lambda{1.0};
+        double res_norm_trial{0.0};
+        for (int i = 0; i <= m_max_backtrack; i++)
+        {
+            u_trial.noalias() = u + lambda * du;
+
+            // NOTE: large steps may leave the domain where the dynamics are defined (e.g. overlapping bodies)
+            try
+            {
+                residual(u_trial, res_trial, device);
+                res_norm_trial = res_trial.norm();
+            }
+            catch (const std::runtime_error& e)
+            {
+                spdlog::get(m_logName)->warn("Period map failed with step length {0}: {1}", lambda, e.what());
+                res_norm_trial = std::numeric_limits<double>::infinity();
+            }
+
+            if (res_norm_trial <= (1.0 - 1.0e-4 * lambda) * res_norm)
+            {
+                break;
+            }
+            lambda *= 0.5;
+        }
+
+        if (!std::isfinite(res_norm_trial))
+        {
+            spdlog::get(m_logName)->warn("Line search failed at Newton iteration {0}", m_num_newton_iterations);
+            break;
+        }
+
+        u.noalias()   = u_trial;
+        res.noalias() = res_trial;
+        res_norm      = res_norm_trial;
+        spdlog::get(m_logName)->info("Newton iteration {0}: step length {1}, residual norm {2}",
+                                     m_num_newton_iterations, lambda, res_norm);
+    }
+
+    const bool converged{res_norm <= m_tol};
+    if (!converged)
+    {
+        spdlog::get(m_logName)->warn("Periodic orbit did not converge in {0} Newton iterations: residual norm {1}",
+                                     m_max_newton, res_norm);
+    }
+
+    /* ANCHOR: output orbit properties */
+    // NOTE: `m_displacement` is the displacement of the last residual evaluation, i.e. at `u`
+    m_system->setPeriodicOrbitResidual(res_norm);
+    m_system->setPeriodicOrbitDisplacement(m_displacement);
+    spdlog::get(m_logName)->info("Displacement per period: ({0}, {1}, {2})", m_displacement(0), m_displacement(1),
+                                 m_displacement(2));
+
+    floquetMultipliers(u, res, device);
+
+    // reset system to the periodic state at the initial time
+    setState(u);
+    m_system->setT(m_t0);
+    m_system->update(device);
+    m_potHydro->update(device);
+
+    spdlog::get(m_logName)->info("Period map evaluations: {0}", m_num_period_maps);
+    spdlog::get(m_logName)->flush();
+
+    return converged;
+}
+
+void
+PeriodicOrbit::residual(const Eigen::VectorXd& u, Eigen::VectorXd& res, const Eigen::ThreadPoolDevice& device)
+{
+    m_num_period_maps++;
+
+    setState(u);
+    m_system->setT(m_t0);
+
+    // NOTE: `RungeKutta4` re-evaluates step 1 of the first step, as the body state was modified
+    for (int step = 0; step < m_steps_per_period; step++)
+    {
+        m_rk4->integrate(device);
+        m_system->setT(m_system->t() + m_system->dt());
+    }
+
+    Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * m_7M);
+    state << m_system->positionsBodies(), m_system->velocitiesBodies();
+
+    m_displacement.noalias() = state.segment<3>(0) - m_state.segment<3>(0);
+
+    // periodic modulo the translation of the first body along invariant directions
+    for (int k = 0; k < m_num_unknowns; k++)
+    {
+        const int idx{m_unknown_index[k]};
+        res(k) = state(idx) - m_state(idx);
+
+        if ((idx < m_7M) && (idx % 7 < m_num_invariant))
+        {
+            res(k) -= m_displacement(idx % 7);
+        }
+    }
+}
+
+void
+PeriodicOrbit::jacobianProduct(const Eigen::VectorXd& u, const Eigen::VectorXd& res, const Eigen::VectorXd& v,
+                               Eigen::VectorXd& jv, const Eigen::ThreadPoolDevice& device)
+{
+    const double eps{std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + u.norm())};
+
+    Eigen::VectorXd u_eps = u + eps * v;
+    residual(u_eps, jv, device);
+
+    jv -= res;
+    jv /= eps;
+}
+
+bool
+PeriodicOrbit::arnoldi(const Eigen::VectorXd& u, const Eigen::VectorXd& res, const int k, Eigen::MatrixXd& basis,
+                       const Eigen::ThreadPoolDevice& device)
+{
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(m_num_unknowns);
+    jacobianProduct(u, res, basis.col(k), w, device);
+
+    for (int i = 0; i <= k; i++)
+    {
+        m_hessenberg(i, k) = basis.col(i).dot(w);
+        w.noalias() -= m_hessenberg(i, k) * basis.col(i);
+    }
+    m_hessenberg(k + 1, k) = w.norm();
+
+    // NOTE: Krylov subspace is invariant once the new direction is lost in the finite difference error
+    if (m_hessenberg(k + 1, k) <= 1.0e-12 * m_hessenberg.col(k).norm())
+    {
+        return true;
+    }
+
+    basis.col(k + 1) = w / m_hessenberg(k + 1, k);
+    return false;
+}
+
+void
+PeriodicOrbit::gmres(const Eigen::VectorXd& u, const Eigen::VectorXd& res, Eigen::VectorXd& du,
+                     const Eigen::ThreadPoolDevice& device)
+{
+    const int    k_max{std::min(m_num_unknowns, m_max_krylov)};
+    const double beta{res.norm()};
+
+    Eigen::MatrixXd basis = Eigen::MatrixXd::Zero(m_num_unknowns, k_max + 1);
+    m_hessenberg          = Eigen::MatrixXd::Zero(k_max + 1, k_max);
+    basis.col(0)          = -res / beta;
+
+    Eigen::VectorXd y = Eigen::VectorXd::Zero(k_max);
+    int             k{0};
+
+    while (k < k_max)
+    {
+        const bool breakdown{arnoldi(u, res, k, basis, device)};
+        k++;
+
+        // least squares problem min |beta e_1 - H y| over the Krylov subspace
+        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(k + 1);
+        rhs(0)              = beta;
+
+        // NOTE: minimum norm solution of the rank-truncated problem, so (nearly) neutral directions of the period map,
+        // e.g. from conserved momenta, are not excited by finite difference noise
+        const Eigen::MatrixXd                                   H = m_hessenberg.topLeftCorner(k + 1, k);
+        Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> cod(H);
+        cod.setThreshold(m_gmres_rank_tol);
+        y.head(k) = cod.solve(rhs);
+
+        const double lsq_residual{(rhs - H * y.head(k)).norm()};
+
+        if (breakdown || (lsq_residual <= m_gmres_rel_tol * beta))
+        {
+            break;
+        }
+    }
+
+    spdlog::get(m_logName)->info("GMRES Krylov dimension: {0}", k);
+    du.noalias() = basis.leftCols(k) * y.head(k);
+}
+
+void
+PeriodicOrbit::floquetMultipliers(const Eigen::VectorXd& u, const Eigen::VectorXd& res,
+                                  const Eigen::ThreadPoolDevice& device)
+{
+    const int k_max{std::min(m_num_unknowns, m_max_krylov)};
+
+    // NOTE: generic starting vector, so no eigenvector of the Jacobian is missed by symmetry
+    Eigen::MatrixXd basis = Eigen::MatrixXd::Zero(m_num_unknowns, k_max + 1);
+    m_hessenberg          = Eigen::MatrixXd::Zero(k_max + 1, k_max);
+    basis.col(0)          = Eigen::VectorXd::LinSpaced(m_num_unknowns, 1.0, 2.0).normalized();
+
+    int k{0};
+    while (k < k_max)
+    {
+        const bool breakdown{arnoldi(u, res, k, basis, device)};
+        k++;
+
+        if (breakdown)
+        {
+            break;
+        }
+    }
+
+    // Floquet multipliers of the period map are the eigenvalues of J + I
+    Eigen::EigenSolver<Eigen::MatrixXd> eigensolver(m_hessenberg.topLeftCorner(k, k), false);
+    Eigen::MatrixXd                     multipliers = Eigen::MatrixXd::Zero(k, 2);
+    multipliers.col(0) = eigensolver.eigenvalues().real() + Eigen::VectorXd::Ones(k);
+    multipliers.col(1) = eigensolver.eigenvalues().imag();
+
+    for (int i = 0; i < k; i++)
+    {
+        spdlog::get(m_logName)->info("Floquet multiplier {0}: {1} + {2} i (modulus {3})", i + 1, multipliers(i, 0),
+                                     multipliers(i, 1), multipliers.row(i).norm());
+    }
+
+    m_system->setFloquetMultipliers(multipliers);
+}
+
+void
+PeriodicOrbit::setState(const Eigen::VectorXd& u)
+{
+    m_state.noalias() = m_state0;
+    for (int k = 0; k < m_num_unknowns; k++)
+    {
+        m_state(m_unknown_index[k]) = u(k);
+    }
+
+    // NOTE: image bodies are reflected from the real bodies by `RungeKutta4` in each acceleration update
+    m_system->setPositionsBodies(m_state.head(m_7M));
+    m_system->setVelocitiesBodies(m_state.tail(m_7M));
+}
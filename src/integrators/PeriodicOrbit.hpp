@@ -0,0 +1,260 @@
+//
+// Created by Alec Glisman on 10/17/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_PERIODIC_ORBIT_H
+#define BODIES_IN_POTENTIAL_FLOW_PERIODIC_ORBIT_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all internal project dependencies */
+#include <PotentialHydrodynamics.hpp>
+#include <RungeKutta4.hpp>
+#include <SystemData.hpp>
+
+/* Include all external project dependencies */
+// Intel MKL
+#if __has_include("mkl.h")
+#define EIGEN_USE_MKL_ALL
+#else
+#pragma message(" !! COMPILING WITHOUT INTEL MKL OPTIMIZATIONS !! ")
+#endif
+// eigen3(Linear algebra)
+#define EIGEN_NO_AUTOMATIC_RESIZING
+#define EIGEN_USE_THREADS
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigen>
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// Logging
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+// STL
+#include <algorithm> // std::min
+#include <cmath>     // std::sqrt, std::round, std::isfinite
+#include <limits>    // std::numeric_limits
+#include <memory>    // for std::shared_ptr
+#include <stdexcept> // std::errors
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+/* Forward declarations */
+class SystemData;
+
+/**
+ * @class PeriodicOrbit
+ *
+ * @brief Finds periodic (limit-cycle) states of the body dynamics under a periodic gait by shooting with
+ * Newton-Krylov iterations.
+ *
+ * @details The period map @f$ \boldsymbol{\Phi} @f$ integrates the body state over one gait period
+ * @f$ T = 2 \pi / (\omega \tau) @f$ with `RungeKutta4`, starting from `SystemData::t()`.
+ * A periodic state is a root of @f$ \boldsymbol{F}(\boldsymbol{u}) = \boldsymbol{\Phi}(\boldsymbol{u}) -
+ * \boldsymbol{u} @f$ modulo rigid translation of the whole system along directions the dynamics are invariant to (x, y
+ * and z for isolated systems, x and y for image systems).
+ * The unknowns @f$ \boldsymbol{u} @f$ are the linear positions and velocities of the free bodies, except the linear
+ * positions of the first body along the invariant directions, which fix the translation.
+ * Body orientations and quaternion velocities are held at their initial values.
+ *
+ * Each Newton step solves @f$ \boldsymbol{J} \delta \boldsymbol{u} = -\boldsymbol{F} @f$ with GMRES, where products
+ * with the Jacobian are finite differences of the period map, and is globalized with a backtracking line search on
+ * @f$ |\boldsymbol{F}| @f$.
+ * Floquet multipliers of the converged orbit are the Ritz values of an Arnoldi process on the Jacobian, shifted by 1.
+ *
+ * @see **Reference:** Kelley, C. T. Solving Nonlinear Equations with Newton's Method. SIAM (2003), Ch. 3.
+ *
+ */
+class PeriodicOrbit
+{
+  public:
+    /**
+     * @brief Construct a new periodic orbit object
+     *
+     * @param sys SystemData class to gather data from. The gait period must be an integer number of time steps.
+     * @param hydro PotentialHydrodynamics class to get hydrodynamic force data from
+     * @param rk4 RungeKutta4 class used to integrate the period map
+     */
+    explicit PeriodicOrbit(std::shared_ptr<SystemData> sys, std::shared_ptr<PotentialHydrodynamics> hydro,
+                           std::shared_ptr<RungeKutta4> rk4);
+
+    /**
+     * @brief Destroy the periodic orbit object
+     *
+     */
+    ~PeriodicOrbit();
+
+    /**
+     * @brief Newton-Krylov solve for the periodic state, starting from the current `SystemData` state.
+     *
+     * @details Iterates until @f$ |\boldsymbol{F}| @f$ is at most `SystemData::periodicOrbitTol()`.
+     * On return, `SystemData` holds the best state found at the initial time (updated for output), along with the
+     * residual norm, the net displacement per period and the Floquet multipliers of the orbit.
+     *
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     * @return true periodic orbit converged
+     * @return false maximum number of Newton iterations reached
+     */
+    bool
+    solve(const Eigen::ThreadPoolDevice& device);
+
+  private:
+    /**
+     * @brief Evaluates the residual @f$ \boldsymbol{F}(\boldsymbol{u}) @f$ by integrating one gait period.
+     *
+     * @details Also sets `m_displacement` to the displacement of the first body over the period.
+     *
+     * @param u (n x 1) unknowns
+     * @param res (output) (n x 1) residual
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    residual(const Eigen::VectorXd& u, Eigen::VectorXd& res, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Forward difference approximation of the Jacobian-vector product @f$ \boldsymbol{J} \boldsymbol{v} @f$.
+     *
+     * @param u (n x 1) unknowns
+     * @param res (n x 1) residual at `u`
+     * @param v (n x 1) unit direction
+     * @param jv (output) (n x 1) Jacobian-vector product
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    jacobianProduct(const Eigen::VectorXd& u, const Eigen::VectorXd& res, const Eigen::VectorXd& v,
+                    Eigen::VectorXd& jv, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Arnoldi iteration with modified Gram-Schmidt orthogonalization on the Jacobian.
+     *
+     * @details Column `k` of `basis` must be a unit vector on entry. Fills column `k` of `m_hessenberg` and, unless the
+     * Krylov subspace is invariant, column `k + 1` of `basis`.
+     *
+     * @param u (n x 1) unknowns
+     * @param res (n x 1) residual at `u`
+     * @param k Arnoldi iteration number
+     * @param basis (n x (k_max + 1)) orthonormal Krylov basis
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     * @return true Krylov subspace is invariant (breakdown)
+     * @return false basis was extended
+     */
+    bool
+    arnoldi(const Eigen::VectorXd& u, const Eigen::VectorXd& res, const int k, Eigen::MatrixXd& basis,
+            const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief GMRES solve of the Newton step @f$ \boldsymbol{J} \delta \boldsymbol{u} = -\boldsymbol{F} @f$ to relative
+     * tolerance `m_gmres_rel_tol`, without restarts.
+     *
+     * @param u (n x 1) unknowns
+     * @param res (n x 1) residual at `u`
+     * @param du (output) (n x 1) Newton step
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    gmres(const Eigen::VectorXd& u, const Eigen::VectorXd& res, Eigen::VectorXd& du,
+          const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Floquet multipliers of the orbit at `u` from the eigenvalues of the Arnoldi Hessenberg matrix.
+     *
+     * @details The multipliers are exact if the Krylov subspace spans all unknowns (up to `m_max_krylov`).
+     *
+     * @param u (n x 1) unknowns
+     * @param res (n x 1) residual at `u`
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    floquetMultipliers(const Eigen::VectorXd& u, const Eigen::VectorXd& res, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Sets `m_state` and the body positions and velocities of `SystemData` from the unknowns and the initial
+     * state.
+     *
+     * @param u (n x 1) unknowns
+     */
+    void
+    setState(const Eigen::VectorXd& u);
+
+    // classes
+    std::shared_ptr<SystemData>             m_system;
+    std::shared_ptr<PotentialHydrodynamics> m_potHydro;
+    std::shared_ptr<RungeKutta4>            m_rk4;
+
+    // logging
+    std::string       m_logFile;
+    const std::string m_logName{"PeriodicOrbit"};
+
+    /// Gait period (non-dimensional)
+    double m_period{-1.0};
+    /// Number of time steps per gait period
+    int m_steps_per_period{-1};
+    /// Number of translation invariant directions (x, y, z) of the system
+    int m_num_invariant{3};
+
+    /// = 7M
+    int m_7M{-1};
+    /// = n. Number of unknowns
+    int m_num_unknowns{-1};
+    /// (n x 1) index of each unknown in the (14M x 1) stacked body positions and velocities
+    std::vector<int> m_unknown_index;
+
+    /// Initial time of the period map
+    double m_t0{0.0};
+    /// (14M x 1) initial body positions and velocities, supplies all components that are not unknowns
+    Eigen::VectorXd m_state0;
+    /// (14M x 1) body positions and velocities at the start of the last evaluated period
+    Eigen::VectorXd m_state;
+
+    /// Newton residual norm tolerance
+    double m_tol{-1.0};
+    /// Maximum number of Newton iterations
+    const int m_max_newton{25};
+    /// Maximum number of backtracking line search reductions per Newton iteration
+    const int m_max_backtrack{10};
+    /// Maximum dimension of the Krylov subspaces
+    const int m_max_krylov{40};
+    /// Relative residual tolerance of GMRES (inexact Newton forcing term)
+    const double m_gmres_rel_tol{1.0e-6};
+    /// Relative threshold of singular values of the GMRES least squares problem below which they are treated as zero
+    const double m_gmres_rank_tol{1.0e-6};
+
+    /// (k_max + 1 x k_max) upper Hessenberg matrix of the last Arnoldi process
+    Eigen::MatrixXd m_hessenberg;
+
+    // results
+    /// Displacement of the first body over the last evaluated period
+    Eigen::Vector3d m_displacement;
+    /// Number of evaluations of the period map
+    long m_num_period_maps{0};
+    /// Number of Newton iterations of the last solve
+    int m_num_newton_iterations{0};
+
+  public:
+    long
+    numPeriodMaps() const
+    {
+        return m_num_period_maps;
+    }
+
+    int
+    numNewtonIterations() const
+    {
+        return m_num_newton_iterations;
+    }
+
+    int
+    numUnknowns() const
+    {
+        return m_num_unknowns;
+    }
+
+    double
+    period() const
+    {
+        return m_period;
+    }
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_PERIODIC_ORBIT_H
@@ -11,6 +11,8 @@ RungeKutta4::RungeKutta4(std::shared_ptr<SystemData> sys, std::shared_ptr<Potent
     m_potHydro = hydro;
 
     // initialize logger
+    m_logName += m_system->logTag();
+
     m_logFile   = m_system->outputDir() + "/logs/" + m_logName + "-log.txt";
     auto logger = spdlog::basic_logger_mt(m_logName, m_logFile);
     spdlog::get(m_logName)->info("Initializing Runge-Kutta 4th order integrator");
@@ -47,6 +49,168 @@ RungeKutta4::RungeKutta4(std::shared_ptr<SystemData> sys, std::shared_ptr<Potent
     spdlog::get(m_logName)->info("body_dof: {0}", m_body_dof);
     spdlog::get(m_logName)->info("body_dof_7: {0}", m_body_dof_7);
 
+    m_integrator_scheme = m_system->integratorScheme();
+    spdlog::get(m_logName)->info("Integrator scheme: {0}", m_integrator_scheme);
+
+    if ((m_integrator_scheme != IntegratorScheme::Classical) && (m_integrator_scheme != IntegratorScheme::LieGroup) &&
+        (m_integrator_scheme != IntegratorScheme::Rattle))
+    {
+        spdlog::get(m_logName)->error("Unknown integrator scheme: {0}", m_integrator_scheme);
+        throw std::invalid_argument("Unknown integrator scheme");
+    }
+
+    m_udwadia_solver = m_system->udwadiaSolver();
+    spdlog::get(m_logName)->info("Udwadia-Kalaba solver: {0}", m_udwadia_solver);
+
+    if ((m_udwadia_solver != UdwadiaSolver::Eigendecomposition) && (m_udwadia_solver != UdwadiaSolver::Cholesky) &&
+        (m_udwadia_solver != UdwadiaSolver::Iterative))
+    {
+        spdlog::get(m_logName)->error("Unknown Udwadia-Kalaba solver: {0}", m_udwadia_solver);
+        throw std::invalid_argument("Unknown Udwadia-Kalaba solver");
+    }
+
+    m_udwadia_refactor_tol = m_system->udwadiaRefactorTol();
+    spdlog::get(m_logName)->info("Effective mass refactorization tolerance: {0}", m_udwadia_refactor_tol);
+
+    if ((m_udwadia_refactor_tol > 0.0) && (m_udwadia_solver != UdwadiaSolver::Cholesky))
+    {
+        spdlog::get(m_logName)->warn("Reusing effective mass factorization requires the Cholesky solver, ignoring");
+        m_udwadia_refactor_tol = 0.0;
+    }
+
+    m_block_jacobi_llt.resize(m_body_dof);
+
+    if (m_udwadia_solver == UdwadiaSolver::Iterative)
+    {
+        m_cg_Q     = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_acc_p = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_y     = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_res   = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_z     = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_dir   = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_cg_M_dir = Eigen::VectorXd::Zero(m_body_dof_7);
+    }
+
+    if (m_udwadia_refactor_tol > 0.0)
+    {
+        // NOTE: one right-hand side for the forces and one per free body quaternion constraint
+        m_reuse_M_eff      = Eigen::MatrixXd::Zero(m_body_dof_7, m_body_dof_7);
+        m_reuse_rhs        = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + m_body_dof);
+        m_reuse_sol        = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + m_body_dof);
+        m_reuse_residual   = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + m_body_dof);
+        m_reuse_correction = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + m_body_dof);
+        m_M_eff_llt        = Eigen::LLT<Eigen::MatrixXd>(m_body_dof_7);
+    }
+
+    m_rattle_max_iter = m_system->rattleIterations();
+
+    if (m_rattle_max_iter < 1)
+    {
+        spdlog::get(m_logName)->error("RATTLE requires at least one fixed-point iteration: {0}", m_rattle_max_iter);
+        throw std::invalid_argument("RATTLE requires at least one fixed-point iteration");
+    }
+
+    if (m_integrator_scheme == IntegratorScheme::LieGroup)
+    {
+        const int m6{6 * m_body_dof};
+
+        m_lg_pos_n = Eigen::VectorXd::Zero(m_7M);
+        m_lg_vel_n = Eigen::VectorXd::Zero(m_7M);
+        m_lg_pos   = Eigen::VectorXd::Zero(m_7M);
+        m_lg_vel   = Eigen::VectorXd::Zero(m_7M);
+        m_lg_acc   = Eigen::VectorXd::Zero(m_7M);
+        m_lg_nu_n  = Eigen::VectorXd::Zero(m6);
+        m_lg_nu    = Eigen::VectorXd::Zero(m6);
+        m_lg_disp  = Eigen::VectorXd::Zero(m6);
+
+        for (int stage = 0; stage < 4; stage++)
+        {
+            m_lg_k_disp[stage] = Eigen::VectorXd::Zero(m6);
+            m_lg_k_nu[stage]   = Eigen::VectorXd::Zero(m6);
+        }
+
+        m_red_Q        = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_red_T        = Eigen::MatrixXd::Zero(m_body_dof_7, m6);
+        m_red_T_dot_nu = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_red_M_T      = Eigen::MatrixXd::Zero(m_body_dof_7, m6);
+        m_red_M        = Eigen::MatrixXd::Zero(m6, m6);
+        m_red_Q_red    = Eigen::VectorXd::Zero(m6);
+        m_red_nu_dot   = Eigen::VectorXd::Zero(m6);
+        m_red_llt      = Eigen::LLT<Eigen::MatrixXd>(m6);
+    }
+
+    if (m_integrator_scheme == IntegratorScheme::Rattle)
+    {
+        spdlog::get(m_logName)->info("RATTLE fixed-point iterations: {0}", m_rattle_max_iter);
+
+        m_rattle_pos_n    = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_vel_n    = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_acc_n    = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_vel_half = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_pos_out  = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_vel_out  = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_acc_out  = Eigen::VectorXd::Zero(m_7M);
+        m_rattle_vel_next = Eigen::VectorXd::Zero(m_7M);
+    }
+
+    // first-same-as-last cache is empty until the first step is complete
+    m_fsal_pos = Eigen::VectorXd::Zero(m_7M);
+    m_fsal_vel = Eigen::VectorXd::Zero(m_7M);
+    m_fsal_acc = Eigen::VectorXd::Zero(m_7M);
+
+    // stage buffers of `integrateSecondOrder()` and `accelerationUpdate()`
+    for (int stage = 0; stage < 4; stage++)
+    {
+        m_rk_pos[stage] = Eigen::VectorXd::Zero(m_7M);
+        m_rk_vel[stage] = Eigen::VectorXd::Zero(m_7M);
+        m_rk_acc[stage] = Eigen::VectorXd::Zero(m_7M);
+    }
+    m_rk_pos_out    = Eigen::VectorXd::Zero(m_7M);
+    m_rk_vel_out    = Eigen::VectorXd::Zero(m_7M);
+    m_rk_acc_out    = Eigen::VectorXd::Zero(m_7M);
+    m_acc_real_body = Eigen::VectorXd::Zero(m_body_dof_7);
+
+    // adaptive time stepping
+    m_atol     = m_system->adaptiveAtol();
+    m_rtol     = m_system->adaptiveRtol();
+    m_adaptive = (m_atol > 0.0) || (m_rtol > 0.0);
+
+    if (m_adaptive && (m_integrator_scheme != IntegratorScheme::Classical))
+    {
+        spdlog::get(m_logName)->warn("Adaptive time stepping requires the classical integrator scheme, ignoring");
+        m_adaptive = false;
+    }
+    spdlog::get(m_logName)->info("Adaptive Dormand-Prince 5(4) time stepping: {0}", m_adaptive);
+
+    if (m_adaptive)
+    {
+        spdlog::get(m_logName)->info("Absolute tolerance: {0}, relative tolerance: {1}", m_atol, m_rtol);
+
+        // NOTE: internal step size starts at fixed time step
+        m_dp_h     = m_dt;
+        m_dp_h_min = 1.0e-12 * m_dt;
+
+        m_dp_pos       = Eigen::VectorXd::Zero(m_7M);
+        m_dp_vel       = Eigen::VectorXd::Zero(m_7M);
+        m_dp_acc       = Eigen::VectorXd::Zero(m_7M);
+        m_dp_pos_prev  = Eigen::VectorXd::Zero(m_7M);
+        m_dp_vel_prev  = Eigen::VectorXd::Zero(m_7M);
+        m_dp_acc_prev  = Eigen::VectorXd::Zero(m_7M);
+        m_dp_stage_pos = Eigen::VectorXd::Zero(m_7M);
+        m_dp_stage_vel = Eigen::VectorXd::Zero(m_7M);
+        m_dp_pos_out   = Eigen::VectorXd::Zero(m_7M);
+        m_dp_vel_out   = Eigen::VectorXd::Zero(m_7M);
+        m_dp_acc_out   = Eigen::VectorXd::Zero(m_7M);
+        m_dp_err_pos   = Eigen::VectorXd::Zero(m_body_dof_7);
+        m_dp_err_vel   = Eigen::VectorXd::Zero(m_body_dof_7);
+
+        for (int stage = 0; stage < 7; stage++)
+        {
+            m_dp_k_pos[stage] = Eigen::VectorXd::Zero(m_7M);
+            m_dp_k_vel[stage] = Eigen::VectorXd::Zero(m_7M);
+        }
+    }
+
     // for initial conditions of all locater points, use the PF-free algorithm
     spdlog::get(m_logName)->critical("Setting initial conditions using PF-free algorithm.");
 
@@ -122,80 +286,602 @@ RungeKutta4::~RungeKutta4()
 void
 RungeKutta4::integrate(const Eigen::ThreadPoolDevice& device)
 {
-    integrateSecondOrder(device); // Udwadia-Kalaba method only gives acceleration components
+    // Udwadia-Kalaba method only gives acceleration components
+    if (m_integrator_scheme == IntegratorScheme::LieGroup)
+    {
+        integrateLieGroup(device);
+    }
+    else if (m_integrator_scheme == IntegratorScheme::Rattle)
+    {
+        integrateRattle(device);
+    }
+    else if (m_adaptive)
+    {
+        integrateAdaptive(device);
+    }
+    else
+    {
+        integrateSecondOrder(device);
+    }
 }
 
 void
 RungeKutta4::integrateSecondOrder(const Eigen::ThreadPoolDevice& device)
 {
+    // NOTE: stage buffers are preallocated members, so a time step does not allocate
+    Eigen::VectorXd& x1 = m_rk_pos[0];
+    Eigen::VectorXd& x2 = m_rk_pos[1];
+    Eigen::VectorXd& x3 = m_rk_pos[2];
+    Eigen::VectorXd& x4 = m_rk_pos[3];
+    Eigen::VectorXd& v1 = m_rk_vel[0];
+    Eigen::VectorXd& v2 = m_rk_vel[1];
+    Eigen::VectorXd& v3 = m_rk_vel[2];
+    Eigen::VectorXd& v4 = m_rk_vel[3];
+    Eigen::VectorXd& a1 = m_rk_acc[0];
+    Eigen::VectorXd& a2 = m_rk_acc[1];
+    Eigen::VectorXd& a3 = m_rk_acc[2];
+    Eigen::VectorXd& a4 = m_rk_acc[3];
+
     /* Step 1: k1 = f( y(t_0),  t_0 )
      * initial conditions at current step */
-    const double    t1{m_system->t()};
-    Eigen::VectorXd v1 = m_system->velocitiesBodies();
-    Eigen::VectorXd x1 = m_system->positionsBodies();
+    const double t1{m_system->t()};
+    v1.noalias() = m_system->velocitiesBodies();
+    x1.noalias() = m_system->positionsBodies();
 
-    Eigen::VectorXd a1 = Eigen::VectorXd::Zero(m_7M);
-    accelerationUpdate(t1, x1, v1, a1, device);
+    if (fsalValid(t1, x1, v1))
+    {
+        // NOTE: `SystemData` and `PotentialHydrodynamics` were last updated at this state at the end of previous step
+        a1.noalias() = m_fsal_acc;
+    }
+    else
+    {
+        a1.setZero();
+        accelerationUpdate(t1, x1, v1, a1, device);
+    }
 
     /* Step 2: k2 = f( y(t_0) + k1 * dt/2,  t_0 + dt/2 )
      * time rate-of-change k1 evaluated halfway through time step (midpoint) */
-    const double    t2{t1 + 0.50 * m_system->dt()};
-    Eigen::VectorXd v2 = v1;
+    const double t2{t1 + 0.50 * m_system->dt()};
+    v2.noalias() = v1;
     v2.noalias() += m_c1_2_dt * a1;
-    Eigen::VectorXd x2 = x1;
+    x2.noalias() = x1;
     x2.noalias() += m_c1_2_dt * v2;
 
-    Eigen::VectorXd a2 = Eigen::VectorXd::Zero(m_7M);
+    a2.setZero();
     accelerationUpdate(t2, x2, v2, a2, device);
 
     /* Step 3: k3 = f( y(t_0) + k2 * dt/2,  t_0 + dt/2 )
      * time rate-of-change k2 evaluated halfway through time step (midpoint) */
-    const double    t3{t2};
-    Eigen::VectorXd v3 = v1;
+    const double t3{t2};
+    v3.noalias() = v1;
     v3.noalias() += m_c1_2_dt * a2;
-    Eigen::VectorXd x3 = x1;
+    x3.noalias() = x1;
     x3.noalias() += m_c1_2_dt * v3;
 
-    Eigen::VectorXd a3 = Eigen::VectorXd::Zero(m_7M);
+    a3.setZero();
     accelerationUpdate(t3, x3, v3, a3, device);
 
     /* Step 4: k4 = f( y(t_0) + k3 * dt,  t_0 + dt )
      * time rate-of-change k3 evaluated at end of step (endpoint) */
-    const double    t4{t1 + m_system->dt()};
-    Eigen::VectorXd v4 = v1;
+    const double t4{t1 + m_system->dt()};
+    v4.noalias() = v1;
     v4.noalias() += m_dt * a3;
-    Eigen::VectorXd x4 = x1;
+    x4.noalias() = x1;
     x4.noalias() += m_dt * v4;
 
-    Eigen::VectorXd a4 = Eigen::VectorXd::Zero(m_7M);
+    a4.setZero();
     accelerationUpdate(t4, x4, v4, a4, device);
 
     /* ANCHOR: Calculate kinematics at end of time step */
-    Eigen::VectorXd v_out = a1;
-    v_out.noalias() += 2.0 * a2;
-    v_out.noalias() += 2.0 * a3;
-    v_out.noalias() += a4;
-    v_out *= m_c1_6_dt;
-    v_out.noalias() += v1;
-
-    Eigen::VectorXd x_out = v1;
-    x_out.noalias() += 2.0 * v2;
-    x_out.noalias() += 2.0 * v3;
-    x_out.noalias() += v4;
-    x_out *= m_c1_6_dt;
-    x_out.noalias() += x1;
-
-    Eigen::VectorXd a_out = Eigen::VectorXd::Zero(m_7M);
-    accelerationUpdate(t4, x_out, v_out, a_out, device);
+    m_rk_vel_out.noalias() = a1;
+    m_rk_vel_out.noalias() += 2.0 * a2;
+    m_rk_vel_out.noalias() += 2.0 * a3;
+    m_rk_vel_out.noalias() += a4;
+    m_rk_vel_out *= m_c1_6_dt;
+    m_rk_vel_out.noalias() += v1;
+
+    m_rk_pos_out.noalias() = v1;
+    m_rk_pos_out.noalias() += 2.0 * v2;
+    m_rk_pos_out.noalias() += 2.0 * v3;
+    m_rk_pos_out.noalias() += v4;
+    m_rk_pos_out *= m_c1_6_dt;
+    m_rk_pos_out.noalias() += x1;
+
+    m_rk_acc_out.setZero();
+    accelerationUpdate(t4, m_rk_pos_out, m_rk_vel_out, m_rk_acc_out, device);
+
+    // carry end of step evaluation forward to step 1 of next step
+    m_fsal_t             = t4;
+    m_fsal_pos.noalias() = m_rk_pos_out;
+    m_fsal_vel.noalias() = m_rk_vel_out;
+    m_fsal_acc.noalias() = m_rk_acc_out;
+    m_fsal_valid         = true;
 
     // reset system time to t1 as `Engine` class manages updating system time at end of each step
     m_system->setT(t1);
 }
 
+void
+RungeKutta4::integrateAdaptive(const Eigen::ThreadPoolDevice& device)
+{
+    const double t_start{m_system->t()};
+    const double t_target{t_start + m_system->dt()};
+
+    /* ANCHOR: restart internal state from `SystemData` if body state was modified since previous call */
+    if (!(m_dp_valid && fsalValid(t_start, m_system->positionsBodies(), m_system->velocitiesBodies())))
+    {
+        m_dp_t             = t_start;
+        m_dp_pos.noalias() = m_system->positionsBodies();
+        m_dp_vel.noalias() = m_system->velocitiesBodies();
+        m_dp_valid         = true;
+        accelerationUpdate(m_dp_t, m_dp_pos, m_dp_vel, m_dp_acc, device);
+    }
+
+    /* ANCHOR: internal steps until target time is inside last accepted step */
+    while (m_dp_t < t_target)
+    {
+        dormandPrinceStep(device);
+    }
+
+    /* ANCHOR: dense output, continuous extension of last accepted step */
+    // NOTE: rejected steps do not leave the loop, so stage derivatives are of the last accepted step
+    const double h{(m_dp_t - m_dp_t_prev) * m_system->tau()}; // (dimensional)
+    const double theta{(t_target - m_dp_t_prev) / (m_dp_t - m_dp_t_prev)};
+
+    dormandPrinceDenseOutput(theta, h, m_dp_pos_prev, m_dp_pos, m_dp_k_pos, m_dp_pos_out);
+    dormandPrinceDenseOutput(theta, h, m_dp_vel_prev, m_dp_vel, m_dp_k_vel, m_dp_vel_out);
+
+    /* NOTE: only the output state is normalized, so `Engine` does not modify the body state on output frames and the
+     * internal state continues unperturbed */
+    for (int body_id = 0; body_id < m_system->numBodies(); body_id++)
+    {
+        m_dp_pos_out.segment<4>(7 * body_id + 3).normalize();
+    }
+
+    // leave `SystemData` and `PotentialHydrodynamics` consistent with the output state
+    accelerationUpdate(t_target, m_dp_pos_out, m_dp_vel_out, m_dp_acc_out, device);
+
+    // NOTE: output state is the reference to detect modifications of the body state before next call
+    m_fsal_t             = t_target;
+    m_fsal_pos.noalias() = m_dp_pos_out;
+    m_fsal_vel.noalias() = m_dp_vel_out;
+    m_fsal_acc.noalias() = m_dp_acc_out;
+    m_fsal_valid         = true;
+
+    // reset system time to t_start as `Engine` class manages updating system time at end of each step
+    m_system->setT(t_start);
+}
+
+void
+RungeKutta4::integrateLieGroup(const Eigen::ThreadPoolDevice& device)
+{
+    /* Step 1: initial conditions at current step */
+    const double t1{m_system->t()};
+    m_lg_vel_n.noalias() = m_system->velocitiesBodies();
+    m_lg_pos_n.noalias() = m_system->positionsBodies();
+
+    if (fsalValid(t1, m_lg_pos_n, m_lg_vel_n))
+    {
+        // NOTE: `SystemData` and `PotentialHydrodynamics` were last updated at this state at the end of previous step
+        m_lg_acc.noalias() = m_fsal_acc;
+    }
+    else
+    {
+        accelerationUpdate(t1, m_lg_pos_n, m_lg_vel_n, m_lg_acc, device);
+    }
+
+    // Lie algebra coordinates: displacements from (pos_n, vel_n) and velocities
+    lieGroupVelocity(m_lg_pos_n, m_lg_vel_n, m_lg_nu_n);
+
+    m_lg_disp.setZero();
+    lieGroupDerivative(m_lg_disp, m_lg_pos_n, m_lg_vel_n, m_lg_acc, m_lg_k_disp[0], m_lg_k_nu[0]);
+
+    m_lg_vel.noalias() = m_lg_vel_n;
+
+    /* Steps 2-4: stages at midpoint, midpoint and endpoint
+     * NOTE: stage displacements use the stage velocities, as positions in `integrateSecondOrder()` */
+    const std::array<double, 4> c{0.0, 0.50, 0.50, 1.0};
+
+    for (int stage = 1; stage < 4; stage++)
+    {
+        const double h_a{c[stage] * m_dt};
+
+        m_lg_nu.noalias() = m_lg_nu_n;
+        m_lg_nu.noalias() += h_a * m_lg_k_nu[stage - 1];
+        m_lg_disp.noalias() = h_a * m_lg_nu;
+
+        lieGroupState(m_lg_pos_n, m_lg_disp, m_lg_nu, m_lg_pos, m_lg_vel);
+        accelerationUpdate(t1 + c[stage] * m_system->dt(), m_lg_pos, m_lg_vel, m_lg_acc, device);
+        lieGroupDerivative(m_lg_disp, m_lg_pos, m_lg_vel, m_lg_acc, m_lg_k_disp[stage], m_lg_k_nu[stage]);
+    }
+
+    /* ANCHOR: Calculate kinematics at end of time step */
+    m_lg_disp.noalias() = m_lg_k_disp[0];
+    m_lg_disp.noalias() += 2.0 * m_lg_k_disp[1];
+    m_lg_disp.noalias() += 2.0 * m_lg_k_disp[2];
+    m_lg_disp.noalias() += m_lg_k_disp[3];
+    m_lg_disp *= m_c1_6_dt;
+
+    m_lg_nu.noalias() = m_lg_k_nu[0];
+    m_lg_nu.noalias() += 2.0 * m_lg_k_nu[1];
+    m_lg_nu.noalias() += 2.0 * m_lg_k_nu[2];
+    m_lg_nu.noalias() += m_lg_k_nu[3];
+    m_lg_nu *= m_c1_6_dt;
+    m_lg_nu.noalias() += m_lg_nu_n;
+
+    m_lg_vel.noalias() = m_lg_vel_n;
+    lieGroupState(m_lg_pos_n, m_lg_disp, m_lg_nu, m_lg_pos, m_lg_vel);
+
+    accelerationUpdate(t1 + m_system->dt(), m_lg_pos, m_lg_vel, m_lg_acc, device);
+
+    // carry end of step evaluation forward to step 1 of next step
+    m_fsal_t             = t1 + m_system->dt();
+    m_fsal_pos.noalias() = m_lg_pos;
+    m_fsal_vel.noalias() = m_lg_vel;
+    m_fsal_acc.noalias() = m_lg_acc;
+    m_fsal_valid         = true;
+
+    // reset system time to t1 as `Engine` class manages updating system time at end of each step
+    m_system->setT(t1);
+}
+
+void
+RungeKutta4::integrateRattle(const Eigen::ThreadPoolDevice& device)
+{
+    /* Step 1: initial conditions at current step */
+    const double t1{m_system->t()};
+    m_rattle_vel_n.noalias() = m_system->velocitiesBodies();
+    m_rattle_pos_n.noalias() = m_system->positionsBodies();
+
+    if (fsalValid(t1, m_rattle_pos_n, m_rattle_vel_n))
+    {
+        // NOTE: `SystemData` and `PotentialHydrodynamics` were last updated at this state at the end of previous step
+        m_rattle_acc_n.noalias() = m_fsal_acc;
+    }
+    else
+    {
+        accelerationUpdate(t1, m_rattle_pos_n, m_rattle_vel_n, m_rattle_acc_n, device);
+    }
+
+    /* ANCHOR: first kick and drift */
+    m_rattle_vel_half.noalias() = m_rattle_vel_n;
+    m_rattle_vel_half.noalias() += m_c1_2_dt * m_rattle_acc_n;
+
+    m_rattle_pos_out.noalias() = m_rattle_pos_n;
+    m_rattle_pos_out.noalias() += m_dt * m_rattle_vel_half;
+
+    // NOTE: image bodies are overwritten with the images of the free bodies in `accelerationUpdate()`
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int quat_start{7 * body_id + 3};
+
+        const Eigen::Vector4d quat_n = m_rattle_pos_n.segment<4>(quat_start);
+        const Eigen::Vector4d quat   = m_rattle_pos_out.segment<4>(quat_start);
+
+        // |quat + mu quat_n|^2 = 1, root of smallest magnitude (stable form)
+        const double a{quat_n.squaredNorm()};
+        const double b{quat.dot(quat_n)};
+        const double c{quat.squaredNorm() - 1.0};
+
+        const double discriminant{b * b - a * c};
+
+        if (discriminant < 0.0)
+        {
+            spdlog::get(m_logName)->error("RATTLE quaternion constraint has no solution at t={0}", t1);
+            throw std::runtime_error("RATTLE quaternion constraint has no solution");
+        }
+
+        const double root{b + std::copysign(std::sqrt(discriminant), b)};
+        const double mu{(root != 0.0) ? -c / root : 0.0};
+
+        m_rattle_pos_out.segment<4>(quat_start).noalias() += mu * quat_n;
+        m_rattle_vel_half.segment<4>(quat_start).noalias() += (mu / m_dt) * quat_n;
+    }
+
+    /* ANCHOR: second kick, fixed-point iteration of v_out = v_half + h/2 a(x_out, v_out) */
+    // NOTE: the implicit kick keeps the step symmetric for velocity-dependent (hydrodynamic) forces
+    const double t_out{t1 + m_system->dt()};
+    m_rattle_vel_out.noalias() = m_rattle_vel_half;
+    m_rattle_vel_out.noalias() += m_c1_2_dt * m_rattle_acc_n;
+    projectQuaternionVelocities(m_rattle_pos_out, m_rattle_vel_out);
+
+    for (int iter = 1;; iter++)
+    {
+        // NOTE: last evaluation is at the output state, so it is carried forward to the next step
+        accelerationUpdate(t_out, m_rattle_pos_out, m_rattle_vel_out, m_rattle_acc_out, device);
+        m_num_rattle_iterations++;
+
+        if (iter == m_rattle_max_iter)
+        {
+            break;
+        }
+
+        m_rattle_vel_next.noalias() = m_rattle_vel_half;
+        m_rattle_vel_next.noalias() += m_c1_2_dt * m_rattle_acc_out;
+        projectQuaternionVelocities(m_rattle_pos_out, m_rattle_vel_next);
+
+        const double residual{(m_rattle_vel_next - m_rattle_vel_out).head(m_body_dof_7).norm()};
+
+        if (residual <= m_rattle_rel_tol * m_rattle_vel_next.head(m_body_dof_7).norm())
+        {
+            break;
+        }
+
+        m_rattle_vel_out.noalias() = m_rattle_vel_next;
+    }
+
+    // carry end of step evaluation forward to step 1 of next step
+    m_fsal_t             = t_out;
+    m_fsal_pos.noalias() = m_rattle_pos_out;
+    m_fsal_vel.noalias() = m_rattle_vel_out;
+    m_fsal_acc.noalias() = m_rattle_acc_out;
+    m_fsal_valid         = true;
+
+    // reset system time to t1 as `Engine` class manages updating system time at end of each step
+    m_system->setT(t1);
+}
+
+void
+RungeKutta4::projectQuaternionVelocities(const Eigen::VectorXd& pos, Eigen::VectorXd& vel) const
+{
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int quat_start{7 * body_id + 3};
+
+        const Eigen::Vector4d quat = pos.segment<4>(quat_start);
+
+        vel.segment<4>(quat_start) -= (quat.dot(vel.segment<4>(quat_start)) / quat.squaredNorm()) * quat;
+    }
+}
+
+void
+RungeKutta4::lieGroupState(const Eigen::VectorXd& pos_n, const Eigen::VectorXd& disp, const Eigen::VectorXd& nu,
+                           Eigen::VectorXd& pos, Eigen::VectorXd& vel) const
+{
+    pos.noalias() = pos_n;
+
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int body_id_6{6 * body_id};
+        const int body_id_7{7 * body_id};
+
+        // linear components
+        pos.segment<3>(body_id_7).noalias() += disp.segment<3>(body_id_6);
+        vel.segment<3>(body_id_7).noalias() = nu.segment<3>(body_id_6);
+
+        // quaternion components: q = exp(theta) q_n, dq/dt = (0, omega) q / 2
+        const Eigen::Quaterniond quat_n(pos_n(body_id_7 + 3), pos_n(body_id_7 + 4), pos_n(body_id_7 + 5),
+                                        pos_n(body_id_7 + 6));
+        const Eigen::Quaterniond quat = quaternionExp(disp.segment<3>(body_id_6 + 3)) * quat_n;
+
+        pos(body_id_7 + 3)            = quat.w();
+        pos.segment<3>(body_id_7 + 4) = quat.vec();
+
+        vel.segment<4>(body_id_7 + 3).noalias() =
+            0.50 * quaternionProductMatrix(pos.segment<4>(body_id_7 + 3)) * nu.segment<3>(body_id_6 + 3);
+    }
+}
+
+void
+RungeKutta4::lieGroupDerivative(const Eigen::VectorXd& disp, const Eigen::VectorXd& pos, const Eigen::VectorXd& vel,
+                                const Eigen::VectorXd& acc, Eigen::VectorXd& k_disp, Eigen::VectorXd& k_nu) const
+{
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int body_id_6{6 * body_id};
+        const int body_id_7{7 * body_id};
+
+        const Eigen::Quaterniond quat(pos(body_id_7 + 3), pos(body_id_7 + 4), pos(body_id_7 + 5), pos(body_id_7 + 6));
+        const Eigen::Quaterniond d_quat(vel(body_id_7 + 3), vel(body_id_7 + 4), vel(body_id_7 + 5),
+                                        vel(body_id_7 + 6));
+        const Eigen::Quaterniond dd_quat(acc(body_id_7 + 3), acc(body_id_7 + 4), acc(body_id_7 + 5),
+                                         acc(body_id_7 + 6));
+
+        const Eigen::Vector3d theta = disp.segment<3>(body_id_6 + 3);
+        const Eigen::Vector3d omega = 2.0 * (d_quat * quat.conjugate()).vec();
+
+        // linear components
+        k_disp.segment<3>(body_id_6).noalias() = vel.segment<3>(body_id_7);
+        k_nu.segment<3>(body_id_6).noalias()   = acc.segment<3>(body_id_7);
+
+        // inverse derivative of exponential map, truncated after the terms needed for 4th order
+        const Eigen::Vector3d theta_cross_omega = theta.cross(omega);
+
+        k_disp.segment<3>(body_id_6 + 3).noalias() = omega;
+        k_disp.segment<3>(body_id_6 + 3).noalias() -= 0.50 * theta_cross_omega;
+        k_disp.segment<3>(body_id_6 + 3).noalias() += (1.0 / 12.0) * theta.cross(theta_cross_omega);
+
+        // NOTE: d/dt (dq q^*) = ddq q^* + |dq|^2, whose vector part is only the first term
+        k_nu.segment<3>(body_id_6 + 3).noalias() = 2.0 * (dd_quat * quat.conjugate()).vec();
+    }
+}
+
+void
+RungeKutta4::lieGroupVelocity(const Eigen::VectorXd& pos, const Eigen::VectorXd& vel, Eigen::VectorXd& nu) const
+{
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int body_id_6{6 * body_id};
+        const int body_id_7{7 * body_id};
+
+        const Eigen::Quaterniond quat(pos(body_id_7 + 3), pos(body_id_7 + 4), pos(body_id_7 + 5), pos(body_id_7 + 6));
+        const Eigen::Quaterniond d_quat(vel(body_id_7 + 3), vel(body_id_7 + 4), vel(body_id_7 + 5),
+                                        vel(body_id_7 + 6));
+
+        nu.segment<3>(body_id_6).noalias()     = vel.segment<3>(body_id_7);
+        nu.segment<3>(body_id_6 + 3).noalias() = 2.0 * (d_quat * quat.conjugate()).vec();
+    }
+}
+
+Eigen::Quaterniond
+RungeKutta4::quaternionExp(const Eigen::Vector3d& theta)
+{
+    const double angle{theta.norm()};
+    const double half_angle{0.50 * angle};
+
+    // NOTE: sin(x / 2) / x from Taylor series for small angles to avoid division by zero
+    double sinc{0.50 - angle * angle / 48.0};
+    if (angle > 1.0e-4)
+    {
+        sinc = std::sin(half_angle) / angle;
+    }
+
+    return Eigen::Quaterniond(std::cos(half_angle), sinc * theta(0), sinc * theta(1), sinc * theta(2));
+}
+
+Eigen::Matrix<double, 4, 3>
+RungeKutta4::quaternionProductMatrix(const Eigen::Vector4d& quat)
+{
+    // (0, w) (q_0, q) = (-w . q, q_0 w + w x q)
+    Eigen::Matrix<double, 4, 3> E;
+
+    E.row(0) = -quat.tail<3>().transpose();
+
+    E.bottomRows<3>() << quat(0), quat(3), -quat(2), //
+        -quat(3), quat(0), quat(1),                  //
+        quat(2), -quat(1), quat(0);
+
+    return E;
+}
+
+bool
+RungeKutta4::dormandPrinceStep(const Eigen::ThreadPoolDevice& device)
+{
+    const double h{m_dp_h};                     // (dimensional)
+    const double h_t{m_dp_h / m_system->tau()}; // (non-dimensional)
+
+    /* ANCHOR: stage derivatives; first stage reuses acceleration at internal state */
+    m_dp_k_pos[0].noalias() = m_dp_vel;
+    m_dp_k_vel[0].noalias() = m_dp_acc;
+
+    for (int stage = 1; stage < 7; stage++)
+    {
+        m_dp_stage_pos.noalias() = m_dp_pos;
+        m_dp_stage_vel.noalias() = m_dp_vel;
+
+        for (int j = 0; j < stage; j++)
+        {
+            const double h_a{h * m_dp_a[stage][j]};
+
+            if (h_a == 0.0)
+            {
+                continue;
+            }
+
+            m_dp_stage_pos.noalias() += h_a * m_dp_k_pos[j];
+            m_dp_stage_vel.noalias() += h_a * m_dp_k_vel[j];
+        }
+
+        accelerationUpdate(m_dp_t + m_dp_c[stage] * h_t, m_dp_stage_pos, m_dp_stage_vel, m_dp_k_vel[stage], device);
+        m_dp_k_pos[stage].noalias() = m_dp_stage_vel;
+    }
+
+    /* ANCHOR: scaled RMS error of embedded solution over free body D.o.F. */
+    m_dp_err_pos.setZero();
+    m_dp_err_vel.setZero();
+
+    for (int j = 0; j < 7; j++)
+    {
+        m_dp_err_pos.noalias() += (h * m_dp_e[j]) * m_dp_k_pos[j].head(m_body_dof_7);
+        m_dp_err_vel.noalias() += (h * m_dp_e[j]) * m_dp_k_vel[j].head(m_body_dof_7);
+    }
+
+    // NOTE: last stage is at the 5th order solution. Scales are lazy expressions, so they are not allocated
+    const auto pos_max =
+        m_dp_pos.head(m_body_dof_7).array().abs().max(m_dp_stage_pos.head(m_body_dof_7).array().abs());
+    const auto vel_max =
+        m_dp_vel.head(m_body_dof_7).array().abs().max(m_dp_stage_vel.head(m_body_dof_7).array().abs());
+
+    const double err{std::sqrt(((m_dp_err_pos.array() / (m_atol + m_rtol * pos_max)).square().sum() +
+                                (m_dp_err_vel.array() / (m_atol + m_rtol * vel_max)).square().sum()) /
+                               (2.0 * m_body_dof_7))};
+
+    /* ANCHOR: step size control */
+    double factor{m_dp_max_factor};
+    if (err > 0.0)
+    {
+        factor = std::min(m_dp_max_factor, std::max(m_dp_min_factor, m_dp_safety * std::pow(err, -0.20)));
+    }
+
+    if (err > 1.0)
+    {
+        m_num_steps_rejected++;
+        m_dp_h *= std::min(1.0, factor);
+
+        if (m_dp_h < m_dp_h_min)
+        {
+            spdlog::get(m_logName)->error("Adaptive step size underflow at t={0}", m_dp_t);
+            throw std::runtime_error("Adaptive step size underflow");
+        }
+
+        return false;
+    }
+
+    m_num_steps_accepted++;
+
+    m_dp_t_prev             = m_dp_t;
+    m_dp_pos_prev.noalias() = m_dp_pos;
+    m_dp_vel_prev.noalias() = m_dp_vel;
+    m_dp_acc_prev.noalias() = m_dp_acc;
+
+    m_dp_t += h_t;
+    m_dp_pos.noalias() = m_dp_stage_pos;
+    m_dp_vel.noalias() = m_dp_stage_vel;
+    m_dp_acc.noalias() = m_dp_k_vel[6];
+
+    m_dp_h *= factor;
+
+    return true;
+}
+
+void
+RungeKutta4::dormandPrinceDenseOutput(const double theta, const double h, const Eigen::VectorXd& y_prev,
+                                      const Eigen::VectorXd& y, const std::array<Eigen::VectorXd, 7>& k,
+                                      Eigen::VectorXd& y_out) const
+{
+    /* NOTE: y(theta) = y_prev + theta (dy + (1 - theta) (r_3 + theta (r_4 + (1 - theta) r_5))), with dy = y - y_prev,
+     * r_3 = h k_1 - dy, r_4 = dy - h k_7 - r_3 and r_5 = h sum_j d_j k_j, expanded into weights of y and k_j */
+    const double theta_1{1.0 - theta};
+    const double theta2_1{theta * theta * theta_1};
+    const double theta2_11{theta2_1 * theta_1};
+
+    const double b_dy{theta - theta * theta_1 + 2.0 * theta2_1};
+
+    y_out.noalias() = (1.0 - b_dy) * y_prev;
+    y_out.noalias() += b_dy * y;
+
+    for (int j = 0; j < 7; j++)
+    {
+        double b_j{theta2_11 * m_dp_d[j]};
+
+        if (j == 0)
+        {
+            b_j += theta * theta_1 - theta2_1;
+        }
+        if (j == 6)
+        {
+            b_j -= theta2_1;
+        }
+
+        y_out.noalias() += (h * b_j) * k[j];
+    }
+}
+
+bool
+RungeKutta4::fsalValid(const double t, const Eigen::VectorXd& pos, const Eigen::VectorXd& vel) const
+{
+    /* NOTE: exact comparison, as any modification of the body state between steps (e.g. `Engine` normalizing
+     * quaternions on output frames of fixed time steps) changes the acceleration and must invalidate the cached
+     * evaluation */
+    return m_fsal_valid && (t == m_fsal_t) && (pos == m_fsal_pos) && (vel == m_fsal_vel);
+}
+
 void
 RungeKutta4::accelerationUpdate(const double t, Eigen::VectorXd& pos, Eigen::VectorXd& vel, Eigen::VectorXd& acc,
                                 const Eigen::ThreadPoolDevice& device)
 {
+    m_num_acceleration_updates++;
+
     // NOTE: Order of function calls must remain the same
     m_system->setT(t);
 
@@ -211,22 +897,93 @@ RungeKutta4::accelerationUpdate(const double t, Eigen::VectorXd& pos, Eigen::Vec
 
     if (m_system->imageSystem())
     {
-        Eigen::VectorXd acc_real_body = acc.segment(0, m_body_dof_7);
-        udwadiaKalaba(acc_real_body);
+        m_acc_real_body.noalias() = acc.segment(0, m_body_dof_7);
+        bodyAcceleration(m_acc_real_body);
 
         // update acceleration components using constraints
-        acc.segment(0, m_body_dof_7) = acc_real_body;
+        acc.segment(0, m_body_dof_7) = m_acc_real_body;
         imageBodyAcc(acc);
     }
     else
     {
         // update Udwadia system for all bodies
-        udwadiaKalaba(acc);
+        bodyAcceleration(acc);
     }
 
     m_system->setAccelerationsBodies(acc);
 }
 
+void
+RungeKutta4::bodyAcceleration(Eigen::VectorXd& acc)
+{
+    if (m_integrator_scheme == IntegratorScheme::LieGroup)
+    {
+        reducedCoordinateAcc(acc);
+    }
+    else
+    {
+        udwadiaKalaba(acc);
+    }
+}
+
+void
+RungeKutta4::reducedCoordinateAcc(Eigen::VectorXd& acc)
+{
+    const auto M_eff = m_potHydro->mTotalBodyCoords().topLeftCorner(m_body_dof_7, m_body_dof_7); // (7m, 7m)
+
+    const Eigen::VectorXd& pos = m_system->positionsBodies();
+    const Eigen::VectorXd& vel = m_system->velocitiesBodies();
+
+    // unconstrained forces
+    m_red_Q.setZero(); // (7m, 1)
+
+    if (m_system->fluidDensity() > 0)
+    {
+        m_red_Q.noalias() += m_potHydro->fHydroNoInertia().segment(0, m_body_dof_7);
+    }
+
+    /* ANCHOR: velocity map T and its time derivative (dT/dt nu)
+     * NOTE: entries outside of the quaternion blocks and of the linear identity blocks stay zero from construction */
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int body_id_6{6 * body_id};
+        const int body_id_7{7 * body_id};
+
+        const Eigen::Vector4d quat   = pos.segment<4>(body_id_7 + 3);
+        const Eigen::Vector4d d_quat = vel.segment<4>(body_id_7 + 3);
+
+        const Eigen::Quaterniond quat_q(quat(0), quat(1), quat(2), quat(3));
+        const Eigen::Quaterniond d_quat_q(d_quat(0), d_quat(1), d_quat(2), d_quat(3));
+        const Eigen::Vector3d    omega = 2.0 * (d_quat_q * quat_q.conjugate()).vec();
+
+        m_red_T.block<3, 3>(body_id_7, body_id_6).setIdentity();
+        m_red_T.block<4, 3>(body_id_7 + 3, body_id_6 + 3).noalias() = 0.50 * quaternionProductMatrix(quat);
+
+        m_red_T_dot_nu.segment<4>(body_id_7 + 3).noalias() = 0.50 * quaternionProductMatrix(d_quat) * omega;
+    }
+
+    /* ANCHOR: reduced equations of motion */
+    m_red_M_T.noalias() = M_eff * m_red_T;                 // (7m, 6m)
+    m_red_M.noalias()   = m_red_T.transpose() * m_red_M_T; // (6m, 6m)
+
+    m_red_Q.noalias() -= M_eff * m_red_T_dot_nu;
+    m_red_Q_red.noalias() = m_red_T.transpose() * m_red_Q; // (6m, 1)
+
+    m_red_llt.compute(m_red_M);
+
+    if (m_red_llt.info() != Eigen::Success)
+    {
+        spdlog::get(m_logName)->error("Computing Cholesky factorization of reduced mass matrix failed at t={0}",
+                                      m_system->t());
+        throw std::runtime_error("Computing Cholesky factorization of reduced mass matrix failed");
+    }
+
+    m_red_nu_dot.noalias() = m_red_llt.solve(m_red_Q_red); // (6m, 1)
+
+    acc.noalias() = m_red_T_dot_nu;
+    acc.noalias() += m_red_T * m_red_nu_dot;
+}
+
 void
 RungeKutta4::imageBodyPosVel(Eigen::VectorXd& pos, Eigen::VectorXd& vel)
 {
@@ -270,12 +1027,153 @@ RungeKutta4::imageBodyAcc(Eigen::VectorXd& acc)
 void
 RungeKutta4::udwadiaKalaba(Eigen::VectorXd& acc)
 {
+    if (m_udwadia_solver == UdwadiaSolver::Iterative)
+    {
+        udwadiaKalabaIterative(acc);
+        return;
+    }
+
+    // NOTE: compile-time sizes for collinear swimmer systems (1 free body, or 2 free bodies without image system)
+    if (m_body_dof == 1)
+    {
+        udwadiaKalabaSized<7, 1>(acc);
+    }
+    else if (m_body_dof == 2)
+    {
+        udwadiaKalabaSized<14, 2>(acc);
+    }
+    else
+    {
+        udwadiaKalabaSized<Eigen::Dynamic, Eigen::Dynamic>(acc);
+    }
+}
+
+void
+RungeKutta4::udwadiaKalabaIterative(Eigen::VectorXd& acc)
+{
+    const auto             M_eff = m_potHydro->mTotalBodyCoords().topLeftCorner(m_body_dof_7, m_body_dof_7); // (7m, 7m)
+    const Eigen::MatrixXd& A     = m_system->udwadiaA();                                                     // (c, 7M)
+    const Eigen::VectorXd& b     = m_system->udwadiaB();                                                     // (c, 1)
+
+    // unconstrained forces
+    m_cg_Q.setZero(); // (7m, 1)
+
+    if (m_system->fluidDensity() > 0)
+    {
+        m_cg_Q.noalias() += m_potHydro->fHydroNoInertia().segment(0, m_body_dof_7);
+    }
+
+    // orthogonal projection onto null space of A, quaternion components of each body only
+    const auto project = [&](Eigen::VectorXd& vec) {
+        for (int body_id = 0; body_id < m_body_dof; body_id++)
+        {
+            const int quat_start{7 * body_id + 3};
+
+            const Eigen::Vector4d quat = A.row(body_id).segment<4>(quat_start).transpose();
+
+            vec.segment<4>(quat_start) -= (quat.dot(vec.segment<4>(quat_start)) / quat.squaredNorm()) * quat;
+        }
+    };
+
+    // projected block-Jacobi preconditioner
+    const auto precondition = [&](const Eigen::VectorXd& res, Eigen::VectorXd& z) {
+        for (int body_id = 0; body_id < m_body_dof; body_id++)
+        {
+            z.segment<7>(7 * body_id) = m_block_jacobi_llt[body_id].solve(res.segment<7>(7 * body_id));
+        }
+
+        project(z);
+    };
+
+    /* ANCHOR: block-Jacobi factorization and particular solution of constraints */
+    m_cg_acc_p.setZero(); // (7m, 1)
+
+    for (int body_id = 0; body_id < m_body_dof; body_id++)
+    {
+        const int body_id_7{7 * body_id};
+        const int quat_start{body_id_7 + 3};
+
+        m_block_jacobi_llt[body_id].compute(M_eff.block<7, 7>(body_id_7, body_id_7));
+
+        if (m_block_jacobi_llt[body_id].info() != Eigen::Success)
+        {
+            spdlog::get(m_logName)->error(
+                "Computing Cholesky factorization of effective mass block of body {0} failed at t={1}", body_id,
+                m_system->t());
+            throw std::runtime_error("Computing Cholesky factorization of effective mass block failed");
+        }
+
+        const Eigen::Vector4d quat = A.row(body_id).segment<4>(quat_start).transpose();
+
+        m_cg_acc_p.segment<4>(quat_start) = (b(body_id) / quat.squaredNorm()) * quat;
+    }
+
+    /* ANCHOR: projected preconditioned conjugate gradient in null space of A */
+    m_cg_y.setZero();            // (7m, 1)
+    m_cg_res.noalias() = m_cg_Q; // (7m, 1)
+
+    m_cg_res.noalias() -= M_eff * m_cg_acc_p;
+    project(m_cg_res);
+
+    const double res_norm_0{m_cg_res.norm()};
+    const int    max_iter{2 * m_body_dof_7};
+
+    precondition(m_cg_res, m_cg_z);
+    m_cg_dir.noalias() = m_cg_z;
+    double res_dot_z{m_cg_res.dot(m_cg_z)};
+
+    int iter{0};
+
+    while ((m_cg_res.norm() > m_cg_rel_tol * res_norm_0) && (iter < max_iter))
+    {
+        m_cg_M_dir.noalias() = M_eff * m_cg_dir;
+
+        const double step{res_dot_z / m_cg_dir.dot(m_cg_M_dir)};
+
+        m_cg_y.noalias() += step * m_cg_dir;
+        m_cg_res.noalias() -= step * m_cg_M_dir;
+        project(m_cg_res);
+
+        precondition(m_cg_res, m_cg_z);
+
+        const double res_dot_z_new{m_cg_res.dot(m_cg_z)};
+
+        m_cg_dir *= res_dot_z_new / res_dot_z;
+        m_cg_dir.noalias() += m_cg_z;
+        res_dot_z = res_dot_z_new;
+
+        iter++;
+    }
+
+    m_num_cg_iterations += iter;
+
+    if (m_cg_res.norm() > m_cg_rel_tol * res_norm_0)
+    {
+        spdlog::get(m_logName)->warn("Conjugate gradient did not converge in {0} iterations at t={1}: residual {2}",
+                                     max_iter, m_system->t(), m_cg_res.norm() / res_norm_0);
+    }
+
+    acc.segment(0, m_body_dof_7) = m_cg_acc_p;
+    acc.segment(0, m_body_dof_7).noalias() += m_cg_y;
+}
+
+template <int BodyDof7, int NumConstraints>
+void
+RungeKutta4::udwadiaKalabaSized(Eigen::VectorXd& acc)
+{
+    using MatrixDD = Eigen::Matrix<double, BodyDof7, BodyDof7>;
+    using MatrixDC = Eigen::Matrix<double, BodyDof7, NumConstraints>;
+    using MatrixCD = Eigen::Matrix<double, NumConstraints, BodyDof7>;
+    using MatrixCC = Eigen::Matrix<double, NumConstraints, NumConstraints>;
+    using VectorD  = Eigen::Matrix<double, BodyDof7, 1>;
+    using VectorC  = Eigen::Matrix<double, NumConstraints, 1>;
+
     /* NOTE: Following the formalism developed in Udwadia & Kalaba (1992) Proc. R. Soc. Lond. A
      * Solve system of the form M_eff * acc = Q + Q_con
      * Q is the forces present in unconstrained system
      * Q_con is the generalized constraint forces */
     // calculate Q
-    Eigen::VectorXd Q = Eigen::VectorXd::Zero(m_body_dof_7); // (7m, 1)
+    VectorD Q = VectorD::Zero(m_body_dof_7); // (7m, 1)
 
     // hydrodynamic force
     if (m_system->fluidDensity() > 0)
@@ -288,9 +1186,76 @@ RungeKutta4::udwadiaKalaba(Eigen::VectorXd& acc)
      * Linear proportionality: K = M_eff^{1/2} * (A * M_eff^{-1/2})^{+};
      * + is Moore-Penrose inverse */
 
-    const Eigen::MatrixXd M_eff = m_potHydro->mTotalBodyCoords().block(0, 0, m_body_dof_7, m_body_dof_7); // (7m, 7m)
+    const MatrixDD M_eff = m_potHydro->mTotalBodyCoords().block(0, 0, m_body_dof_7, m_body_dof_7); // (7m, 7m)
+    const MatrixCD A     = m_system->udwadiaA();                                                  // (c, 7m)
 
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver(M_eff);
+    if (m_udwadia_solver == UdwadiaSolver::Cholesky)
+    {
+        const int num_constraints{static_cast<int>(A.rows())};
+
+        // unconstrained accelerations and constraint directions
+        VectorD  acc_free = VectorD::Zero(m_body_dof_7);                  // (7m, 1)
+        MatrixDC Y        = MatrixDC::Zero(m_body_dof_7, num_constraints); // (7m, c) = M_eff^{-1} A^T
+
+        if (m_udwadia_refactor_tol > 0.0)
+        {
+            // NOTE: workspaces are dynamic-size, so fixed-size matrices are copied instead of converted to temporaries
+            if (m_reuse_rhs.cols() != 1 + num_constraints)
+            {
+                m_reuse_rhs        = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + num_constraints);
+                m_reuse_sol        = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + num_constraints);
+                m_reuse_residual   = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + num_constraints);
+                m_reuse_correction = Eigen::MatrixXd::Zero(m_body_dof_7, 1 + num_constraints);
+            }
+
+            m_reuse_M_eff                          = M_eff;
+            m_reuse_rhs.col(0)                     = Q;
+            m_reuse_rhs.rightCols(num_constraints) = A.transpose();
+
+            solveEffectiveMassReuse(m_reuse_M_eff, m_reuse_rhs, m_reuse_sol);
+
+            acc_free = m_reuse_sol.col(0);
+            Y        = m_reuse_sol.rightCols(num_constraints);
+        }
+        else
+        {
+            const Eigen::LLT<MatrixDD> llt(M_eff);
+            m_num_mass_factorizations++;
+
+            if (llt.info() != Eigen::Success)
+            {
+                spdlog::get(m_logName)->error(
+                    "Computing Cholesky factorization of effective total mass matrix failed at t={0}", m_system->t());
+                throw std::runtime_error("Computing Cholesky factorization of effective total mass matrix failed");
+            }
+
+            acc_free.noalias() = llt.solve(Q);
+            Y.noalias()        = llt.solve(A.transpose());
+        }
+
+        /* NOTE: row i of A only contains the quaternion of body i, so products with A only need those 4 columns:
+         * S = A M_eff^{-1} A^T and b - A a */
+        MatrixCC S        = MatrixCC::Zero(num_constraints, num_constraints); // (c, c)
+        VectorC  residual = m_system->udwadiaB();                             // (c, 1)
+
+        for (int constraint_id = 0; constraint_id < num_constraints; constraint_id++)
+        {
+            const int quat_start{7 * constraint_id + 3};
+
+            const Eigen::Vector4d quat = A.row(constraint_id).template segment<4>(quat_start).transpose();
+
+            S.row(constraint_id).noalias() = quat.transpose() * Y.template middleRows<4>(quat_start);
+            residual(constraint_id) -= quat.dot(acc_free.template segment<4>(quat_start));
+        }
+
+        const VectorC lambda = S.llt().solve(residual); // (c, 1)
+
+        acc.noalias() = acc_free;
+        acc.noalias() += Y * lambda;
+        return;
+    }
+
+    Eigen::SelfAdjointEigenSolver<MatrixDD> eigensolver(M_eff);
 
     // compute eigen-decomposition of M_eff
     if (eigensolver.info() != Eigen::Success)
@@ -309,28 +1274,82 @@ RungeKutta4::udwadiaKalaba(Eigen::VectorXd& acc)
 #endif
 
     // calculate M^{1/2} & M^{-1/2}
-    const Eigen::MatrixXd M_eff_halfPower         = eigensolver.operatorSqrt();        // (7m, 7m)
-    const Eigen::MatrixXd M_eff_negativeHalfPower = eigensolver.operatorInverseSqrt(); // (7m, 7m)
-
-    // calculate K
-    const Eigen::MatrixXd AM_nHalf      = m_system->udwadiaA() * M_eff_negativeHalfPower; // (c, 7m) = (c, 7m) (7m, 7m)
-    const Eigen::MatrixXd AM_nHalf_pInv = AM_nHalf.completeOrthogonalDecomposition().pseudoInverse(); // (7m, c)
-    const Eigen::MatrixXd K             = M_eff_halfPower * AM_nHalf_pInv;                            // (7m, c)
+    const MatrixDD M_eff_halfPower         = eigensolver.operatorSqrt();        // (7m, 7m)
+    const MatrixDD M_eff_negativeHalfPower = eigensolver.operatorInverseSqrt(); // (7m, 7m)
+
+    /* calculate K
+     * NOTE: rows of A hold the unit quaternions of distinct bodies, so X = A M^{-1/2} has full row rank and its
+     * Moore-Penrose inverse is X^T (X X^T)^{-1}. Unlike a complete orthogonal decomposition, the (c x c) Cholesky
+     * solve needs no heap workspace for compile-time sizes */
+    const MatrixCD AM_nHalf      = A * M_eff_negativeHalfPower;                               // (c, 7m) = (c, 7m) (7m, 7m)
+    const MatrixCC AM_nHalf_sq   = AM_nHalf * AM_nHalf.transpose();                           // (c, c)
+    const MatrixCD AM_nHalf_rInv = AM_nHalf_sq.llt().solve(AM_nHalf);                         // (c, 7m)
+    const MatrixDC AM_nHalf_pInv = AM_nHalf_rInv.transpose();                                 // (7m, c)
+    const MatrixDC K             = M_eff_halfPower * AM_nHalf_pInv;                           // (7m, c)
 
     // calculate Q_con
-    const Eigen::MatrixXd M_eff_inv   = M_eff.inverse();                   // (7m, 7m)
-    const Eigen::MatrixXd M_eff_invQ  = M_eff_inv * Q;                     // (7m, 1)
-    const Eigen::VectorXd AM_eff_invQ = m_system->udwadiaA() * M_eff_invQ; // (c, 1) = (c, 7m) (7m, 1)
-    Eigen::VectorXd       b_tilde     = m_system->udwadiaB();              // (c, 1)
+    const MatrixDD M_eff_inv   = M_eff.inverse();      // (7m, 7m)
+    const VectorD  M_eff_invQ  = M_eff_inv * Q;        // (7m, 1)
+    const VectorC  AM_eff_invQ = A * M_eff_invQ;       // (c, 1) = (c, 7m) (7m, 1)
+    VectorC        b_tilde     = m_system->udwadiaB(); // (c, 1)
     b_tilde.noalias() -= AM_eff_invQ;
-    const Eigen::VectorXd Q_con = K * b_tilde; // (7m, 1) = (7m, c) (c, 1)
+    const VectorD Q_con = K * b_tilde; // (7m, 1) = (7m, c) (c, 1)
 
     // calculate accelerations
-    Eigen::VectorXd Q_total = Q; // (7m, 1)
+    VectorD Q_total = Q; // (7m, 1)
     Q_total.noalias() += Q_con;
     acc.noalias() = M_eff_inv * Q_total; // (7m, 1)
 }
 
+void
+RungeKutta4::solveEffectiveMassReuse(const Eigen::MatrixXd& M_eff, const Eigen::MatrixXd& rhs, Eigen::MatrixXd& sol)
+{
+    const double rhs_norm{rhs.norm()};
+
+    /* ANCHOR: iterative refinement preconditioned with previous factorization */
+    if (m_M_eff_llt_valid && (m_M_eff_llt.rows() == M_eff.rows()))
+    {
+        sol.noalias() = m_M_eff_llt.solve(rhs);
+
+        m_reuse_residual.noalias() = rhs;
+        m_reuse_residual.noalias() -= M_eff * sol;
+
+        for (int iter = 0; iter < m_refine_max_iter; iter++)
+        {
+            if (m_reuse_residual.norm() <= m_udwadia_refactor_tol * rhs_norm)
+            {
+                return;
+            }
+
+            m_reuse_correction.noalias() = m_M_eff_llt.solve(m_reuse_residual);
+            sol.noalias() += m_reuse_correction;
+
+            m_reuse_residual.noalias() = rhs;
+            m_reuse_residual.noalias() -= M_eff * sol;
+        }
+
+        if (m_reuse_residual.norm() <= m_udwadia_refactor_tol * rhs_norm)
+        {
+            return;
+        }
+    }
+
+    /* ANCHOR: refactorize at current effective mass matrix */
+    m_M_eff_llt.compute(M_eff);
+    m_num_mass_factorizations++;
+
+    if (m_M_eff_llt.info() != Eigen::Success)
+    {
+        m_M_eff_llt_valid = false;
+        spdlog::get(m_logName)->error("Computing Cholesky factorization of effective total mass matrix failed at t={0}",
+                                      m_system->t());
+        throw std::runtime_error("Computing Cholesky factorization of effective total mass matrix failed");
+    }
+
+    m_M_eff_llt_valid = true;
+    sol.noalias()     = m_M_eff_llt.solve(rhs);
+}
+
 void
 RungeKutta4::momForceFree(const Eigen::ThreadPoolDevice& device)
 {
@@ -362,15 +1381,14 @@ RungeKutta4::momForceFree(const Eigen::ThreadPoolDevice& device)
         for (int j = 0; j < num_particles; j++)
         {
             M_eff.block<3, 3>(particle_id_3, 3 * j).noalias() =
-                m_potHydro->mTotal().block<3, 3>(particle_id_7, 7 * j); // translation-translation couple
+                m_potHydro->mTotalLinearBlock(particle_id, j); // translation-translation couple
 
             for (int k = 0; k < (0 + num_particles); k++)
             {
-                const Eigen::array<Eigen::Index, 3> offsets_3   = {particle_id_3, 3 * j, 3 * k};
-                const Eigen::array<Eigen::Index, 3> offsets_773 = {particle_id_7, 7 * j, 3 * k};
+                const Eigen::array<Eigen::Index, 3> offsets_3 = {particle_id_3, 3 * j, 3 * k};
 
-                grad_M_eff.slice(offsets_3, extents_333).device(device) =
-                    m_potHydro->gradMAdded().slice(offsets_773, extents_333);
+                evaluateTensor(device, 27, grad_M_eff.slice(offsets_3, extents_333),
+                               m_potHydro->gradMAdded().element(particle_id, j, k));
             }
         }
 
@@ -439,7 +1457,7 @@ RungeKutta4::momForceFree(const Eigen::ThreadPoolDevice& device)
 
     // convert particle velocities to `Eigen::Tensor`
     Eigen::Tensor<double, 1> tens_vel_part = Eigen::Tensor<double, 1>(num_particles_3);
-    tens_vel_part.device(device)           = TensorCast(vel_part, num_particles_3);
+    evaluateTensor(device, num_particles_3, tens_vel_part, TensorCast(vel_part, num_particles_3));
 
     // `Eigen::Tensor` contract indices
     const Eigen::array<Eigen::IndexPair<int>, 1> contract_ijl_l = {
@@ -447,8 +1465,8 @@ RungeKutta4::momForceFree(const Eigen::ThreadPoolDevice& device)
 
     // calculate gradM U
     Eigen::Tensor<double, 2> tens_gradM_U = Eigen::Tensor<double, 2>(num_particles_3, num_particles_3);
-    tens_gradM_U.device(device)           = grad_M_eff.contract(tens_vel_part, contract_ijl_l);
-    const Eigen::MatrixXd gradM_U         = MatrixCast(tens_gradM_U, num_particles_3, num_particles_3, device);
+    evaluateTensor(device, grad_M_eff.size(), tens_gradM_U, grad_M_eff.contract(tens_vel_part, contract_ijl_l));
+    const Eigen::MatrixXd gradM_U = MatrixCast(tens_gradM_U, num_particles_3, num_particles_3, device);
 
     /* STUB: Solve for rigid body motion velocity components */
     // calculate F_script = Sigma * (M_total * A_articulation + (gradM U) U);  (3 x 1)
@@ -29,9 +29,17 @@
 #include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
 // eigen3 conversion between Eigen::Tensor (unsupported) and Eigen::Matrix
 #include <helper_eigenTensorConversion.hpp>
+// eigen3 size-aware evaluation of tensor expressions
+#include <helper_eigenExecutionPolicy.hpp>
 // Logging
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
+// STL
+#include <algorithm> // std::min, std::max
+#include <array>     // std::array
+#include <cmath>     // std::pow, std::sqrt
+#include <stdexcept> // std::errors
+#include <vector>    // std::vector
 // Debugging
 #include <iostream>
 
@@ -70,6 +78,11 @@ class RungeKutta4
     /**
      * @brief Public function to call internal numerical Runge Kutta integration functions.
      *
+     * @details Advances the system by `SystemData::dt()` with `integrateSecondOrder()` (fixed time step), or with
+     * `integrateAdaptive()` if either `SystemData::adaptiveAtol()` or `SystemData::adaptiveRtol()` is positive.
+     * `SystemData::integratorScheme()` set to `IntegratorScheme::LieGroup` uses `integrateLieGroup()` instead, and
+     * `IntegratorScheme::Rattle` uses `integrateRattle()`.
+     *
      * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
      */
     void
@@ -81,6 +94,8 @@ class RungeKutta4
      * and then positional components.
      *
      * @details Solve system of form: @f$ y'(t) = f( y(t),  t ) @f$
+     * The acceleration evaluated at the end of each step is reused as step 1 of the next step (first-same-as-last)
+     * if the body state was not modified in between, see `fsalValid()`.
      *
      * @see **Reference:**
      * https://www.physicsforums.com/threads/using-runge-kutta-method-for-position-calc.553663/post-3634957
@@ -90,6 +105,210 @@ class RungeKutta4
     void
     integrateSecondOrder(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Adaptive Dormand-Prince 5(4) integration of the body D.o.F. to time `SystemData::t()` +
+     * `SystemData::dt()`.
+     *
+     * @details Internal steps are taken with `dormandPrinceStep()` and their size is independent of
+     * `SystemData::dt()`, so they may extend past the target time and are carried over to the next call.
+     * The body state at the target time is interpolated with the continuous extension of the last accepted step
+     * (dense output, see `dormandPrinceDenseOutput()`), its quaternions are normalized, and `SystemData` and
+     * `PotentialHydrodynamics` are updated at the interpolated state.
+     * Internal stepping restarts from the `SystemData` body state if it was modified between calls (see
+     * `fsalValid()`), e.g. by a stroboscopic macro-step. `Engine` therefore does not normalize quaternions on output
+     * frames in adaptive mode.
+     *
+     * @see **Reference:** Hairer, Norsett, Wanner. Solving Ordinary Differential Equations I (1993), Sec. II.4-II.6.
+     *
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    integrateAdaptive(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Lie-group Runge-Kutta-Munthe-Kaas integration with the stages of `integrateSecondOrder()`.
+     *
+     * @details Body orientations are advanced on the unit quaternions as @f$ \boldsymbol{q}_{n+1} =
+     * \exp(\boldsymbol{\theta}) \otimes \boldsymbol{q}_n @f$, see `quaternionExp()`, where the rotation vector
+     * @f$ \boldsymbol{\theta} @f$ is integrated in the Lie algebra from the (space-frame) angular velocities as
+     * @f$ \dot{\boldsymbol{\theta}} = \mathrm{dexp}^{-1}_{\boldsymbol{\theta}}(\boldsymbol{\omega}) \approx
+     * \boldsymbol{\omega} - \frac{1}{2} \boldsymbol{\theta} \times \boldsymbol{\omega} + \frac{1}{12}
+     * \boldsymbol{\theta} \times (\boldsymbol{\theta} \times \boldsymbol{\omega}) @f$.
+     * Linear positions, linear velocities and angular velocities (6 D.o.F. per body) are integrated as in
+     * `integrateSecondOrder()`.
+     * Quaternions therefore stay unit by construction and accelerations are found without the Udwadia-Kalaba
+     * constraint solve, see `reducedCoordinateAcc()`.
+     * The first-same-as-last reuse of the end-of-step acceleration is the same as in `integrateSecondOrder()`.
+     *
+     * @see **Reference:** Munthe-Kaas, Hans. "High order Runge-Kutta methods on manifolds." Applied Numerical
+     * Mathematics 29.1 (1999): 115-127.
+     *
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    integrateLieGroup(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief RATTLE (velocity Verlet with unit quaternion constraints) integration.
+     *
+     * @details Kick-drift-kick splitting:
+     * @f$ \dot{\boldsymbol{\xi}}_{n+1/2} = \dot{\boldsymbol{\xi}}_n + \frac{h}{2} \ddot{\boldsymbol{\xi}}_n @f$,
+     * @f$ \boldsymbol{\xi}_{n+1} = \boldsymbol{\xi}_n + h \dot{\boldsymbol{\xi}}_{n+1/2} @f$,
+     * @f$ \dot{\boldsymbol{\xi}}_{n+1} = \dot{\boldsymbol{\xi}}_{n+1/2} + \frac{h}{2}
+     * \ddot{\boldsymbol{\xi}}_{n+1} @f$.
+     * After the drift, each quaternion is moved along its previous value, @f$ \boldsymbol{q}_{n+1} =
+     * \tilde{\boldsymbol{q}}_{n+1} + \mu \boldsymbol{q}_n @f$, with the root @f$ \mu @f$ of smallest magnitude
+     * that restores the unit norm, and the half step quaternion velocity is corrected by @f$ \mu / h
+     * \, \boldsymbol{q}_n @f$.
+     * After the final kick, quaternion velocities are projected onto the tangent space @f$ \boldsymbol{q}_{n+1}
+     * \cdot \dot{\boldsymbol{q}}_{n+1} = 0 @f$ along @f$ \boldsymbol{q}_{n+1} @f$.
+     * RATTLE applies constraint forces along @f$ \boldsymbol{M}^{-1} \boldsymbol{G}^{\mathrm{T}} @f$, with
+     * @f$ \boldsymbol{M} @f$ the effective body mass matrix and @f$ \boldsymbol{G} @f$ the gradient of the unit
+     * quaternion constraints, whose row @f$ b @f$ holds @f$ \boldsymbol{q}_b @f$. The translation-quaternion blocks of
+     * `SystemData::rbmConnBlock()` vanish on @f$ \boldsymbol{q}_b @f$ (@f$ \boldsymbol{E}(\boldsymbol{q})
+     * \boldsymbol{q} @f$ only has a scalar part), and the quaternion-quaternion blocks map it onto the isotropic
+     * intrinsic quaternion mass of the particles, so @f$ \boldsymbol{M} \boldsymbol{G}^{\mathrm{T}} =
+     * \boldsymbol{G}^{\mathrm{T}} \boldsymbol{C} @f$ with @f$ \boldsymbol{C} @f$ diagonal and positive. The
+     * mass-weighted directions are then the quaternions themselves, and the projections above are the mass-weighted
+     * ones without factoring @f$ \boldsymbol{M} @f$.
+     * Hydrodynamic forces depend on velocities, so the final kick is implicit in @f$ \dot{\boldsymbol{\xi}}_{n+1} @f$
+     * and solved by fixed-point iteration from the predicted velocities @f$ \dot{\boldsymbol{\xi}}_{n+1/2} +
+     * \frac{h}{2} \ddot{\boldsymbol{\xi}}_n @f$.
+     * Each iteration costs one acceleration update, and at most `m_rattle_max_iter` (default 2) are taken, so a step
+     * costs at most two acceleration updates instead of four for `integrateSecondOrder()`.
+     * The predictor error is @f$ \mathcal{O}(h^2) @f$ and each iteration contracts it by @f$ \mathcal{O}(h) @f$, so
+     * two iterations are within the @f$ \mathcal{O}(h^3) @f$ local truncation error and the scheme stays second
+     * order. It is time-reversible if the iterations converge (relative change below `m_rattle_rel_tol`).
+     * The accelerations of the last iteration are at the output state and are carried forward to the first kick of
+     * the next step (first-same-as-last).
+     *
+     * @see **Reference:** Andersen, Hans C. "Rattle: A "velocity" version of the shake algorithm for molecular
+     * dynamics calculations." Journal of Computational Physics 52.1 (1983): 24-34.
+     *
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     */
+    void
+    integrateRattle(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Projects the quaternion velocities onto the tangent space of the unit quaternions,
+     * @f$ \boldsymbol{q} \cdot \dot{\boldsymbol{q}} = 0 @f$, along the quaternions
+     *
+     * @param pos (7M x 1) body positions
+     * @param vel (7M x 1) body velocities to project
+     */
+    void
+    projectQuaternionVelocities(const Eigen::VectorXd& pos, Eigen::VectorXd& vel) const;
+
+    /**
+     * @brief Body positions and velocities of a Lie-group stage.
+     *
+     * @param pos_n (7M x 1) body positions at start of step
+     * @param disp (6m x 1) linear displacements and rotation vectors of free bodies
+     * @param nu (6m x 1) linear and (space-frame) angular velocities of free bodies
+     * @param pos (output) (7M x 1) body positions, image bodies are copied from `pos_n`
+     * @param vel (output) (7M x 1) body velocities, image bodies are left unchanged
+     */
+    void
+    lieGroupState(const Eigen::VectorXd& pos_n, const Eigen::VectorXd& disp, const Eigen::VectorXd& nu,
+                  Eigen::VectorXd& pos, Eigen::VectorXd& vel) const;
+
+    /**
+     * @brief Lie algebra derivatives of a Lie-group stage.
+     *
+     * @param disp (6m x 1) linear displacements and rotation vectors of free bodies
+     * @param pos (7M x 1) body positions
+     * @param vel (7M x 1) body velocities
+     * @param acc (7M x 1) body accelerations
+     * @param k_disp (output) (6m x 1) linear velocities and @f$ \mathrm{dexp}^{-1}_{\boldsymbol{\theta}}
+     * (\boldsymbol{\omega}) @f$
+     * @param k_nu (output) (6m x 1) linear and angular accelerations
+     */
+    void
+    lieGroupDerivative(const Eigen::VectorXd& disp, const Eigen::VectorXd& pos, const Eigen::VectorXd& vel,
+                       const Eigen::VectorXd& acc, Eigen::VectorXd& k_disp, Eigen::VectorXd& k_nu) const;
+
+    /**
+     * @brief Linear and (space-frame) angular velocities of free bodies, @f$ \boldsymbol{\omega} = 2 \,
+     * \mathrm{vec}(\dot{\boldsymbol{q}} \otimes \boldsymbol{q}^{*}) @f$.
+     *
+     * @param pos (7M x 1) body positions
+     * @param vel (7M x 1) body velocities
+     * @param nu (output) (6m x 1) linear and angular velocities
+     */
+    void
+    lieGroupVelocity(const Eigen::VectorXd& pos, const Eigen::VectorXd& vel, Eigen::VectorXd& nu) const;
+
+    /**
+     * @brief Unit quaternion of the rotation vector @f$ \boldsymbol{\theta} @f$, @f$ (\cos(|\boldsymbol{\theta}| /
+     * 2), \sin(|\boldsymbol{\theta}| / 2) \, \boldsymbol{\theta} / |\boldsymbol{\theta}|) @f$
+     *
+     * @param theta rotation vector
+     * @return Eigen::Quaterniond unit quaternion
+     */
+    static Eigen::Quaterniond
+    quaternionExp(const Eigen::Vector3d& theta);
+
+    /**
+     * @brief (4 x 3) matrix @f$ \boldsymbol{E}(\boldsymbol{q}) @f$ of the quaternion product
+     * @f$ (0, \boldsymbol{\omega}) \otimes \boldsymbol{q} = \boldsymbol{E}(\boldsymbol{q}) \boldsymbol{\omega}
+     * @f$
+     *
+     * @param quat quaternion (w, x, y, z)
+     * @return Eigen::Matrix<double, 4, 3> product matrix
+     */
+    static Eigen::Matrix<double, 4, 3>
+    quaternionProductMatrix(const Eigen::Vector4d& quat);
+
+    /**
+     * @brief Attempts a single Dormand-Prince 5(4) step of size `m_dp_h` from the internal state.
+     *
+     * @details The error of the embedded 4th order solution is measured in the root-mean-square norm over the free
+     * body positions and velocities, scaled by @f$ \mathrm{atol} + \mathrm{rtol} \, |y| @f$.
+     * The step is accepted if the scaled error is at most 1, and `m_dp_h` is updated for the next attempt.
+     * The last stage is evaluated at the new state, so its acceleration is reused as the first stage of the next
+     * step.
+     *
+     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
+     * @return true step was accepted
+     * @return false step was rejected
+     */
+    bool
+    dormandPrinceStep(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Evaluates the 4th order continuous extension of the last accepted Dormand-Prince 5(4) step
+     *
+     * @see **Reference:** Hairer, Norsett, Wanner. Solving Ordinary Differential Equations I (1993), Sec. II.6.
+     *
+     * @param theta fraction of the step, in [0, 1]
+     * @param h (dimensional) size of the step
+     * @param y_prev (7M x 1) state at start of step
+     * @param y (7M x 1) state at end of step
+     * @param k stage derivatives of state
+     * @param y_out (output) (7M x 1) state at fraction `theta` of step
+     */
+    void
+    dormandPrinceDenseOutput(const double theta, const double h, const Eigen::VectorXd& y_prev,
+                             const Eigen::VectorXd& y, const std::array<Eigen::VectorXd, 7>& k,
+                             Eigen::VectorXd& y_out) const;
+
+    /**
+     * @brief If the cached end-of-step acceleration `m_fsal_acc` is valid at the given state
+     *
+     * @details The cache is only valid if time, body positions and body velocities are bitwise identical to those of
+     * the cached evaluation. Quaternion normalization by `Engine` on output frames of fixed time steps therefore
+     * invalidates it.
+     *
+     * @param t current integration time
+     * @param pos body position vector
+     * @param vel body velocity vector
+     * @return true `m_fsal_acc` can be reused
+     * @return false acceleration must be re-evaluated
+     */
+    bool
+    fsalValid(const double t, const Eigen::VectorXd& pos, const Eigen::VectorXd& vel) const;
+
     /**
      * @brief Helper function for `integrateSecondOrder()`.
      *
@@ -106,6 +325,34 @@ class RungeKutta4
     accelerationUpdate(const double t, Eigen::VectorXd& pos, Eigen::VectorXd& vel, Eigen::VectorXd& acc,
                        const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Calculates the free body accelerations with `udwadiaKalaba()`, or with `reducedCoordinateAcc()` for the
+     * Lie-group integration scheme.
+     *
+     * @param acc (output) (7m x 1) body acceleration vector that will be overwritten
+     */
+    void
+    bodyAcceleration(Eigen::VectorXd& acc);
+
+    /**
+     * @brief Calculates the body accelerations in the 6 D.o.F. per body of linear and angular velocities.
+     *
+     * @details Body velocities are @f$ \dot{\boldsymbol{\xi}} = \boldsymbol{T} \boldsymbol{\nu} @f$ with the
+     * (7m x 6m) block-diagonal map @f$ \boldsymbol{T} = \mathrm{diag}(\boldsymbol{I}, \frac{1}{2}
+     * \boldsymbol{E}(\boldsymbol{q})) @f$ (see `quaternionProductMatrix()`), whose columns are orthogonal to the
+     * quaternion constraint directions.
+     * Projecting the equations of motion onto them removes the constraint forces,
+     * @f$ \boldsymbol{T}^{\mathrm{T}} \boldsymbol{M} \boldsymbol{T} \dot{\boldsymbol{\nu}} =
+     * \boldsymbol{T}^{\mathrm{T}} (\boldsymbol{Q} - \boldsymbol{M} \dot{\boldsymbol{T}} \boldsymbol{\nu}) @f$,
+     * which is solved with a Cholesky factorization.
+     * @f$ \ddot{\boldsymbol{\xi}} = \boldsymbol{T} \dot{\boldsymbol{\nu}} + \dot{\boldsymbol{T}}
+     * \boldsymbol{\nu} @f$ satisfies the unit quaternion constraints and equals the Udwadia-Kalaba accelerations.
+     *
+     * @param acc (output) (7m x 1) body acceleration vector that will be overwritten
+     */
+    void
+    reducedCoordinateAcc(Eigen::VectorXd& acc);
+
     /**
      * @brief Replaces 2nd 1/2 of body position and velocity D.o.F. with image of 1st 1/2 assuming the reflection plane
      * is @f$ z = 0 @f$.
@@ -141,11 +388,85 @@ class RungeKutta4
      * alternative derivation of the quaternion equations of motion for rigid-body rotational dynamics."
      * (2010): 044505.
      *
+     * @details Dispatches to `udwadiaKalabaSized()` with compile-time matrix sizes for systems with 1 or 2 free bodies
+     * (all collinear swimmer configurations), and to the dynamically sized implementation otherwise.
+     * The solver is selected with `SystemData::udwadiaSolver()`:
+     * `UdwadiaSolver::Eigendecomposition` evaluates the general Udwadia-Kalaba formula with matrix square roots and
+     * a pseudo-inverse.
+     * `UdwadiaSolver::Cholesky` uses that the constraint rows are linearly independent (each row only contains the
+     * quaternion of one body), so that @f$ (\boldsymbol{A} \boldsymbol{M}^{-1/2})^{+} = \boldsymbol{M}^{-1/2}
+     * \boldsymbol{A}^{\mathrm{T}} \boldsymbol{S}^{-1} @f$ with the (c x c) Schur complement
+     * @f$ \boldsymbol{S} = \boldsymbol{A} \boldsymbol{M}^{-1} \boldsymbol{A}^{\mathrm{T}} @f$.
+     * Then @f$ \ddot{\boldsymbol{\xi}} = \boldsymbol{a} + \boldsymbol{M}^{-1} \boldsymbol{A}^{\mathrm{T}}
+     * \boldsymbol{S}^{-1} (\boldsymbol{b} - \boldsymbol{A} \boldsymbol{a}) @f$, with the unconstrained
+     * accelerations @f$ \boldsymbol{a} = \boldsymbol{M}^{-1} \boldsymbol{Q} @f$, only needs a single Cholesky
+     * factorization of @f$ \boldsymbol{M} @f$.
+     * `UdwadiaSolver::Iterative` only needs products with @f$ \boldsymbol{M} @f$, see `udwadiaKalabaIterative()`.
+     *
      * @param acc (output) body acceleration vector that will be overwritten
      */
     void
     udwadiaKalaba(Eigen::VectorXd& acc);
 
+    /**
+     * @brief Matrix-free implementation of `udwadiaKalaba()` for systems with many bodies
+     *
+     * @details The Udwadia-Kalaba accelerations minimize Gauss' function
+     * @f$ \frac{1}{2} \ddot{\boldsymbol{\xi}}^{\mathrm{T}} \boldsymbol{M} \ddot{\boldsymbol{\xi}} -
+     * \boldsymbol{Q}^{\mathrm{T}} \ddot{\boldsymbol{\xi}} @f$ subject to
+     * @f$ \boldsymbol{A} \ddot{\boldsymbol{\xi}} = \boldsymbol{b} @f$.
+     * Each constraint row only contains the quaternion @f$ \boldsymbol{q}_i @f$ of body i, so the orthogonal
+     * projector onto the null space of @f$ \boldsymbol{A} @f$ acts body-by-body as
+     * @f$ \boldsymbol{P}_i = \boldsymbol{I} - \boldsymbol{q}_i \boldsymbol{q}_i^{\mathrm{T}} /
+     * (\boldsymbol{q}_i^{\mathrm{T}} \boldsymbol{q}_i) @f$ on the quaternion components.
+     * The accelerations are split into a particular solution of the constraints and a correction in the null space,
+     * which solves @f$ \boldsymbol{P} \boldsymbol{M} \boldsymbol{P} \boldsymbol{y} = \boldsymbol{P}
+     * (\boldsymbol{Q} - \boldsymbol{M} \ddot{\boldsymbol{\xi}}_p) @f$ with projected conjugate gradients.
+     * The preconditioner is @f$ \boldsymbol{P} \boldsymbol{B}^{-1} \boldsymbol{P} @f$, where
+     * @f$ \boldsymbol{B} @f$ holds the (7 x 7) diagonal blocks of @f$ \boldsymbol{M} @f$ applied through their
+     * Cholesky factors.
+     * No matrix inverses or square roots are formed, and each iteration costs one product with
+     * `PotentialHydrodynamics::mTotalBodyCoords()`.
+     *
+     * @param acc (output) body acceleration vector that will be overwritten
+     */
+    void
+    udwadiaKalabaIterative(Eigen::VectorXd& acc);
+
+    /**
+     * @brief Implementation of `udwadiaKalaba()` with matrix sizes fixed at compile-time
+     *
+     * @details Fixed-size matrices are stack allocated and their products are unrolled by the compiler, which
+     * removes heap allocations from the per-stage constrained solve of small systems.
+     *
+     * @tparam BodyDof7 = 7m, number of free body D.o.F. (or `Eigen::Dynamic`)
+     * @tparam NumConstraints = c, number of unit quaternion constraints (or `Eigen::Dynamic`)
+     * @param acc (output) body acceleration vector that will be overwritten
+     */
+    template <int BodyDof7, int NumConstraints>
+    void
+    udwadiaKalabaSized(Eigen::VectorXd& acc);
+
+    /**
+     * @brief Solves @f$ \boldsymbol{M}_{\mathrm{eff}} \boldsymbol{X} = \boldsymbol{B} @f$ with the Cholesky
+     * factorization of a previous effective mass matrix.
+     *
+     * @details The stored factorization `m_M_eff_llt` is used as a preconditioner of iterative refinement,
+     * @f$ \boldsymbol{X} \leftarrow \boldsymbol{X} + \boldsymbol{L}^{-\mathrm{T}} \boldsymbol{L}^{-1}
+     * (\boldsymbol{B} - \boldsymbol{M}_{\mathrm{eff}} \boldsymbol{X}) @f$, which only costs matrix-vector
+     * products.
+     * `M_eff` is refactorized if the relative residual does not drop below `m_udwadia_refactor_tol` within
+     * `m_refine_max_iter` iterations.
+     * The effective mass matrix changes little between the stages of one time step, so most solves converge in a few
+     * iterations.
+     *
+     * @param M_eff (7m x 7m) effective mass matrix
+     * @param rhs (7m x k) right-hand sides
+     * @param sol (output) (7m x k) solutions
+     */
+    void
+    solveEffectiveMassReuse(const Eigen::MatrixXd& M_eff, const Eigen::MatrixXd& rhs, Eigen::MatrixXd& sol);
+
     /**
      * @brief (linear/angular) momentum and (linear/angular) force free algorithm
      *
@@ -160,6 +481,22 @@ class RungeKutta4
     void
     momForceFree(const Eigen::ThreadPoolDevice& device);
 
+    /// Time integration schemes, see `integrate()`
+    enum IntegratorScheme : int
+    {
+        Classical = 0,
+        LieGroup  = 1,
+        Rattle    = 2,
+    };
+
+    /// Solvers of the Udwadia-Kalaba constrained accelerations, see `udwadiaKalaba()`
+    enum UdwadiaSolver : int
+    {
+        Eigendecomposition = 0,
+        Cholesky           = 1,
+        Iterative          = 2,
+    };
+
     // classes
     /// shared pointer reference to `SystemData` class
     std::shared_ptr<SystemData> m_system;
@@ -170,7 +507,7 @@ class RungeKutta4
     /// path of logfile for spdlog to write to
     std::string m_logFile;
     /// filename of logfile for spdlog to write to
-    const std::string m_logName{"RungeKutta4"};
+    std::string m_logName{"RungeKutta4"};
 
     // time step variables
     /// (dimensional) integrator finite time step
@@ -189,11 +526,241 @@ class RungeKutta4
     /// = 7 * m_body_dof
     int m_body_dof_7{-1};
 
+    /// Time integration scheme. Set from `SystemData` during construction
+    int m_integrator_scheme{IntegratorScheme::Classical};
+
+    /// Solver of the Udwadia-Kalaba constrained accelerations. Set from `SystemData` during construction
+    int m_udwadia_solver{UdwadiaSolver::Eigendecomposition};
+
+    // ANCHOR: reuse of effective mass factorization across solves
+    /// Relative residual tolerance of `solveEffectiveMassReuse()`. Factorization is only reused if positive
+    double m_udwadia_refactor_tol{0.0};
+    /// If `m_M_eff_llt` holds the factorization of a previous effective mass matrix
+    bool m_M_eff_llt_valid{false};
+    /// Cholesky factorization of a previous effective mass matrix
+    Eigen::LLT<Eigen::MatrixXd> m_M_eff_llt;
+    /// Maximum number of iterative refinement steps before refactorizing
+    const int m_refine_max_iter{5};
+    /// Number of Cholesky factorizations of the effective mass matrix
+    long m_num_mass_factorizations{0};
+    /// (7m x 7m) effective mass matrix passed to `solveEffectiveMassReuse()`
+    Eigen::MatrixXd m_reuse_M_eff;
+    /// (7m x (1 + c)) right-hand sides, solutions, residuals and corrections of `solveEffectiveMassReuse()`
+    Eigen::MatrixXd m_reuse_rhs;
+    Eigen::MatrixXd m_reuse_sol;
+    Eigen::MatrixXd m_reuse_residual;
+    Eigen::MatrixXd m_reuse_correction;
+
+    // ANCHOR: projected conjugate gradient solver
+    /// Relative residual tolerance of `udwadiaKalabaIterative()`
+    const double m_cg_rel_tol{1.0e-12};
+    /// (m x 1) Cholesky factors of the (7 x 7) diagonal blocks of the effective mass matrix
+    std::vector<Eigen::LLT<Eigen::Matrix<double, 7, 7>>> m_block_jacobi_llt;
+    /// Total number of conjugate gradient iterations
+    long m_num_cg_iterations{0};
+    /// (7m x 1) unconstrained forces and particular solution of the constraints
+    Eigen::VectorXd m_cg_Q;
+    Eigen::VectorXd m_cg_acc_p;
+    /// (7m x 1) conjugate gradient solution, residual, preconditioned residual, direction and its mass product
+    Eigen::VectorXd m_cg_y;
+    Eigen::VectorXd m_cg_res;
+    Eigen::VectorXd m_cg_z;
+    Eigen::VectorXd m_cg_dir;
+    Eigen::VectorXd m_cg_M_dir;
+
+    // ANCHOR: `integrateRattle()`
+    /// Maximum number of fixed-point iterations of the final kick. Set from `SystemData` during construction
+    int m_rattle_max_iter{2};
+    /// Relative tolerance on the change of the body velocities between fixed-point iterations
+    const double m_rattle_rel_tol{1.0e-12};
+    /// Total number of fixed-point iterations
+    long m_num_rattle_iterations{0};
+    /// (7M x 1) body positions, velocities and accelerations at start of step
+    Eigen::VectorXd m_rattle_pos_n;
+    Eigen::VectorXd m_rattle_vel_n;
+    Eigen::VectorXd m_rattle_acc_n;
+    /// (7M x 1) half step body velocities
+    Eigen::VectorXd m_rattle_vel_half;
+    /// (7M x 1) body positions, velocities and accelerations at end of step
+    Eigen::VectorXd m_rattle_pos_out;
+    Eigen::VectorXd m_rattle_vel_out;
+    Eigen::VectorXd m_rattle_acc_out;
+    /// (7M x 1) body velocities of next fixed-point iteration
+    Eigen::VectorXd m_rattle_vel_next;
+
+    // ANCHOR: first-same-as-last reuse of end-of-step acceleration
+    /// If `m_fsal_acc` holds the body acceleration at (`m_fsal_t`, `m_fsal_pos`, `m_fsal_vel`)
+    bool m_fsal_valid{false};
+    /// time of cached evaluation
+    double m_fsal_t{0.0};
+    /// (7M x 1) body positions of cached evaluation
+    Eigen::VectorXd m_fsal_pos;
+    /// (7M x 1) body velocities of cached evaluation
+    Eigen::VectorXd m_fsal_vel;
+    /// (7M x 1) cached body accelerations
+    Eigen::VectorXd m_fsal_acc;
+
+    // ANCHOR: preallocated stage buffers of `integrateSecondOrder()`
+    /// (7M x 1) body positions, velocities and accelerations of each Runge-Kutta stage
+    std::array<Eigen::VectorXd, 4> m_rk_pos;
+    std::array<Eigen::VectorXd, 4> m_rk_vel;
+    std::array<Eigen::VectorXd, 4> m_rk_acc;
+    /// (7M x 1) body positions, velocities and accelerations at end of step
+    Eigen::VectorXd m_rk_pos_out;
+    Eigen::VectorXd m_rk_vel_out;
+    Eigen::VectorXd m_rk_acc_out;
+    /// (7m x 1) accelerations of the real bodies of image systems, see `accelerationUpdate()`
+    Eigen::VectorXd m_acc_real_body;
+    /// Number of calls to `accelerationUpdate()`
+    long m_num_acceleration_updates{0};
+
+    // ANCHOR: preallocated buffers of `integrateLieGroup()` and `reducedCoordinateAcc()`
+    /// (7M x 1) body positions and velocities at start of step
+    Eigen::VectorXd m_lg_pos_n;
+    Eigen::VectorXd m_lg_vel_n;
+    /// (7M x 1) body positions, velocities and accelerations of the current stage
+    Eigen::VectorXd m_lg_pos;
+    Eigen::VectorXd m_lg_vel;
+    Eigen::VectorXd m_lg_acc;
+    /// (6m x 1) Lie algebra velocities at start of step and of the current stage, and displacements
+    Eigen::VectorXd m_lg_nu_n;
+    Eigen::VectorXd m_lg_nu;
+    Eigen::VectorXd m_lg_disp;
+    /// (6m x 1) Lie algebra stage derivatives
+    std::array<Eigen::VectorXd, 4> m_lg_k_disp;
+    std::array<Eigen::VectorXd, 4> m_lg_k_nu;
+    /// (7m x 1) unconstrained forces and @f$ \dot{\boldsymbol{T}} \boldsymbol{\nu} @f$
+    Eigen::VectorXd m_red_Q;
+    Eigen::VectorXd m_red_T_dot_nu;
+    /// (7m x 6m) velocity map @f$ \boldsymbol{T} @f$ and @f$ \boldsymbol{M} \boldsymbol{T} @f$
+    Eigen::MatrixXd m_red_T;
+    Eigen::MatrixXd m_red_M_T;
+    /// (6m x 6m) reduced mass matrix @f$ \boldsymbol{T}^{\mathrm{T}} \boldsymbol{M} \boldsymbol{T} @f$
+    Eigen::MatrixXd m_red_M;
+    /// (6m x 1) reduced forces and accelerations
+    Eigen::VectorXd m_red_Q_red;
+    Eigen::VectorXd m_red_nu_dot;
+    /// Cholesky factorization of `m_red_M`
+    Eigen::LLT<Eigen::MatrixXd> m_red_llt;
+
+    // ANCHOR: adaptive (Dormand-Prince 5(4)) time stepping
+    /// If `integrate()` uses `integrateAdaptive()`. Set from `SystemData` during construction
+    bool m_adaptive{false};
+    /// Absolute error tolerance on body positions and velocities
+    double m_atol{0.0};
+    /// Relative error tolerance on body positions and velocities
+    double m_rtol{0.0};
+    /// If the internal state continues from the body state left in `SystemData` by the previous call
+    bool m_dp_valid{false};
+    /// (dimensional) size of next internal step
+    double m_dp_h{-1.0};
+    /// (dimensional) smallest internal step before integration is stopped
+    double m_dp_h_min{-1.0};
+    /// internal time
+    double m_dp_t{0.0};
+    /// internal time at start of last accepted step
+    double m_dp_t_prev{0.0};
+    /// (7M x 1) internal body positions, velocities and accelerations
+    Eigen::VectorXd m_dp_pos;
+    Eigen::VectorXd m_dp_vel;
+    Eigen::VectorXd m_dp_acc;
+    /// (7M x 1) body positions, velocities and accelerations at start of last accepted step
+    Eigen::VectorXd m_dp_pos_prev;
+    Eigen::VectorXd m_dp_vel_prev;
+    Eigen::VectorXd m_dp_acc_prev;
+    /// (7M x 1) body positions and velocities of current stage
+    Eigen::VectorXd m_dp_stage_pos;
+    Eigen::VectorXd m_dp_stage_vel;
+    /// (7M x 1) interpolated body positions, velocities and accelerations at the target time
+    Eigen::VectorXd m_dp_pos_out;
+    Eigen::VectorXd m_dp_vel_out;
+    Eigen::VectorXd m_dp_acc_out;
+    /// (7m x 1) local error estimates of the free body positions and velocities
+    Eigen::VectorXd m_dp_err_pos;
+    Eigen::VectorXd m_dp_err_vel;
+    /// (7M x 1) stage derivatives of body positions (velocities) and velocities (accelerations)
+    std::array<Eigen::VectorXd, 7> m_dp_k_pos;
+    std::array<Eigen::VectorXd, 7> m_dp_k_vel;
+    /// Number of accepted internal steps
+    long m_num_steps_accepted{0};
+    /// Number of rejected internal steps
+    long m_num_steps_rejected{0};
+
+    /// Dormand-Prince 5(4) nodes
+    const std::array<double, 7> m_dp_c{0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+    /// Dormand-Prince 5(4) Runge-Kutta matrix (last row are the 5th order weights)
+    const std::array<std::array<double, 7>, 7> m_dp_a{{
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0, 0.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0, 0.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0, 0.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0},
+    }};
+    /// Difference of 5th and embedded 4th order weights
+    const std::array<double, 7> m_dp_e{71.0 / 57600.0,      0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+                                       -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+    /// Dormand-Prince 5(4) weights of the continuous extension (dense output)
+    const std::array<double, 7> m_dp_d{-12715105075.0 / 11282082432.0, 0.0,
+                                       87487479700.0 / 32700410799.0,  -10690763975.0 / 1880347072.0,
+                                       701980252875.0 / 199316789632.0, -1453857185.0 / 822651844.0,
+                                       69997945.0 / 29380423.0};
+    /// Safety factor of step size controller
+    const double m_dp_safety{0.90};
+    /// Smallest step size change factor
+    const double m_dp_min_factor{0.20};
+    /// Largest step size change factor
+    const double m_dp_max_factor{5.00};
+
     // constants
     /// = 1/2
     const double m_c1_2{0.50};
     /// = 1/6
     const double m_c1_6{1.0 / 6.0};
+
+  public:
+    bool
+    adaptive() const
+    {
+        return m_adaptive;
+    }
+
+    long
+    numAccelerationUpdates() const
+    {
+        return m_num_acceleration_updates;
+    }
+
+    long
+    numStepsAccepted() const
+    {
+        return m_num_steps_accepted;
+    }
+
+    long
+    numStepsRejected() const
+    {
+        return m_num_steps_rejected;
+    }
+
+    long
+    numMassFactorizations() const
+    {
+        return m_num_mass_factorizations;
+    }
+
+    long
+    numCGIterations() const
+    {
+        return m_num_cg_iterations;
+    }
+
+    long
+    numRattleIterations() const
+    {
+        return m_num_rattle_iterations;
+    }
 };
 
 #endif // BODIES_IN_POTENTIAL_FLOW_RUNGE_KUTTA_4_H
@@ -29,6 +29,64 @@ Engine::Engine(std::shared_ptr<SystemData> sys)
     spdlog::get(m_logName)->info("Initializing integrator");
     m_rk4Integrator = std::make_shared<RungeKutta4>(m_system, m_potHydro);
 
+    // periodic orbit solver
+    spdlog::get(m_logName)->info("Periodic orbit solve: {0}", m_system->periodicOrbitTol() > 0.0);
+    if (m_system->periodicOrbitTol() > 0.0)
+    {
+        m_periodicOrbit = std::make_shared<PeriodicOrbit>(m_system, m_potHydro, m_rk4Integrator);
+    }
+
+    // parallel-in-time integration
+    spdlog::get(m_logName)->info("Parareal integration: {0}", m_system->pararealSlices() > 1);
+    if (m_system->pararealSlices() > 1)
+    {
+        m_parareal = std::make_shared<Parareal>(m_system);
+    }
+
+    // stroboscopic multi-rate integration and steady-state detection
+    m_multirate = (m_system->multirateMacroPeriods() > 0);
+    spdlog::get(m_logName)->info("Stroboscopic multi-rate integration: {0}", m_multirate);
+    m_steady_state = (m_system->steadyStateTol() > 0.0);
+    spdlog::get(m_logName)->info("Steady-state detection: {0}", m_steady_state);
+
+    if (m_multirate || m_steady_state)
+    {
+        m_period           = 2.0 * M_PI / (m_system->sysSpecOmega() * m_system->tau());
+        m_steps_per_period = static_cast<int>(std::round(m_period / m_system->dt()));
+
+        spdlog::get(m_logName)->info("Gait period: {0}, time steps per period: {1}", m_period, m_steps_per_period);
+
+        if ((m_steps_per_period < 1) || (std::abs(m_steps_per_period * m_system->dt() - m_period) > 1.0e-8 * m_period))
+        {
+            spdlog::get(m_logName)->error("Gait period {0} is not a multiple of dt {1}", m_period, m_system->dt());
+            throw std::invalid_argument("Per-period sampling requires an integer number of time steps per period");
+        }
+    }
+
+    if (m_multirate)
+    {
+        spdlog::get(m_logName)->info("Resolved periods: {0}, macro-step periods: {1}",
+                                     m_system->multirateMicroPeriods(), m_system->multirateMacroPeriods());
+
+        if (m_system->multirateMicroPeriods() < 1)
+        {
+            spdlog::get(m_logName)->error("At least 1 period must be resolved between macro-steps");
+            throw std::invalid_argument("At least 1 period must be resolved between macro-steps");
+        }
+    }
+
+    if (m_steady_state)
+    {
+        spdlog::get(m_logName)->info("Steady-state tolerance: {0}, consecutive periods: {1}",
+                                     m_system->steadyStateTol(), m_system->steadyStatePeriods());
+
+        if (m_system->steadyStatePeriods() < 1)
+        {
+            spdlog::get(m_logName)->error("Steady state must be reached over at least 1 period");
+            throw std::invalid_argument("Steady state must be reached over at least 1 period");
+        }
+    }
+
     // Initialize ProgressBar
     spdlog::get(m_logName)->info("Initializing ProgressBar");
     int num_step = (int)ceil(m_system->tf() / m_system->dt());
@@ -76,11 +134,59 @@ Engine::run()
     Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(m_simulation_cores);
     Eigen::ThreadPoolDevice all_cores_device(&thread_pool, m_simulation_cores);
 
+    // smallest tensor expressions worth dispatching to the thread-pool on this machine
+    const long min_parallel_work{calibrateExecutionPolicy(all_cores_device)};
+    spdlog::get(m_logName)->info("Minimum work of thread-pool tensor expressions: {0}", min_parallel_work);
+
+    if (m_periodicOrbit)
+    {
+        spdlog::get(m_logName)->info("Solving for periodic orbit at t = {0}", m_system->t());
+        const bool converged{m_periodicOrbit->solve(all_cores_device)};
+        spdlog::get(m_logName)->info("Periodic orbit converged: {0}", converged);
+
+        spdlog::get(m_logName)->info("Writing frame at t = {0}", m_system->t());
+        m_system->gsdUtil()->writeFrame();
+        spdlog::get(m_logName)->info("Logging SystemData at t = {0}", m_system->t());
+        m_system->logData();
+        m_ProgressBar->done();
+        spdlog::get(m_logName)->flush();
+        return;
+    }
+
+    if (m_parareal)
+    {
+        pararealRun(write_step, all_cores_device);
+        m_ProgressBar->done();
+        spdlog::get(m_logName)->flush();
+        return;
+    }
+
+    // stroboscopic sampling starts at the first time step of the run
+    const int start_step{m_system->timestep()};
+    if (m_multirate)
+    {
+        m_resolved_periods = 0;
+        m_strobe_prev      = Eigen::VectorXd::Zero(2 * 7 * m_system->numBodies());
+        m_strobe_prev << m_system->positionsBodies(), m_system->velocitiesBodies();
+    }
+    if (m_steady_state)
+    {
+        m_steady_periods = 0;
+        m_steady_prev_pos.resize(7 * m_system->numBodies());
+        m_steady_prev_pos = m_system->positionsBodies();
+        m_steady_prev_values.resize(0);
+        m_steady_energy_sum.setZero();
+        m_steady_num_samples = 0;
+    }
+    bool steady_state_reached{false};
+
     // Integrate system forward in time
     try
     {
         while (m_system->timestep() < tot_step)
         {
+            const int prev_step{m_system->timestep()};
+
             integrate(all_cores_device);
 
             // Update time for next step
@@ -88,11 +194,41 @@ Engine::run()
             m_system->setTimestep(m_system->timestep() + 1);
             ++(*m_ProgressBar);
 
+            if (m_steady_state)
+            {
+                steadyStateSample();
+            }
+
+            if ((m_multirate || m_steady_state) && ((m_system->timestep() - start_step) % m_steps_per_period == 0))
+            {
+                if (m_steady_state)
+                {
+                    steady_state_reached = steadyStateCheck();
+                }
+
+                if (m_multirate && !steady_state_reached)
+                {
+                    stroboscopicStep(tot_step, all_cores_device);
+
+                    // NOTE: mean velocities are only sampled over resolved periods
+                    if (m_steady_state)
+                    {
+                        m_steady_prev_pos = m_system->positionsBodies();
+                    }
+                }
+            }
+
             // Output data
-            if ((m_system->timestep() % write_step == 0) || (m_system->t() >= m_system->tf()))
+            // NOTE: macro-steps advance more than 1 time step, so check if an output step was passed
+            if ((m_system->timestep() / write_step > prev_step / write_step) || (m_system->t() >= m_system->tf()))
             {
-                spdlog::get(m_logName)->info("Normalizing quaternions at t = {0}", m_system->t());
-                m_system->normalizeQuaternions();
+                /* NOTE: modifies body positions, so `RungeKutta4` re-evaluates step 1 of next step. Adaptive time
+                 * stepping normalizes its output state itself, as it would otherwise restart its internal steps */
+                if (!m_rk4Integrator->adaptive())
+                {
+                    spdlog::get(m_logName)->info("Normalizing quaternions at t = {0}", m_system->t());
+                    m_system->normalizeQuaternions();
+                }
 
                 spdlog::get(m_logName)->info("Writing frame at t = {0}", m_system->t());
                 m_system->gsdUtil()->writeFrame();
@@ -100,10 +236,18 @@ Engine::run()
                 m_system->logData();
                 spdlog::get(m_logName)->flush();
             }
-            if (m_system->timestep() % display_step == 0)
+            if (m_system->timestep() / display_step > prev_step / display_step)
             {
                 m_ProgressBar->display(); // display the progress bar
             }
+
+            if (steady_state_reached)
+            {
+                spdlog::get(m_logName)->info("Steady state reached at t = {0}, stopping simulation", m_system->t());
+                std::cout << '\r' << "Steady state reached at t = " << m_system->t() << ". Stopping simulation."
+                          << '\n';
+                break;
+            }
         }
     }
     catch (const std::runtime_error& e)
@@ -124,3 +268,152 @@ Engine::integrate(const Eigen::ThreadPoolDevice& device)
 {
     m_rk4Integrator->integrate(device);
 }
+
+void
+Engine::stroboscopicStep(const int tot_step, const Eigen::ThreadPoolDevice& device)
+{
+    m_resolved_periods++;
+
+    Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * m_system->numBodies());
+    state << m_system->positionsBodies(), m_system->velocitiesBodies();
+
+    const int remaining_periods{(tot_step - m_system->timestep()) / m_steps_per_period};
+    const int macro_periods{std::min(m_system->multirateMacroPeriods(), remaining_periods)};
+
+    if ((m_resolved_periods < m_system->multirateMicroPeriods()) || (macro_periods < 1))
+    {
+        m_strobe_prev.noalias() = state;
+        return;
+    }
+
+    /* ANCHOR: projective forward Euler step of the stroboscopic map */
+    Eigen::VectorXd state_macro = state;
+    state_macro.noalias() += macro_periods * (state - m_strobe_prev);
+
+    const int num_dof_7{7 * m_system->numBodies()};
+    m_system->setPositionsBodies(state_macro.head(num_dof_7));
+    m_system->setVelocitiesBodies(state_macro.tail(num_dof_7));
+    m_system->normalizeQuaternions();
+
+    // NOTE: advance by whole periods, so the gait phase is unchanged
+    m_system->setT(m_system->t() + macro_periods * m_period);
+    m_system->setTimestep(m_system->timestep() + macro_periods * m_steps_per_period);
+
+    // NOTE: modifies body positions, so `RungeKutta4` re-evaluates step 1 of next step
+    m_system->update(device);
+    m_potHydro->update(device);
+    for (int step = 0; step < macro_periods * m_steps_per_period; step++)
+    {
+        ++(*m_ProgressBar);
+    }
+
+    spdlog::get(m_logName)->info("Stroboscopic macro-step over {0} periods to t = {1}", macro_periods,
+                                 m_system->t());
+
+    m_num_macro_steps++;
+    m_resolved_periods = 0;
+    m_strobe_prev << m_system->positionsBodies(), m_system->velocitiesBodies();
+}
+
+bool
+Engine::steadyStateCheck()
+{
+    const int body_dof{m_system->imageSystem() ? m_system->numBodies() / 2 : m_system->numBodies()};
+    const int num_z{m_system->imageSystem() ? body_dof : 0};
+
+    /* ANCHOR: per-period quantities */
+    Eigen::VectorXd values = Eigen::VectorXd::Zero(3 * body_dof + num_z + 4);
+
+    // mean linear velocity of each free body over the last period
+    for (int body_id = 0; body_id < body_dof; body_id++)
+    {
+        values.segment<3>(3 * body_id) =
+            (m_system->positionsBodies().segment<3>(7 * body_id) - m_steady_prev_pos.segment<3>(7 * body_id)) /
+            m_period;
+    }
+
+    // NOTE: height above the wall is only meaningful for image systems
+    for (int body_id = 0; body_id < num_z; body_id++)
+    {
+        values(3 * body_dof + body_id) = m_system->positionsBodies()(7 * body_id + 2);
+    }
+
+    // mean hydrodynamic energies over the time steps of the last period
+    values.tail<4>() = m_steady_energy_sum / static_cast<double>(std::max(m_steady_num_samples, 1));
+
+    /* ANCHOR: convergence monitor */
+    if (m_steady_prev_values.size() == values.size())
+    {
+        const auto change = (values - m_steady_prev_values).array().abs();
+        const auto bound  = m_system->steadyStateTol() * values.array().abs() + m_system->steadyStateAtol();
+        const long num_changing{(change > bound).count()};
+        spdlog::get(m_logName)->info("Steady-state monitor at t = {0}: {1} quantities changing", m_system->t(),
+                                     num_changing);
+
+        m_steady_periods = (num_changing == 0) ? m_steady_periods + 1 : 0;
+    }
+
+    m_steady_prev_values.resize(values.size());
+    m_steady_prev_values = values;
+    m_steady_prev_pos    = m_system->positionsBodies();
+    m_steady_energy_sum.setZero();
+    m_steady_num_samples = 0;
+
+    if (m_steady_periods < m_system->steadyStatePeriods())
+    {
+        return false;
+    }
+
+    m_system->setSteadyStateTime(m_system->t());
+    m_system->setSteadyStateValues(values);
+    return true;
+}
+
+void
+Engine::steadyStateSample()
+{
+    m_steady_energy_sum(0) += m_system->eHydroInt();
+    m_steady_energy_sum(1) += m_system->eHydroLocInt();
+    m_steady_energy_sum(2) += m_system->eHydroLoc();
+    m_steady_energy_sum(3) += m_system->eHydroSimple();
+    m_steady_num_samples++;
+}
+
+void
+Engine::pararealRun(const int write_step, const Eigen::ThreadPoolDevice& device)
+{
+    spdlog::get(m_logName)->info("Starting parareal integration at t = {0}", m_system->t());
+    const bool converged{m_parareal->run(device, write_step)};
+    spdlog::get(m_logName)->info("Parareal converged: {0} in {1} iterations", converged, m_parareal->numIterations());
+
+    const int    num_dof_7{7 * m_system->numBodies()};
+    const double t0{m_system->t()};
+    const int    first_step{m_system->timestep()};
+    int          prev_step{0};
+
+    for (std::size_t frame = 0; frame < m_parareal->frameSteps().size(); frame++)
+    {
+        const int step{m_parareal->frameSteps()[frame]};
+
+        m_system->setPositionsBodies(m_parareal->frameStates().col(frame).head(num_dof_7));
+        m_system->setVelocitiesBodies(m_parareal->frameStates().col(frame).tail(num_dof_7));
+        m_system->normalizeQuaternions();
+
+        m_system->setT(t0 + step * m_system->dt());
+        m_system->setTimestep(first_step + step);
+
+        // NOTE: modifies body positions, so `RungeKutta4` re-evaluates step 1 of next step
+        m_system->update(device);
+        m_potHydro->update(device);
+        for (; prev_step < step; prev_step++)
+        {
+            ++(*m_ProgressBar);
+        }
+
+        spdlog::get(m_logName)->info("Writing frame at t = {0}", m_system->t());
+        m_system->gsdUtil()->writeFrame();
+        spdlog::get(m_logName)->info("Logging SystemData at t = {0}", m_system->t());
+        m_system->logData();
+    }
+    m_ProgressBar->display();
+}
@@ -10,6 +10,8 @@
 #endif
 
 /* Include all internal project dependencies */
+#include <Parareal.hpp>
+#include <PeriodicOrbit.hpp>
 #include <PotentialHydrodynamics.hpp>
 #include <ProgressBar.hpp>
 #include <RungeKutta4.hpp>
@@ -31,10 +33,13 @@
 #include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
 // eigen3 conversion between Eigen::Tensor (unsupported) and Eigen::Matrix
 #include <helper_eigenTensorConversion.hpp>
+// eigen3 size-aware evaluation of tensor expressions
+#include <helper_eigenExecutionPolicy.hpp>
 // Logging
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
 // STL
+#include <algorithm> // std::min, std::max
 #include <math.h>    // isinf, sqr
 #include <memory>    // for std::unique_ptr and std::shared_ptr
 #include <stdexcept> // std::errors
@@ -72,6 +77,13 @@ class Engine
      * to the `integrate()` method to speed up `Eigen::Tensor` computations.
      * Method also calculates the total number of integration steps required and manages the output
      * of the `ProgressBar` class.
+     * If `SystemData::multirateMacroPeriods()` is positive, `stroboscopicStep()` is called at the end of each
+     * resolved gait period.
+     * If `SystemData::steadyStateTol()` is positive, `steadyStateCheck()` is called at the end of each gait period
+     * and the run stops early once the steady state is reached.
+     * If `SystemData::periodicOrbitTol()` is positive, the periodic orbit is found with `PeriodicOrbit::solve()`
+     * instead of integrating to @f$ t_f @f$, and a frame is written with the periodic state at @f$ t_0 @f$.
+     * If `SystemData::pararealSlices()` is at least 2, the run is integrated in parallel in time with `pararealRun()`.
      *
      */
     void
@@ -86,10 +98,75 @@ class Engine
     void
     integrate(const Eigen::ThreadPoolDevice& device);
 
+    /**
+     * @brief Stroboscopic (period-averaged) multi-rate integration, called at the end of each resolved gait period.
+     *
+     * @details The body state sampled once per gait period, @f$ \boldsymbol{y}_k @f$, is a slowly varying map of
+     * the period number for a periodic gait.
+     * After `SystemData::multirateMicroPeriods()` resolved periods, the map is advanced by a projective forward
+     * Euler macro-step over @f$ P @f$ = `SystemData::multirateMacroPeriods()` periods,
+     * @f$ \boldsymbol{y}_{k+P} = \boldsymbol{y}_k + P (\boldsymbol{y}_k - \boldsymbol{y}_{k-1}) @f$, and time and
+     * time step advance by @f$ P @f$ whole periods so the gait phase is unchanged.
+     * Quaternions are normalized after the macro-step, and `SystemData` and `PotentialHydrodynamics` are updated at
+     * the new state for output.
+     * Macro-steps are shortened so they do not pass the final time step.
+     *
+     * @see **Reference:** Gear, C. William, and Ioannis G. Kevrekidis. "Projective methods for stiff differential
+     * equations: problems with gaps in their eigenvalue spectrum." SIAM Journal on Scientific Computing 24.4 (2003):
+     * 1091-1106.
+     *
+     * @param tot_step final time step of the run
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     */
+    void
+    stroboscopicStep(const int tot_step, const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Online steady-state monitor, called at the end of each resolved gait period.
+     *
+     * @details Samples the mean linear velocity of each free body over the last period, the height of each free body
+     * above the wall (image systems only) and the means of the hydrodynamic energies `SystemData::eHydroInt()`,
+     * `SystemData::eHydroLocInt()`, `SystemData::eHydroLoc()` and `SystemData::eHydroSimple()` over the time steps of
+     * the last period (see `steadyStateSample()`).
+     * The steady state is reached once every sample @f$ x @f$ changes from the previous period by at most
+     * @f$ r |x| + a @f$, with @f$ r @f$ `SystemData::steadyStateTol()` and @f$ a @f$ `SystemData::steadyStateAtol()`,
+     * for `SystemData::steadyStatePeriods()` consecutive periods. The samples and the time are then stored in
+     * `SystemData` for output.
+     *
+     * @return true steady state was reached
+     * @return false steady state was not reached
+     */
+    bool
+    steadyStateCheck();
+
+    /**
+     * @brief Adds the hydrodynamic energies of the current time step to the per-period sums of `steadyStateCheck()`.
+     *
+     * @details The energies oscillate with the gait, so single-instant samples at the period boundaries only compare
+     * one gait phase.
+     */
+    void
+    steadyStateSample();
+
+    /**
+     * @brief Parallel-in-time run with `Parareal::run()`.
+     *
+     * @details The time slices are distributed over the thread-pool of `device`. The body state at each output time
+     * step (see `Parareal::frameSteps()`) is loaded into `SystemData`, which is then updated along with
+     * `PotentialHydrodynamics` and written as a frame, so output matches a serial run.
+     *
+     * @param write_step number of time steps between output frames
+     * @param device device (CPU thread-pool or GPU) used to speed up tensor calculations
+     */
+    void
+    pararealRun(const int write_step, const Eigen::ThreadPoolDevice& device);
+
     // classes
     std::shared_ptr<SystemData>             m_system;
     std::shared_ptr<PotentialHydrodynamics> m_potHydro;
     std::shared_ptr<RungeKutta4>            m_rk4Integrator;
+    std::shared_ptr<PeriodicOrbit>          m_periodicOrbit;
+    std::shared_ptr<Parareal>               m_parareal;
     std::shared_ptr<ProgressBar>            m_ProgressBar;
 
     // logging
@@ -102,9 +179,44 @@ class Engine
     /// @todo: number of physical CPU cores to use in tensor calculations
     const int m_simulation_cores{static_cast<int>(std::ceil(m_num_physical_cores / 2.0))};
 
+    // stroboscopic multi-rate integration
+    /// If `stroboscopicStep()` is used. Set from `SystemData` during construction
+    bool m_multirate{false};
+    /// Number of time steps per gait period
+    int m_steps_per_period{-1};
+    /// Gait period (non-dimensional)
+    double m_period{-1.0};
+    /// Number of resolved periods since the last macro-step
+    int m_resolved_periods{0};
+    /// (14M x 1) body positions and velocities at the previous period boundary
+    Eigen::VectorXd m_strobe_prev;
+    /// Number of stroboscopic macro-steps taken
+    long m_num_macro_steps{0};
+
+    // steady-state detection
+    /// If `steadyStateCheck()` is used. Set from `SystemData` during construction
+    bool m_steady_state{false};
+    /// Number of consecutive periods the per-period quantities changed less than the tolerance
+    int m_steady_periods{0};
+    /// (7M x 1) body positions at the previous period boundary
+    Eigen::VectorXd m_steady_prev_pos;
+    /// Per-period quantities of the previous period
+    Eigen::VectorXd m_steady_prev_values;
+    /// Sums of the hydrodynamic energies over the time steps of the current period
+    Eigen::Vector4d m_steady_energy_sum{Eigen::Vector4d::Zero()};
+    /// Number of time steps summed in `m_steady_energy_sum`
+    int m_steady_num_samples{0};
+
     // ProgressBar output
     /// Percentage of simulation progress at which to update ProgressBar
     const double m_outputPercentile{0.001};
+
+  public:
+    long
+    numMacroSteps() const
+    {
+        return m_num_macro_steps;
+    }
 };
 
 #endif // BODIES_IN_POTENTIAL_FLOW_ENGINE_H
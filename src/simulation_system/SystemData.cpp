@@ -23,10 +23,30 @@ SystemData::SystemData(std::string inputGSDFile, std::string outputDir)
     spdlog::get(m_logName)->flush();
 }
 
+SystemData::SystemData(const SystemData& other, const std::string& logTag) : SystemData(other)
+{
+    m_logTag  = logTag;
+    m_logName = "SystemData" + m_logTag;
+
+    // NOTE: worker copies do not write to the GSD file of `other`
+    m_gsdUtil.reset();
+    m_handle    = std::make_shared<gsd_handle>();
+    m_gsd_owner = false;
+
+    // Initialize logger
+    m_logFile   = m_outputDir + "/logs/" + m_logName + "-log.txt";
+    auto logger = spdlog::basic_logger_mt(m_logName, m_logFile);
+    spdlog::get(m_logName)->info("Initialized worker copy of system data");
+    spdlog::get(m_logName)->flush();
+}
+
 SystemData::~SystemData()
 {
     spdlog::get(m_logName)->critical("SystemData destructor called");
-    gsd_close(m_handle.get());
+    if (m_gsd_owner)
+    {
+        gsd_close(m_handle.get());
+    }
     spdlog::get(m_logName)->flush();
     spdlog::drop(m_logName);
 }
@@ -124,17 +144,16 @@ SystemData::initializeData()
     m_Udwadia_A = Eigen::MatrixXd::Zero(m_num_constraints, m_num_DoF + m_num_constraints);
     m_Udwadia_b = Eigen::VectorXd::Zero(m_num_constraints);
 
-    // initialize rigid body motion matrices
-    m_rbm_conn      = Eigen::MatrixXd::Zero(m7, n7);
-    m_tens_rbm_conn = Eigen::Tensor<double, 2>(m7, n7);
-    m_tens_rbm_conn.setZero();
-
     // initialize gradient matrices
-    m_chi      = Eigen::MatrixXd::Zero(m7, n3);
     m_tens_chi = Eigen::Tensor<double, 2>(m7, n3);
     m_tens_chi.setZero();
-    m_tens_grad_rbm_conn = Eigen::Tensor<double, 3>(m7, n7, m7);
-    m_tens_grad_rbm_conn.setZero();
+
+    // initialize per-particle blocks of rigid body motion and gradient matrices
+    m_rbm_conn_blocks.assign(m_num_particles, RbmConnBlock::Zero());
+    m_chi_blocks.assign(m_num_particles, ChiBlock::Zero());
+    GradRbmConnBlock grad_rbm_conn_block_zero;
+    grad_rbm_conn_block_zero.setZero();
+    m_grad_rbm_conn_blocks.assign(m_num_particles, grad_rbm_conn_block_zero);
 
     // Set initial configuration orientation
     spdlog::get(m_logName)->info("Setting initial configuration orientation");
@@ -175,6 +194,7 @@ SystemData::initializeData()
     Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
 
     spdlog::get(m_logName)->info("Initializing constraints");
+    m_update_graph.invalidate(); // NOTE: all particle data was (re-)allocated
     update(single_core_device);
 
     // output data
@@ -309,16 +329,18 @@ SystemData::logData()
             m_velocities_particles(particle_id_7 + 6));
     }
 
+    const Eigen::VectorXd& accelerations_particles = accelerationsParticles();
+
     spdlog::get(m_logName)->info("Particle accelerations:");
     for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
     {
         const int particle_id_7{7 * particle_id};
         spdlog::get(m_logName)->info(
             "\tParticle {0}: [{1:03.14f}, {2:03.14f}, {3:03.14f}]", particle_id + 1,
-            m_accelerations_particles(particle_id_7), m_accelerations_particles(particle_id_7 + 1),
-            m_accelerations_particles(particle_id_7 + 2), m_accelerations_particles(particle_id_7 + 3),
-            m_accelerations_particles(particle_id_7 + 4), m_accelerations_particles(particle_id_7 + 5),
-            m_accelerations_particles(particle_id_7 + 6));
+            accelerations_particles(particle_id_7), accelerations_particles(particle_id_7 + 1),
+            accelerations_particles(particle_id_7 + 2), accelerations_particles(particle_id_7 + 3),
+            accelerations_particles(particle_id_7 + 4), accelerations_particles(particle_id_7 + 5),
+            accelerations_particles(particle_id_7 + 6));
     }
 
     /* ANCHOR: Output particle *articulation* data */
@@ -369,24 +391,56 @@ SystemData::logData()
 void
 SystemData::update(const Eigen::ThreadPoolDevice& device)
 {
+    /* NOTE: each stage is only evaluated if time or a body state it depends on changed since its last evaluation,
+     * dependencies are defined in `m_update_graph` */
+
     // NOTE: Internal particle orientation D.o.F. calculated 1st
-    convertBody2ParticleOrient();
+    if (m_update_graph.outdated(StageOrientation, m_input_versions))
+    {
+        convertBody2ParticleOrient();
+        m_update_graph.markCurrent(StageOrientation, m_input_versions);
+    }
 
     // NOTE: Articulation functions calculated 2nd (need m_orientations_particles)
-    positionsArticulation();
-    velocitiesArticulation();
-    accelerationsArticulation();
+    if (m_update_graph.outdated(StageArticulation, m_input_versions))
+    {
+        positionsArticulation();
+        velocitiesArticulation();
+        accelerationsArticulation();
+        m_update_graph.markCurrent(StageArticulation, m_input_versions);
+    }
 
-    // NOTE: Rigid body motion tensors calculated 3rd (need m_positions_particles_articulation)
-    convertBody2ParticlePos();
-    rigidBodyMotionTensors(device);
-    gradientChangeOfVariableTensors(device);
+    // NOTE: Rigid body motion tensors calculated 3rd (need m_positions_particles_articulation), the connectivity
+    // tensor and the change of variable tensors are independent and evaluated concurrently
+    if (m_update_graph.outdated(StageRbmTensors, m_input_versions))
+    {
+        parallelInvoke(
+            device,
+            [this]() {
+                convertBody2ParticlePos();
+                rigidBodyMotionTensors();
+            },
+            [this]() { gradientChangeOfVariableTensors(); });
+
+        m_update_graph.markCurrent(StageRbmTensors, m_input_versions);
+    }
 
-    // NOTE: Particle degrees of freedom calculated 4th (need rbm tensors)
-    convertBody2ParticleVelAcc(device);
+    // NOTE: Particle degrees of freedom calculated 4th (need rbm tensors), accelerations only on output
+    if (m_update_graph.outdated(StageParticleKinematics, m_input_versions))
+    {
+        convertBody2ParticleVel(device);
+        m_update_graph.markCurrent(StageParticleKinematics, m_input_versions);
+    }
 
     // NOTE: Udwadia linear system calculated 5th
-    udwadiaLinearSystem();
+    if (m_update_graph.outdated(StageUdwadia, m_input_versions))
+    {
+        udwadiaLinearSystem();
+        m_update_graph.markCurrent(StageUdwadia, m_input_versions);
+    }
+
+    m_updated_versions              = m_input_versions;
+    m_accelerations_particles_dirty = true;
 }
 
 void
@@ -400,6 +454,8 @@ SystemData::normalizeQuaternions()
 
         m_positions_bodies.segment<4>(body_id_7 + 3) /= quaternion_norm;
     }
+
+    UpdateGraph::touch(m_input_versions, UpdateGraph::Positions);
 }
 
 void
@@ -515,7 +571,6 @@ void
 SystemData::rbmMatrixElement(const int particle_id)
 {
     const int particle_id_3{3 * particle_id};
-    const int particle_id_7{7 * particle_id};
     const int body_id_7{7 * m_particle_group_id(particle_id)};
 
     // \[r_\alpha ^\]: skew-symmetric matrix representation of cross product
@@ -532,14 +587,15 @@ SystemData::rbmMatrixElement(const int particle_id)
     const Eigen::Matrix4d two_E_T = 2.0 * E_body.transpose();
 
     // rigid body motion connectivity tensor elements
-    m_rbm_conn.block<3, 3>(body_id_7, particle_id_7).noalias() = m_I3; // translation-translation couple
+    RbmConnBlock& rbm_conn_block = m_rbm_conn_blocks[particle_id];
+
+    rbm_conn_block.block<3, 3>(0, 0).noalias() = m_I3; // translation-translation couple
 
     /// @FIXME: (check literature) The teaching SD to swim paper had a negative sign here, but my derivations do not
     /// have that
-    m_rbm_conn.block<4, 3>(body_id_7 + 3, particle_id_7).noalias() =
-        two_E_T * mat_dr_cross_43; // translation-quaternion couple
+    rbm_conn_block.block<4, 3>(3, 0).noalias() = two_E_T * mat_dr_cross_43; // translation-quaternion couple
 
-    m_rbm_conn.block<4, 4>(body_id_7 + 3, particle_id_7 + 3).noalias() = two_E_T; // quaternion-quaternion couple
+    rbm_conn_block.block<4, 4>(3, 3).noalias() = two_E_T; // quaternion-quaternion couple
 }
 
 void
@@ -581,131 +637,122 @@ SystemData::chiMatrixElement(const int particle_id)
     g_matrix.row(3).noalias()            = -r_theta_k.vec();
 
     /* ANCHOR: Compute chi matrix element */
-    m_chi.block<3, 3>(body_id_7, particle_id_3).noalias() =
+    ChiBlock& chi_block = m_chi_blocks[particle_id];
+
+    chi_block.block<3, 3>(0, 0).noalias() =
         m_I3; // convert body (linear) position derivatives to particle linear coordinate derivatives
-    m_chi.block<4, 3>(body_id_7 + 3, particle_id_3).noalias() =
+    chi_block.block<4, 3>(3, 0).noalias() =
         g_matrix; // convert body (quaternion) position derivatives to particle linear coordinate derivatives
+
+    for (int j = 0; j < 3; j++)
+    {
+        for (int i = 0; i < 7; i++)
+        {
+            m_tens_chi(body_id_7 + i, particle_id_3 + j) = chi_block(i, j);
+        }
+    }
 }
 
 void
-SystemData::gradRbmConnTensorElement(const int particle_id, const Eigen::ThreadPoolDevice& device)
+SystemData::gradRbmConnTensorElement(const int particle_id)
 {
     /* ANCHOR: Tensor indices */
     const int  particle_id_3{3 * particle_id};
-    const int  particle_id_7{7 * particle_id};
-    const int  body_id_7{7 * m_particle_group_id(particle_id)};
     const bool is_locater{m_particle_type_id(particle_id) == 1};
 
-    // `Eigen::Tensor` contract indices
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_ilk_lj = {
-        Eigen::IndexPair<int>(1, 0)}; // {i, l, k} . {l, j} --> {i, k, j}
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_ljk = {
-        Eigen::IndexPair<int>(1, 0)}; // {l, i} . {l, j, k} --> {i, j, k}
-    const Eigen::array<Eigen::IndexPair<int>, 1> contract_ljm_km = {
-        Eigen::IndexPair<int>(2, 1)}; // {l, j, m} . {k, m} --> {l, j, k}
-
-    // `Eigen::Tensor` permute indices
-    const Eigen::array<int, 3> permute_ikj_ijk({0, 2, 1}); // {i, k, j} --> {i, j, k}
-
-    // `Eigen::Tensor` output tensor indices start location (offset) and extent
-    const Eigen::array<Eigen::Index, 3> offset_grad_Rc_r_cross  = {1, 0, 0};
-    const Eigen::array<Eigen::Index, 3> extents_grad_Rc_r_cross = {3, 3, 3};
+    GradRbmConnBlock& grad_rbm_conn_block = m_grad_rbm_conn_blocks[particle_id];
 
-    const Eigen::array<Eigen::Index, 3> offset_grad_theta_r_cross  = {1, 0, 3};
-    const Eigen::array<Eigen::Index, 3> extents_grad_theta_r_cross = {3, 3, 4};
-
-    const Eigen::array<Eigen::Index, 3> offsets_mixed = {body_id_7 + 3, particle_id_7, body_id_7};
-    const Eigen::array<Eigen::Index, 3> extents_mixed = {4, 3, 7};
-
-    const Eigen::array<Eigen::Index, 3> offsets_angular = {body_id_7 + 3, particle_id_7 + 3, body_id_7};
-    const Eigen::array<Eigen::Index, 3> extents_angular = {4, 4, 7};
+    /* NOTE: the (4 x 3 x 7) mixed and (4 x 4 x 7) angular blocks are evaluated one slice k (body coordinate
+     * derivative) at a time with fixed-size matrices, as fixed-size tensor contractions and shuffles evaluate into
+     * heap temporaries. Column-major slice k of a fixed-size tensor with leading dimensions (a, b) is the (a x b)
+     * matrix at offset a * b * k */
 
     /* ANCHOR: Tensor quantities that will be contracted */
-    // moment arm to locater point from particle
+    // moment arm to locater point from particle (rows 1-3 of r_tilde_cross{l, j}, row 0 vanishes)
     Eigen::Matrix3d mat_two_dr_cross;
     crossProdMat(2.0 * m_positions_particles_articulation.segment<3>(particle_id_3), mat_two_dr_cross);
-    // preprend row of zeros
-    Eigen::Matrix<double, 4, 3> two_r_tilde_cross_mat = Eigen::MatrixXd::Zero(4, 3);
-    two_r_tilde_cross_mat.block<3, 3>(1, 0).noalias() = mat_two_dr_cross;
 
-    const Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3>> tens_two_r_tilde_cross_mat =
-        TensorCast(two_r_tilde_cross_mat, 4, 3);
-
-    // E_{(i)}: matrix representation of body quaternion from m_rbm_conn
-    const Eigen::TensorFixedSize<double, Eigen::Sizes<4, 4>> tens_two_ET_body =
-        TensorCast(m_rbm_conn.block<4, 4>(body_id_7 + 3, particle_id_7 + 3), 4, 4);
+    // E_{(i)}: matrix representation of body quaternion (NOTE: not read from m_rbm_conn_blocks, so that
+    // `rigidBodyMotionTensors()` and `gradientChangeOfVariableTensors()` are independent)
+    Eigen::Matrix4d E_body;
+    eMatrix(m_positions_bodies.segment<4>(7 * m_particle_group_id(particle_id) + 3), E_body);
+    const Eigen::Matrix4d two_ET_body = 2.0 * E_body.transpose();
 
     // G_{(i) a}: Jacobian matrix from particle positions to body quaternion
-    const Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3>> tens_g_ia =
-        TensorCast(m_chi.block<4, 3>(body_id_7 + 3, particle_id_3), 4, 3); // (4, 3)
+    const Eigen::Matrix<double, 4, 3> g_ia = m_chi_blocks[particle_id].block<4, 3>(3, 0); // (4, 3)
 
-    /* ANCHOR: tensor contractions for left-half of gradient */
-    // compute grad_r_cross{l, j, k}
-    Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3, 7>> grad_r_cross; // (4, 3, 7)  {l, j, k}
-    grad_r_cross.setZero();
-
-    if (!is_locater)
+    for (int k = 0; k < 7; k++)
     {
-        grad_r_cross.slice(offset_grad_Rc_r_cross, extents_grad_Rc_r_cross).device(device) =
-            m_levi_cevita; // body locater point gradient
-        grad_r_cross.slice(offset_grad_theta_r_cross, extents_grad_theta_r_cross).device(device) =
-            -m_levi_cevita.contract(tens_g_ia, contract_ljm_km); // body unit quaternion gradient
-    }
+        const Eigen::Map<const Eigen::Matrix4d> kappa_k(m_kappa.data() + 16 * k); // (4, 4)  {i, l}
 
-    // compute 2ET_grad_r{i, j, k} = 2ET_{i, l} grad_r_cross{l, j, k}
-    Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3, 7>> two_ET_grad_r_cross; // (4, 3, 7)  {i, j, k}
-    two_ET_grad_r_cross.device(device) = tens_two_ET_body.contract(grad_r_cross, contract_il_ljk);
+        /* ANCHOR: left-half of gradient */
+        // grad_r_cross{l, j, k} for l = 1, 2, 3 (row l = 0 vanishes)
+        Eigen::Matrix3d grad_r_cross_k = Eigen::Matrix3d::Zero();
 
-    // compute 2grad_E_r_cross_{i, k, j} = Kappa{i, l, k} r_cross{l, j}
-    Eigen::TensorFixedSize<double, Eigen::Sizes<4, 7, 3>> two_grad_ET_r_cross_preshuffle; // (4, 7, 3)  {i, k, j}
-    two_grad_ET_r_cross_preshuffle.device(device) = m_kappa.contract(tens_two_r_tilde_cross_mat, contract_ilk_lj);
-    // shuffle two_grad_ET_r_cross_preshuffle
-    Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3, 7>> two_grad_ET_r_cross_tilde; // (4, 3, 7)  {i, j, k}
-    two_grad_ET_r_cross_tilde.device(device) = two_grad_ET_r_cross_preshuffle.shuffle(permute_ikj_ijk);
+        if (!is_locater)
+        {
+            if (k < 3)
+            {
+                // body locater point gradient
+                grad_r_cross_k.noalias() = Eigen::Map<const Eigen::Matrix3d>(m_levi_cevita.data() + 9 * k);
+            }
+            else
+            {
+                // body unit quaternion gradient
+                for (int m = 0; m < 3; m++)
+                {
+                    grad_r_cross_k.noalias() -=
+                        g_ia(k - 3, m) * Eigen::Map<const Eigen::Matrix3d>(m_levi_cevita.data() + 9 * m);
+                }
+            }
+        }
 
-    // mixed gradient term
-    Eigen::TensorFixedSize<double, Eigen::Sizes<4, 3, 7>> mixed_gradient; // (4, 3, 7)  {i, j, k}
-    mixed_gradient.device(device) = two_grad_ET_r_cross_tilde;
-    mixed_gradient.device(device) += two_ET_grad_r_cross;
-    m_tens_grad_rbm_conn.slice(offsets_mixed, extents_mixed).device(device) = mixed_gradient;
+        // mixed gradient term: 2ET_{i, l} grad_r_cross{l, j, k} + Kappa{i, l, k} r_tilde_cross{l, j}
+        Eigen::Matrix<double, 4, 3> mixed_gradient_k; // (4, 3)  {i, j}
+        mixed_gradient_k.noalias() = two_ET_body.rightCols<3>() * grad_r_cross_k;
+        mixed_gradient_k.noalias() += kappa_k.rightCols<3>() * mat_two_dr_cross;
 
-    /* ANCHOR: tensor contractions for quaternion-quaternion of gradient term */
-    m_tens_grad_rbm_conn.slice(offsets_angular, extents_angular).device(device) = 2.0 * m_kappa;
+        /* ANCHOR: write mixed and quaternion-quaternion gradient terms */
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                grad_rbm_conn_block(3 + i, j, k) = mixed_gradient_k(i, j);
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                grad_rbm_conn_block(3 + i, 3 + j, k) = 2.0 * kappa_k(i, j);
+            }
+        }
+    }
 }
 
 void
-SystemData::rigidBodyMotionTensors(const Eigen::ThreadPoolDevice& device)
+SystemData::rigidBodyMotionTensors()
 {
-    /* ANCHOR: Compute m_rbm_conn */
-    m_rbm_conn.setZero();
-
+    /* ANCHOR: Compute m_rbm_conn_blocks */
     for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
     {
         rbmMatrixElement(particle_id);
     }
-
-    m_tens_rbm_conn = TensorCast(m_rbm_conn, 7 * m_num_bodies, 7 * m_num_particles);
 }
 
 void
-SystemData::gradientChangeOfVariableTensors(const Eigen::ThreadPoolDevice& device)
+SystemData::gradientChangeOfVariableTensors()
 {
-    /* ANCHOR: Compute m_chi and m_tens_chi */
-    m_chi.setZero();
-
+    /* ANCHOR: Compute m_chi_blocks and m_tens_chi
+     * NOTE: particles only write to the (7 x 3) block of their own body, so elements of `m_tens_chi` outside of these
+     * blocks stay zero from initialization */
     for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
     {
         chiMatrixElement(particle_id);
     }
 
-    m_tens_chi = TensorCast(m_chi, 7 * m_num_bodies, 3 * m_num_particles);
-
-    /* ANCHOR : Compute m_tens_grad_rbm_conn */
-    m_tens_grad_rbm_conn.setZero();
-
+    /* ANCHOR : Compute m_grad_rbm_conn_blocks */
     for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
     {
-        gradRbmConnTensorElement(particle_id, device);
+        gradRbmConnTensorElement(particle_id);
     }
 }
 
@@ -790,27 +837,49 @@ SystemData::convertBody2ParticlePos()
 }
 
 void
-SystemData::convertBody2ParticleVelAcc(const Eigen::ThreadPoolDevice& device)
+SystemData::convertBody2ParticleVel(const Eigen::ThreadPoolDevice& device)
 {
-    /* ANCHOR: Convert velocity D.o.F. */
-    m_velocities_particles.noalias() = m_rbm_conn.transpose() * m_velocities_bodies;
-    m_velocities_particles.noalias() += m_velocities_particles_articulation;
+    /* NOTE: \Sigma only couples a particle to the body it belongs to, so the conversion is evaluated one (7 x 7)
+     * particle block at a time */
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_7{7 * particle_id};
+        const int body_id_7{7 * m_particle_group_id(particle_id)};
 
-    /* ANCHOR: Convert acceleration D.o.F. */
+        m_velocities_particles.segment<7>(particle_id_7).noalias() =
+            m_rbm_conn_blocks[particle_id].transpose() * m_velocities_bodies.segment<7>(body_id_7);
+        m_velocities_particles.segment<7>(particle_id_7).noalias() +=
+            m_velocities_particles_articulation.segment<7>(particle_id_7);
+    }
+}
 
-    // Eigen::Tensor contraction indices
-    const Eigen::array<Eigen::IndexPair<int>, 0> outer_product   = {}; // no contractions
-    const Eigen::array<Eigen::IndexPair<int>, 2> contract_jik_jk = {
-        Eigen::IndexPair<int>(0, 0), Eigen::IndexPair<int>(2, 1)}; // {j i k}, {j k} --> {i}
+void
+SystemData::convertBody2ParticleAcc() const
+{
+    /* NOTE: \Sigma and \nabla \Sigma only couple a particle to the body it belongs to, so the conversion is
+     * evaluated one (7 x 7) particle block at a time */
+    for (int particle_id = 0; particle_id < m_num_particles; particle_id++)
+    {
+        const int particle_id_7{7 * particle_id};
+        const int body_id_7{7 * m_particle_group_id(particle_id)};
+
+        const RbmConnBlock&               rbm_conn_block = m_rbm_conn_blocks[particle_id];
+        const Eigen::Matrix<double, 7, 1> xi_dot         = m_velocities_bodies.segment<7>(body_id_7);
+
+        // (grad Sigma)_{j c k} xi_j xi_k, summed over slices k of the gradient block
+        Eigen::Matrix<double, 7, 1> acc_rbm = rbm_conn_block.transpose() * m_accelerations_bodies.segment<7>(body_id_7);
 
-    const Eigen::Tensor<double, 1> xi    = TensorCast(m_velocities_bodies, 7 * m_num_bodies); // (7M x 1)
-    const Eigen::Tensor<double, 2> xi_xi = xi.contract(xi, outer_product);                    // (7M x 7M)
+        for (int k = 0; k < 7; k++)
+        {
+            const Eigen::Map<const RbmConnBlock> grad_rbm_conn_k(m_grad_rbm_conn_blocks[particle_id].data() + 49 * k);
+
+            acc_rbm.noalias() += xi_dot(k) * (grad_rbm_conn_k.transpose() * xi_dot);
+        }
 
-    Eigen::Tensor<double, 1> velocities_rbm_particles = Eigen::Tensor<double, 1>(7 * m_num_particles); // (7N x 1)
-    velocities_rbm_particles.device(device)           = m_tens_grad_rbm_conn.contract(xi_xi, contract_jik_jk);
-    const Eigen::VectorXd mat_vel_rbm_particles = MatrixCast(velocities_rbm_particles, 7 * m_num_particles, 1, device);
+        m_accelerations_particles.segment<7>(particle_id_7).noalias() = acc_rbm;
+        m_accelerations_particles.segment<7>(particle_id_7).noalias() +=
+            m_accelerations_particles_articulation.segment<7>(particle_id_7);
+    }
 
-    m_accelerations_particles.noalias() = mat_vel_rbm_particles;                            // (7N x 1)
-    m_accelerations_particles.noalias() += m_rbm_conn.transpose() * m_accelerations_bodies; // (7N x 1)
-    m_accelerations_particles.noalias() += m_accelerations_particles_articulation;          // (7N x 1)
+    m_accelerations_particles_dirty = false;
 }
@@ -11,8 +11,9 @@
 #endif
 
 /* Include all internal project dependencies */
-#include <GSDUtil.hpp> // GSD parser
-#include <gsd.h>       // GSD File
+#include <GSDUtil.hpp>     // GSD parser
+#include <UpdateGraph.hpp> // dependency tracking of update()
+#include <gsd.h>           // GSD File
 
 /* Include all external project dependencies */
 // Intel MKL
@@ -30,6 +31,8 @@
 #include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
 // eigen3 conversion between Eigen::Tensor (unsupported) and Eigen::Matrix
 #include <helper_eigenTensorConversion.hpp>
+// eigen3 thread-pool parallel loops and tasks
+#include <helper_eigenParallelFor.hpp>
 // Logging
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -40,6 +43,7 @@
 #include <stdexcept> // std::errors
 #include <string>    // std::string
 #include <thread>    // std::thread::hardware_concurrency(); number of physical cores
+#include <vector>    // std::vector
 
 /* Forward declarations */
 class GSDUtil;
@@ -59,6 +63,14 @@ class SystemData : public std::enable_shared_from_this<SystemData>
 {
     /* SECTION: Public methods */
   public:
+    /// (7 x 7) block of @f$ \boldsymbol{\Sigma} @f$ coupling one particle to its body
+    using RbmConnBlock = Eigen::Matrix<double, 7, 7>;
+    /// (7 x 3) block of @f$ \boldsymbol{\chi} @f$ coupling one particle to its body
+    using ChiBlock = Eigen::Matrix<double, 7, 3>;
+    /// (7 x 7 x 7) block of @f$ \nabla_{\xi} \boldsymbol{\Sigma} @f$ of one particle: element (j, c, k) couples body
+    /// coordinate j, particle coordinate c and body coordinate derivative k of its body
+    using GradRbmConnBlock = Eigen::TensorFixedSize<double, Eigen::Sizes<7, 7, 7>>;
+
     /**
      * @brief Construct a new system Data object. Default constructor.
      *
@@ -73,6 +85,18 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      */
     SystemData(std::string inputGSDFile, std::string outputDir);
 
+    /**
+     * @brief Construct a worker copy of a (fully initialized) system Data object, e.g. for concurrent time
+     * integration.
+     *
+     * @details All simulation data is copied. The copy does not perform GSD I/O, and its logger, and those of classes
+     * constructed from it, are named with the suffix `logTag` so that copies can be used concurrently.
+     *
+     * @param other system Data object to copy
+     * @param logTag suffix of logger names, must be unique among live copies
+     */
+    SystemData(const SystemData& other, const std::string& logTag);
+
     /**
      * @brief Destroy the system Data object
      *
@@ -99,8 +123,9 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      * @brief Updates all relevant rigid body motion tensors, respective gradients, and kinematic/Udwadia constraints.
      * Assumes `m_t` is current simulation time to update variables at.
      *
-     * @details Many functions are called and there is a dependency chain between them.
-     * The functions are grouped in the implementation and clearly denote the relative ordering that must occur.
+     * @details Many functions are called and there is a dependency chain between them, see `m_update_graph`.
+     * A stage is only evaluated if time or a body state it depends on was set since its last evaluation, e.g. a change
+     * of the body velocities only does not recompute the rigid body motion tensors.
      *
      * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
      */
@@ -198,7 +223,7 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      * Sigma matrix represents the transformation of coordinates from (linear/angular) body
      * coordinates to (linear/angular) particle relative configuration position coordinates.
      *
-     * @details Modifies `m_rbm_conn`
+     * @details Modifies `m_rbm_conn_blocks`
      *
      * @param particle_id Particle number (alpha, i is body number)
      */
@@ -222,7 +247,7 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      * chi matrix represents the transformation of gradient coordinates from (linear/quaternion) body
      * coordinates to (linear) particle relative configuration position coordinates.
      *
-     * @details Modifies `m_chi`
+     * @details Modifies `m_chi_blocks` and the corresponding elements of `m_tens_chi`
      *
      * @see For Wikipedia typeset version of rotated position w.r.t. body quaternion:
      * https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation#Differentiation_with_respect_to_the_rotation_quaternion
@@ -239,16 +264,16 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     /**
      * @brief Computes \nabla_{\xi} \Sigma_{i \alpha} tensor for given particle number and body number.
      *
-     * @details Modifies `m_tens_grad_rbm_conn`
+     * @details Modifies `m_grad_rbm_conn_blocks`
      * Some variables must be pre-computed:
-     *     `m_rbm_conn`
+     *     `m_rbm_conn_blocks`
      *     `m_psi_conv_quat_ang`
-     *     `m_chi`
+     *     `m_chi_blocks`
      *
      * @param particle_id Particle number (alpha, i is body number)
      */
     void
-    gradRbmConnTensorElement(const int particle_id, const Eigen::ThreadPoolDevice& device);
+    gradRbmConnTensorElement(const int particle_id);
 
     /**
      * @brief Computes the rigid body motion connectivity tensors.
@@ -260,11 +285,9 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      * rotation about internal axes. We do not worry about that here due to no-flux boundary conditions on surfaces
      * rather than no-slip boundary conditions): Swan, James W., et al. "Modeling hydrodynamic self-propulsion with
      * Stokesian Dynamics. Or teaching Stokesian Dynamics to swim." Physics of Fluids 23.7 (2011): 071901.
-     *
-     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
      */
     void
-    rigidBodyMotionTensors(const Eigen::ThreadPoolDevice& device);
+    rigidBodyMotionTensors();
 
     /**
      * @brief Computes the gradients rigid body motion connectivity tensors and tensors associated with change
@@ -272,11 +295,9 @@ class SystemData : public std::enable_shared_from_this<SystemData>
      *
      * @details This function computes the tensors required to convert gradient body locater kinematics into
      * particle kinematics. It relies on `m_particle_type_id` being set with the correct convention.
-     *
-     * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
      */
     void
-    gradientChangeOfVariableTensors(const Eigen::ThreadPoolDevice& device);
+    gradientChangeOfVariableTensors();
     /* !SECTION (Rigid body motion) */
 
     /* SECTION: Convert between body and particle degrees of freedom */
@@ -295,14 +316,22 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     convertBody2ParticlePos();
 
     /**
-     * @brief Computes the particle D.o.F. from the body D.o.F.
-     *
-     * @details Currently only computes the velocity and acceleration D.o.F. components
+     * @brief Computes the particle velocity D.o.F. from the body D.o.F.
      *
      * @param device `Eigen::ThreadPoolDevice` to use for `Eigen::Tensor` computations
      */
     void
-    convertBody2ParticleVelAcc(const Eigen::ThreadPoolDevice& device);
+    convertBody2ParticleVel(const Eigen::ThreadPoolDevice& device);
+
+    /**
+     * @brief Computes the particle acceleration D.o.F. from the body D.o.F.
+     *
+     * @details Particle accelerations are only needed for output, so they are not computed in `update()`, but by
+     * `accelerationsParticles()` once the body state changed. Uses the rigid body motion tensors of the last
+     * `update()` and the current body velocities and accelerations.
+     */
+    void
+    convertBody2ParticleAcc() const;
     /* !SECTION (Convert between body and particle degrees of freedom) */
 
     /* SECTION: Static methods */
@@ -356,6 +385,62 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     /// If the simulation system is constrained to be that of an image (neglect second 1/2 of DoF)
     /// @review_swimmer change if not using image-system constraints
     bool m_image_system{false};
+    /// If hydrodynamic forces are evaluated matrix-free from the particle pairs instead of through the rank-3
+    /// (N1, N2, N3) mass gradient tensors
+    bool m_matrix_free_hydro{false};
+    /// Relative error tolerance of the added mass matrix elements neglected by truncating pairwise interactions at a
+    /// finite cutoff distance. Non-positive values disable the cutoff and all particle pairs are evaluated
+    double m_pair_tolerance{0.0};
+    /// Skin distance of the Verlet neighbor list used with a finite pair cutoff (units of particle radius)
+    double m_neighbor_skin{1.0};
+    /// Opening angle of the treecode used for added mass matrix-vector products in matrix-free mode, in (0, 1).
+    /// Non-positive values use dense matrix-vector products
+    double m_treecode_theta{0.0};
+    /// If hydrodynamic tensors of an image system only store the real 1/2 of the particles, with the image particles
+    /// added analytically through the reflection about the xy-plane. Only used if `m_image_system`
+    bool m_mirror_hydro{false};
+    /// Absolute error tolerance of adaptive time stepping on body positions and velocities. Adaptive time stepping is
+    /// used if either tolerance is positive
+    double m_adaptive_atol{0.0};
+    /// Relative error tolerance of adaptive time stepping on body positions and velocities
+    double m_adaptive_rtol{0.0};
+    /// Solver of the Udwadia-Kalaba constrained accelerations: 0 (eigendecomposition and pseudo-inverse), 1 (Cholesky
+    /// factorization and Schur complement over the unit quaternion constraints), 2 (matrix-free projected conjugate
+    /// gradient with block-Jacobi preconditioner)
+    int m_udwadia_solver{0};
+    /// Relative residual tolerance of iterative refinement with the Cholesky factorization of a previous effective mass
+    /// matrix (Cholesky Udwadia-Kalaba solver only). Non-positive values factorize the effective mass matrix at every
+    /// solve
+    double m_udwadia_refactor_tol{0.0};
+    /// Time integration scheme of `RungeKutta4`: 0 (classical Runge-Kutta in quaternion coordinates with Udwadia-Kalaba
+    /// constraints), 1 (Lie-group Runge-Kutta-Munthe-Kaas with the quaternion exponential map), 2 (RATTLE velocity
+    /// Verlet)
+    int m_integrator_scheme{0};
+    /// Maximum number of fixed-point iterations (acceleration updates per step) of the implicit final kick of the
+    /// RATTLE integrator scheme
+    int m_rattle_iterations{2};
+    /// Number of gait periods resolved by the integrator between stroboscopic macro-steps of `Engine`
+    int m_multirate_micro_periods{1};
+    /// Number of gait periods skipped by each stroboscopic macro-step of `Engine`. Non-positive values resolve all
+    /// periods
+    int m_multirate_macro_periods{0};
+    /// Newton residual tolerance of the periodic orbit solve of `Engine`. Positive values find the periodic orbit with
+    /// `PeriodicOrbit` instead of integrating to `m_tf`
+    double m_periodic_orbit_tol{0.0};
+    /// Relative tolerance of the per-period quantities of the steady-state monitor of `Engine`. Positive values stop
+    /// the run once the steady state is reached
+    double m_steady_state_tol{0.0};
+    /// Absolute tolerance of the per-period quantities of the steady-state monitor of `Engine`, for quantities that
+    /// vanish at the steady state
+    double m_steady_state_atol{0.0};
+    /// Number of consecutive gait periods the per-period quantities must change less than the tolerances
+    int m_steady_state_periods{3};
+    /// Number of time slices integrated in parallel by `Parareal` in `Engine`. Values less than 2 integrate serially
+    int m_parareal_slices{0};
+    /// Ratio of the coarse to the fine (`m_dt`) time step of `Parareal`
+    int m_parareal_coarse_ratio{10};
+    /// Relative tolerance of the slice states of the `Parareal` iterations
+    double m_parareal_tol{1.0e-8};
 
     /* ANCHOR: general attributes */
     // data i/o
@@ -366,12 +451,16 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     /// path of logfile for spdlog to write to
     std::string m_logFile;
     /// filename of logfile for spdlog to write to
-    const std::string m_logName{"SystemData"};
+    std::string m_logName{"SystemData"};
+    /// suffix of logger names of this object and of classes constructed from it (empty, except for worker copies)
+    std::string m_logTag;
 
     // GSD data
     /// shared pointer reference to `GSDUtil` class
     std::shared_ptr<GSDUtil>    m_gsdUtil;
     std::shared_ptr<gsd_handle> m_handle{new gsd_handle};
+    /// If `m_handle` is closed on destruction (false for worker copies, which share no GSD file)
+    bool m_gsd_owner{true};
     /// defaults to GSD_SUCCESS return value
     int m_return_val{0};
     /// defaults to successful parse GSD flag
@@ -463,6 +552,20 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     double m_E_hydro_int{0.0};
     double m_E_hydro_simple{0.0};
 
+    /* ANCHOR: periodic orbit results */
+    /// Residual norm of the periodic orbit solve
+    double m_periodic_orbit_residual{0.0};
+    /// Displacement of the first body over one period of the periodic orbit
+    Eigen::Vector3d m_periodic_orbit_displacement{Eigen::Vector3d::Zero()};
+    /// (k x 2) real and imaginary parts of the Floquet multipliers of the periodic orbit
+    Eigen::MatrixXd m_floquet_multipliers;
+
+    /* ANCHOR: steady-state results */
+    /// Time the steady state was reached (negative if not reached)
+    double m_steady_state_time{-1.0};
+    /// Per-period quantities of the steady-state monitor of `Engine` when the steady state was reached
+    Eigen::VectorXd m_steady_state_values;
+
     /* ANCHOR: Tensors set in constructor */
     // "identity" tensors
     /// (3 x 3) 2nd order identity tensor
@@ -488,8 +591,10 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     Eigen::VectorXd m_positions_particles;
     /// (7N x 1) (linear/angular) velocities of all particles
     Eigen::VectorXd m_velocities_particles;
-    /// (7N x 1) (linear/angular) accelerations of all particles
-    Eigen::VectorXd m_accelerations_particles;
+    /// (7N x 1) (linear/angular) accelerations of all particles, evaluated lazily (output only)
+    mutable Eigen::VectorXd m_accelerations_particles;
+    /// true if the body state changed after `m_accelerations_particles` was last evaluated
+    mutable bool m_accelerations_particles_dirty{true};
 
     /// (3N x 1) orientations of all particles
     Eigen::VectorXd m_orientations_particles;
@@ -507,20 +612,45 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     Eigen::VectorXd m_accelerations_particles_articulation;
 
     /* ANCHOR: rigid body motion tensors */
-    /// (7M x 7N) @f$ \boldsymbol{\Sigma} @f$ rigid body motion connectivity tensor
-    Eigen::MatrixXd m_rbm_conn;
-
-    /// (7M x 7N) tensor version of `m_rbm_conn`
-    Eigen::Tensor<double, 2> m_tens_rbm_conn;
-
-    /// (7M x 7N x 7M) @f$ \nabla_{\xi} \boldsymbol{\sigma} @f$
-    Eigen::Tensor<double, 3> m_tens_grad_rbm_conn;
+    /* NOTE: a particle only couples to the body it belongs to, so the rigid body motion tensors are stored as one
+     * block per particle */
+    /// (N x 1) non-zero (7 x 7) blocks of the (7M x 7N) @f$ \boldsymbol{\Sigma} @f$ rigid body motion connectivity
+    /// tensor, block of particle p starts at (7 * body of p, 7 * p)
+    std::vector<RbmConnBlock> m_rbm_conn_blocks;
+    /// (N x 1) non-zero (7 x 3) blocks of the (7M x 3N) @f$ \boldsymbol{\chi} @f$ tensor, which converts particle
+    /// position D.o.F. to body position/quaternion D.o.F., block of particle p starts at (7 * body of p, 3 * p)
+    std::vector<ChiBlock> m_chi_blocks;
+
+    /// (7M x 3N) @f$ \boldsymbol{\chi} @f$ as a tensor, for `BlockSparseGradient::contractChi()`
+    Eigen::Tensor<double, 2> m_tens_chi;
+    /// (N x 1) non-zero (7 x 7 x 7) blocks of @f$ \nabla_{\xi} \boldsymbol{\Sigma} @f$, block of particle p starts
+    /// at (7 * body of p, 7 * p, 7 * body of p)
+    std::vector<GradRbmConnBlock> m_grad_rbm_conn_blocks;
+
+    /* ANCHOR: Update dependency graph */
+    /// Stages of `update()`, in evaluation order
+    enum UpdateStage : int
+    {
+        StageOrientation        = 0, ///< particle orientations
+        StageArticulation       = 1, ///< particle articulation positions, velocities and accelerations
+        StageRbmTensors         = 2, ///< particle positions and rigid body motion tensors
+        StageParticleKinematics = 3, ///< particle velocities
+        StageUdwadia            = 4, ///< Udwadia constraint linear system
+    };
 
-    /// (7M x 3N) @f$ \boldsymbol{\chi} @f$ converts particle position D.o.F. to body position/quaternion D.o.F.
-    Eigen::MatrixXd m_chi;
+    /// dependency graph of the stages of `update()`
+    UpdateGraph m_update_graph{{
+        {UpdateGraph::Positions, {}},                           // StageOrientation
+        {UpdateGraph::Time, {StageOrientation}},                // StageArticulation
+        {UpdateGraph::Positions, {StageArticulation}},          // StageRbmTensors
+        {UpdateGraph::Velocities, {StageRbmTensors}},           // StageParticleKinematics
+        {UpdateGraph::Positions | UpdateGraph::Velocities, {}}, // StageUdwadia
+    }};
 
-    /// (7M x 3N) tensor version of `m_chi`
-    Eigen::Tensor<double, 2> m_tens_chi;
+    /// version counters of time and body positions, velocities and accelerations, incremented by their setters
+    UpdateGraph::Versions m_input_versions{};
+    /// version counters the particle data and rigid body motion tensors were last updated at
+    UpdateGraph::Versions m_updated_versions{};
 
     /* ANCHOR: Udwadia constraint linear system */
     /// (number_constraints x 7M) linear operator defining relationship between constraints on @f$
@@ -545,6 +675,226 @@ class SystemData : public std::enable_shared_from_this<SystemData>
         m_image_system = image_system;
     }
 
+    bool
+    matrixFreeHydro() const
+    {
+        return m_matrix_free_hydro;
+    }
+    void
+    setMatrixFreeHydro(bool matrix_free_hydro)
+    {
+        m_matrix_free_hydro = matrix_free_hydro;
+    }
+
+    double
+    pairTolerance() const
+    {
+        return m_pair_tolerance;
+    }
+    void
+    setPairTolerance(double pair_tolerance)
+    {
+        m_pair_tolerance = pair_tolerance;
+    }
+
+    double
+    neighborSkin() const
+    {
+        return m_neighbor_skin;
+    }
+    void
+    setNeighborSkin(double neighbor_skin)
+    {
+        m_neighbor_skin = neighbor_skin;
+    }
+
+    double
+    treecodeTheta() const
+    {
+        return m_treecode_theta;
+    }
+    void
+    setTreecodeTheta(double treecode_theta)
+    {
+        m_treecode_theta = treecode_theta;
+    }
+
+    bool
+    mirrorHydro() const
+    {
+        return m_mirror_hydro;
+    }
+    void
+    setMirrorHydro(bool mirror_hydro)
+    {
+        m_mirror_hydro = mirror_hydro;
+    }
+
+    double
+    adaptiveAtol() const
+    {
+        return m_adaptive_atol;
+    }
+    void
+    setAdaptiveAtol(double adaptive_atol)
+    {
+        m_adaptive_atol = adaptive_atol;
+    }
+
+    double
+    adaptiveRtol() const
+    {
+        return m_adaptive_rtol;
+    }
+    void
+    setAdaptiveRtol(double adaptive_rtol)
+    {
+        m_adaptive_rtol = adaptive_rtol;
+    }
+
+    int
+    udwadiaSolver() const
+    {
+        return m_udwadia_solver;
+    }
+    void
+    setUdwadiaSolver(int udwadia_solver)
+    {
+        m_udwadia_solver = udwadia_solver;
+    }
+
+    double
+    udwadiaRefactorTol() const
+    {
+        return m_udwadia_refactor_tol;
+    }
+    void
+    setUdwadiaRefactorTol(double udwadia_refactor_tol)
+    {
+        m_udwadia_refactor_tol = udwadia_refactor_tol;
+    }
+
+    int
+    integratorScheme() const
+    {
+        return m_integrator_scheme;
+    }
+    void
+    setIntegratorScheme(int integrator_scheme)
+    {
+        m_integrator_scheme = integrator_scheme;
+    }
+
+    int
+    rattleIterations() const
+    {
+        return m_rattle_iterations;
+    }
+    void
+    setRattleIterations(int rattle_iterations)
+    {
+        m_rattle_iterations = rattle_iterations;
+    }
+
+    int
+    multirateMicroPeriods() const
+    {
+        return m_multirate_micro_periods;
+    }
+    void
+    setMultirateMicroPeriods(int multirate_micro_periods)
+    {
+        m_multirate_micro_periods = multirate_micro_periods;
+    }
+
+    int
+    multirateMacroPeriods() const
+    {
+        return m_multirate_macro_periods;
+    }
+    void
+    setMultirateMacroPeriods(int multirate_macro_periods)
+    {
+        m_multirate_macro_periods = multirate_macro_periods;
+    }
+
+    double
+    periodicOrbitTol() const
+    {
+        return m_periodic_orbit_tol;
+    }
+    void
+    setPeriodicOrbitTol(double periodic_orbit_tol)
+    {
+        m_periodic_orbit_tol = periodic_orbit_tol;
+    }
+
+    double
+    steadyStateTol() const
+    {
+        return m_steady_state_tol;
+    }
+    void
+    setSteadyStateTol(double steady_state_tol)
+    {
+        m_steady_state_tol = steady_state_tol;
+    }
+
+    double
+    steadyStateAtol() const
+    {
+        return m_steady_state_atol;
+    }
+    void
+    setSteadyStateAtol(double steady_state_atol)
+    {
+        m_steady_state_atol = steady_state_atol;
+    }
+
+    int
+    steadyStatePeriods() const
+    {
+        return m_steady_state_periods;
+    }
+    void
+    setSteadyStatePeriods(int steady_state_periods)
+    {
+        m_steady_state_periods = steady_state_periods;
+    }
+
+    int
+    pararealSlices() const
+    {
+        return m_parareal_slices;
+    }
+    void
+    setPararealSlices(int parareal_slices)
+    {
+        m_parareal_slices = parareal_slices;
+    }
+
+    int
+    pararealCoarseRatio() const
+    {
+        return m_parareal_coarse_ratio;
+    }
+    void
+    setPararealCoarseRatio(int parareal_coarse_ratio)
+    {
+        m_parareal_coarse_ratio = parareal_coarse_ratio;
+    }
+
+    double
+    pararealTol() const
+    {
+        return m_parareal_tol;
+    }
+    void
+    setPararealTol(double parareal_tol)
+    {
+        m_parareal_tol = parareal_tol;
+    }
+
     // data i/o
     std::string
     inputGSDFile() const
@@ -552,6 +902,12 @@ class SystemData : public std::enable_shared_from_this<SystemData>
         return m_inputGSDFile;
     }
 
+    const std::string&
+    logTag() const
+    {
+        return m_logTag;
+    }
+
     std::string
     outputDir() const
     {
@@ -661,6 +1017,12 @@ class SystemData : public std::enable_shared_from_this<SystemData>
         m_particle_type_id = particle_type_id;
     }
 
+    const Eigen::VectorXi&
+    particleGroupId() const
+    {
+        return m_particle_group_id;
+    }
+
     /* ANCHOR: material parameters */
     double
     fluidDensity() const
@@ -791,7 +1153,17 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     void
     setT(double t)
     {
-        m_t = t;
+        m_t                             = t;
+        m_accelerations_particles_dirty = true;
+        UpdateGraph::touch(m_input_versions, UpdateGraph::Time);
+    }
+
+    /// version counters of time and body state the particle data and rigid body motion tensors were last updated at.
+    /// Body accelerations are not used by `update()`, so their counter is always current
+    const UpdateGraph::Versions&
+    updatedVersions() const
+    {
+        return m_updated_versions;
     }
 
     double
@@ -872,12 +1244,67 @@ class SystemData : public std::enable_shared_from_this<SystemData>
         m_E_hydro_simple = E_hydro_simple;
     }
 
-    /* ANCHOR: kinematic vectors */
+    /* ANCHOR: periodic orbit results */
+    double
+    periodicOrbitResidual() const
+    {
+        return m_periodic_orbit_residual;
+    }
+    void
+    setPeriodicOrbitResidual(double periodic_orbit_residual)
+    {
+        m_periodic_orbit_residual = periodic_orbit_residual;
+    }
+
+    const Eigen::Vector3d&
+    periodicOrbitDisplacement() const
+    {
+        return m_periodic_orbit_displacement;
+    }
+    void
+    setPeriodicOrbitDisplacement(const Eigen::Vector3d& periodic_orbit_displacement)
+    {
+        m_periodic_orbit_displacement = periodic_orbit_displacement;
+    }
+
     const Eigen::MatrixXd&
-    rbmConn() const
+    floquetMultipliers() const
     {
-        return m_rbm_conn;
+        return m_floquet_multipliers;
     }
+    void
+    setFloquetMultipliers(const Eigen::MatrixXd& floquet_multipliers)
+    {
+        // NOTE: number of multipliers depends on the Krylov subspace dimension
+        m_floquet_multipliers.resize(floquet_multipliers.rows(), floquet_multipliers.cols());
+        m_floquet_multipliers = floquet_multipliers;
+    }
+
+    /* ANCHOR: steady-state results */
+    double
+    steadyStateTime() const
+    {
+        return m_steady_state_time;
+    }
+    void
+    setSteadyStateTime(double steady_state_time)
+    {
+        m_steady_state_time = steady_state_time;
+    }
+
+    const Eigen::VectorXd&
+    steadyStateValues() const
+    {
+        return m_steady_state_values;
+    }
+    void
+    setSteadyStateValues(const Eigen::VectorXd& steady_state_values)
+    {
+        m_steady_state_values.resize(steady_state_values.size());
+        m_steady_state_values = steady_state_values;
+    }
+
+    /* ANCHOR: kinematic vectors */
     // bodies
     const Eigen::VectorXd&
     positionsBodies() const
@@ -887,7 +1314,9 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     void
     setPositionsBodies(const Eigen::VectorXd& positions_bodies)
     {
-        m_positions_bodies = positions_bodies;
+        m_positions_bodies              = positions_bodies;
+        m_accelerations_particles_dirty = true;
+        UpdateGraph::touch(m_input_versions, UpdateGraph::Positions);
     }
 
     const Eigen::VectorXd&
@@ -898,7 +1327,9 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     void
     setVelocitiesBodies(const Eigen::VectorXd& velocities_bodies)
     {
-        m_velocities_bodies = velocities_bodies;
+        m_velocities_bodies             = velocities_bodies;
+        m_accelerations_particles_dirty = true;
+        UpdateGraph::touch(m_input_versions, UpdateGraph::Velocities);
     }
 
     const Eigen::VectorXd&
@@ -909,7 +1340,10 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     void
     setAccelerationsBodies(const Eigen::VectorXd& accelerations_bodies)
     {
-        m_accelerations_bodies = accelerations_bodies;
+        m_accelerations_bodies          = accelerations_bodies;
+        m_accelerations_particles_dirty = true;
+        UpdateGraph::touch(m_input_versions, UpdateGraph::Accelerations);
+        UpdateGraph::touch(m_updated_versions, UpdateGraph::Accelerations); // NOTE: not used by `update()`
     }
 
     // particles
@@ -960,12 +1394,18 @@ class SystemData : public std::enable_shared_from_this<SystemData>
     const Eigen::VectorXd&
     accelerationsParticles() const
     {
+        if (m_accelerations_particles_dirty)
+        {
+            convertBody2ParticleAcc();
+        }
+
         return m_accelerations_particles;
     }
     void
     setAccelerationsParticles(const Eigen::VectorXd& accelerations_particles)
     {
-        m_accelerations_particles = accelerations_particles;
+        m_accelerations_particles       = accelerations_particles;
+        m_accelerations_particles_dirty = false;
     }
 
     // particle articulations
@@ -983,21 +1423,27 @@ class SystemData : public std::enable_shared_from_this<SystemData>
 
     /* ANCHOR: rigid body motion tensors */
     const Eigen::Tensor<double, 2>&
-    tensRbmConn() const
+    tensChi() const
     {
-        return m_tens_rbm_conn;
+        return m_tens_chi;
     }
 
-    const Eigen::Tensor<double, 3>&
-    tensGradRbmConn() const
+    const RbmConnBlock&
+    rbmConnBlock(const int particle_id) const
     {
-        return m_tens_grad_rbm_conn;
+        return m_rbm_conn_blocks[particle_id];
     }
 
-    const Eigen::Tensor<double, 2>&
-    tensChi() const
+    const ChiBlock&
+    chiBlock(const int particle_id) const
     {
-        return m_tens_chi;
+        return m_chi_blocks[particle_id];
+    }
+
+    const GradRbmConnBlock&
+    gradRbmConnBlock(const int particle_id) const
+    {
+        return m_grad_rbm_conn_blocks[particle_id];
     }
 
     /* ANCHOR: Udwadia constraint linear system */
@@ -0,0 +1,176 @@
+//
+// Created by Alec Glisman on 11/07/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_UPDATE_GRAPH_H
+#define BODIES_IN_POTENTIAL_FLOW_UPDATE_GRAPH_H
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all external project dependencies */
+// STL
+#include <array>     // std::array
+#include <cstdint>   // std::uint64_t
+#include <stdexcept> // std::errors
+#include <vector>    // std::vector
+
+/**
+ * @class UpdateGraph
+ *
+ * @brief Dependency graph of the stages of an update (e.g. `SystemData::update()`) with versioned inputs.
+ *
+ * @details Each input of the update (time and the body positions, velocities and accelerations) carries a version
+ * counter that its owner increments with `touch()` whenever the input is set.
+ * A stage reads a set of inputs directly and the outputs of its parent stages, and records the input versions it was
+ * last evaluated at.
+ * It is outdated if any input it depends on, directly or through its parents, changed since then, so e.g. a change of
+ * the velocities only does not re-evaluate the position dependent stages.
+ * The graph only holds version counters, so it is copied along with its owner.
+ *
+ */
+class UpdateGraph
+{
+  public:
+    /// Versioned inputs, as bit flags of the input mask of a stage
+    enum Input : unsigned
+    {
+        Time          = 1u << 0,
+        Positions     = 1u << 1,
+        Velocities    = 1u << 2,
+        Accelerations = 1u << 3,
+    };
+
+    /// number of versioned inputs
+    static constexpr int num_inputs{4};
+
+    /// version counters of all inputs
+    using Versions = std::array<std::uint64_t, num_inputs>;
+
+    /// Stage of the graph: inputs it reads directly and parent stages (which must be defined before it)
+    struct StageDefinition
+    {
+        unsigned         inputs;
+        std::vector<int> parents;
+    };
+
+    /**
+     * @brief Construct a new (empty) update graph object
+     *
+     */
+    UpdateGraph() = default;
+
+    /**
+     * @brief Construct a new update graph object
+     *
+     * @param stages stage definitions, indexed by stage id in evaluation order
+     */
+    explicit UpdateGraph(const std::vector<StageDefinition>& stages)
+    {
+        m_stages.resize(stages.size());
+
+        for (std::size_t stage = 0; stage < stages.size(); stage++)
+        {
+            m_stages[stage].inputs = stages[stage].inputs;
+
+            for (const int parent : stages[stage].parents)
+            {
+                if ((parent < 0) || (parent >= static_cast<int>(stage)))
+                {
+                    throw std::invalid_argument("UpdateGraph: parents must be defined before their children");
+                }
+
+                m_stages[stage].inputs |= m_stages[parent].inputs;
+            }
+        }
+    }
+
+    /**
+     * @brief Increments the version counters of inputs
+     *
+     * @param versions version counters to modify
+     * @param inputs bit mask of the inputs that changed
+     */
+    static void
+    touch(Versions& versions, const unsigned inputs)
+    {
+        for (int input = 0; input < num_inputs; input++)
+        {
+            if (inputs & (1u << input))
+            {
+                versions[input]++;
+            }
+        }
+    }
+
+    /**
+     * @brief Checks if a stage has to be (re-)evaluated
+     *
+     * @param stage stage id
+     * @param versions current input version counters
+     * @return true if the stage was never evaluated or an input it depends on changed since its last evaluation
+     */
+    bool
+    outdated(const int stage, const Versions& versions) const
+    {
+        const Stage& s = m_stages[stage];
+
+        if (!s.valid)
+        {
+            return true;
+        }
+
+        for (int input = 0; input < num_inputs; input++)
+        {
+            if ((s.inputs & (1u << input)) && (s.versions[input] != versions[input]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Records that a stage was evaluated with the given input versions
+     *
+     * @param stage stage id
+     * @param versions current input version counters
+     */
+    void
+    markCurrent(const int stage, const Versions& versions)
+    {
+        m_stages[stage].versions = versions;
+        m_stages[stage].valid    = true;
+    }
+
+    /**
+     * @brief Marks all stages outdated, e.g. after a change of data that is not a versioned input
+     *
+     */
+    void
+    invalidate()
+    {
+        for (Stage& stage : m_stages)
+        {
+            stage.valid = false;
+        }
+    }
+
+  private:
+    struct Stage
+    {
+        /// inputs the stage depends on, directly or through its parents
+        unsigned inputs{0};
+        /// input versions at the last evaluation
+        Versions versions{};
+        /// false if the stage was never evaluated
+        bool valid{false};
+    };
+
+    /// stages, indexed by stage id
+    std::vector<Stage> m_stages;
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_UPDATE_GRAPH_H
@@ -0,0 +1,182 @@
+//
+// Created by Alec Glisman on 10/25/21
+//
+
+/* Include all internal project dependencies */
+#include <PotentialHydrodynamics.hpp>
+#include <RungeKutta4.hpp>
+#include <SystemData.hpp>
+
+/* Include all external project dependencies */
+#define CATCH_CONFIG_CONSOLE_WIDTH 300
+#include <catch2/catch.hpp> // unit testing framework
+// eigen3(Linear algebra)
+#define EIGEN_USE_THREADS
+#include <eigen3/unsupported/Eigen/CXX11/ThreadPool>
+// Logging
+#include <spdlog/spdlog.h>
+// STL
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+#include <memory>  // for std::shared_ptr
+#include <string>  // std::string
+
+#if defined(__GLIBC__)
+
+/* NOTE: heap allocations of the whole test executable (including `operator new` and Eigen, which both call `malloc`)
+ * are counted by interposing the glibc allocation functions. Counting is only active inside `countAllocations()` */
+extern "C" void*
+__libc_malloc(std::size_t size);
+extern "C" void*
+__libc_calloc(std::size_t num, std::size_t size);
+extern "C" void*
+__libc_realloc(void* ptr, std::size_t size);
+
+namespace
+{
+std::atomic<bool> g_count_allocations{false};
+std::atomic<long> g_num_allocations{0};
+
+void
+recordAllocation()
+{
+    if (g_count_allocations.load(std::memory_order_relaxed))
+    {
+        g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Function>
+long
+countAllocations(Function&& func)
+{
+    g_num_allocations   = 0;
+    g_count_allocations = true;
+    func();
+    g_count_allocations = false;
+
+    return g_num_allocations;
+}
+} // namespace
+
+extern "C" void*
+malloc(std::size_t size)
+{
+    recordAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void*
+calloc(std::size_t num, std::size_t size)
+{
+    recordAllocation();
+    return __libc_calloc(num, size);
+}
+
+extern "C" void*
+realloc(void* ptr, std::size_t size)
+{
+    recordAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+TEST_CASE("Collinear swimmers: time steps without heap allocations",
+          "[Collinear-Isolated][Collinear-Wall][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    const std::string inputDataFiles[2] = {"input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd",
+                                           "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd"};
+    const std::string outputDir         = "output-collinear-RungeKutta4-allocations";
+
+    // thread-pool sizes: parallel chunks are dispatched to the thread-pool for the wall system
+    const int threadPoolSizes[2] = {1, 4};
+
+    // NOTE: `RungeKutta4` ignores adaptive time stepping for the Lie-group and RATTLE schemes, reuse of the effective
+    // mass factorization for solvers other than Cholesky, and the Udwadia-Kalaba solver for the Lie-group scheme
+    const int    integratorSchemes[3] = {0, 1, 2};
+    const int    udwadiaSolvers[3]    = {0, 1, 2};
+    const double adaptiveAtols[2]     = {0.0, 1.0e-8};
+    const bool   matrixFreeHydros[2]  = {false, true};
+    const double refactorTols[2]      = {0.0, 1.0e-12};
+
+    for (const auto& inputDataFile : inputDataFiles)
+    {
+        for (const int num_threads : threadPoolSizes)
+        {
+            for (const int integrator_scheme : integratorSchemes)
+            {
+                for (const int udwadia_solver : udwadiaSolvers)
+                {
+                    if ((integrator_scheme == 1) && (udwadia_solver != 0))
+                    {
+                        continue;
+                    }
+
+                    for (const double adaptive_atol : adaptiveAtols)
+                    {
+                        if ((integrator_scheme != 0) && (adaptive_atol > 0.0))
+                        {
+                            continue;
+                        }
+
+                        for (const bool matrix_free_hydro : matrixFreeHydros)
+                        {
+                            for (const double refactor_tol : refactorTols)
+                            {
+                                if ((udwadia_solver != 1) && (refactor_tol > 0.0))
+                                {
+                                    continue;
+                                }
+
+                                // close all previous loggers
+                                spdlog::drop_all();
+
+                                // simulation classes
+                                std::shared_ptr<SystemData>             system;
+                                std::shared_ptr<PotentialHydrodynamics> potHydro;
+                                std::shared_ptr<RungeKutta4>            rk4;
+
+                                // thread-pool device
+                                Eigen::ThreadPool       thread_pool(num_threads);
+                                Eigen::ThreadPoolDevice device(&thread_pool, num_threads);
+
+                                // Construct and initialize simulation classes
+                                REQUIRE_NOTHROW(system = std::make_shared<SystemData>(inputDataFile, outputDir));
+                                REQUIRE_NOTHROW(system->initializeData());
+                                system->setIntegratorScheme(integrator_scheme);
+                                system->setUdwadiaSolver(udwadia_solver);
+                                system->setAdaptiveAtol(adaptive_atol);
+                                system->setMatrixFreeHydro(matrix_free_hydro);
+                                system->setUdwadiaRefactorTol(refactor_tol);
+                                REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+                                REQUIRE_NOTHROW(rk4 = std::make_shared<RungeKutta4>(system, potHydro));
+
+                                // NOTE: first step fills the first-same-as-last cache
+                                rk4->integrate(device);
+                                system->setT(system->t() + system->dt());
+
+                                const long num_allocations{countAllocations([&]() {
+                                    for (int step = 0; step < 5; step++)
+                                    {
+                                        rk4->integrate(device);
+                                        system->setT(system->t() + system->dt());
+                                    }
+                                })};
+
+                                INFO("Input: " << inputDataFile << ", threads: " << num_threads
+                                               << ", integrator scheme: " << integrator_scheme
+                                               << ", Udwadia-Kalaba solver: " << udwadia_solver
+                                               << ", adaptive atol: " << adaptive_atol
+                                               << ", matrix-free: " << matrix_free_hydro
+                                               << ", refactor tol: " << refactor_tol);
+                                CHECK(num_allocations == 0);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
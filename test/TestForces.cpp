@@ -0,0 +1,218 @@
+//
+// Created by Alec Glisman on 11/02/21
+//
+
+/* Include all internal project dependencies */
+#include <PotentialHydrodynamics.hpp>
+#include <RungeKutta4.hpp>
+#include <SystemData.hpp>
+#include <TestPotentialHydrodynamics.hpp>
+
+/* Include all external project dependencies */
+#define CATCH_CONFIG_CONSOLE_WIDTH 300
+#include <catch2/catch.hpp> // unit testing framework
+// Logging
+#include <spdlog/spdlog.h>
+// STL
+#include <memory> // for std::unique_ptr and std::shared_ptr
+#include <string> // std::string
+
+TEST_CASE("Test PotentialHydrodynamics class", "[PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-PotentialHydrodynamics";
+
+    // simulation classes
+    std::shared_ptr<SystemData>                 system;
+    std::shared_ptr<PotentialHydrodynamics>     potHydro;
+    std::shared_ptr<TestPotentialHydrodynamics> testPotHydro;
+
+    // Construct and initialize classes
+    REQUIRE_NOTHROW(system = std::make_shared<SystemData>(inputDataFile, outputDir));
+    REQUIRE_NOTHROW(system->initializeData());
+    REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+    REQUIRE_NOTHROW(testPotHydro = std::make_shared<TestPotentialHydrodynamics>(potHydro));
+
+    // Return value test
+    int return_val{-1};
+
+    SECTION("Test added mass gradient")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testParticleDistances());
+        REQUIRE(return_val == 0);
+
+        REQUIRE_NOTHROW(return_val = testPotHydro->testAddedMassGrad());
+        REQUIRE(return_val == 0);
+
+        REQUIRE_NOTHROW(return_val = testPotHydro->testAddedMassGradElement());
+        REQUIRE(return_val == 0);
+
+        REQUIRE_NOTHROW(return_val = testPotHydro->testAddedMassGradBodyCoords());
+        REQUIRE(return_val == 0);
+    }
+
+    SECTION("Test incremental updates")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testUpdateGraph());
+        REQUIRE(return_val == 0);
+    }
+
+    SECTION("Test compile-time sized body mass")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testBodyMassSized());
+        REQUIRE(return_val == 0);
+    }
+
+    SECTION("Test matrix-free hydrodynamic forces")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testHydroForcesMatrixFree());
+        REQUIRE(return_val == 0);
+
+        // construct in matrix-free mode and compare to tensor forces at the same configuration
+        const Eigen::VectorXd f_hydro = potHydro->fHydro();
+        testPotHydro.reset();
+        potHydro.reset();
+
+        system->setMatrixFreeHydro(true);
+        REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+        REQUIRE(potHydro->fHydro().isApprox(f_hydro, 1.0e-6));
+    }
+
+    SECTION("Test far-field cutoff of pairwise interactions")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testNeighborList());
+        REQUIRE(return_val == 0);
+
+        const Eigen::MatrixXd m_total = potHydro->mTotal();
+        const Eigen::VectorXd f_hydro = potHydro->fHydro();
+        testPotHydro.reset();
+        potHydro.reset();
+
+        // negligible tolerance: all particle pairs are within cutoff
+        system->setPairTolerance(1.0e-12);
+        REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+        REQUIRE(potHydro->mTotal().isApprox(m_total, 1.0e-12));
+        REQUIRE(potHydro->fHydro().isApprox(f_hydro, 1.0e-12));
+        potHydro.reset();
+
+        // cutoff smaller than particle diameter: only particle self-interactions remain
+        system->setPairTolerance(1.0e3);
+        REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+
+        const int num_particles{system->numParticles()};
+        for (int alpha = 0; alpha < num_particles; alpha++)
+        {
+            for (int beta = 0; beta < num_particles; beta++)
+            {
+                if (alpha != beta)
+                {
+                    REQUIRE(potHydro->mTotal().block<7, 7>(7 * alpha, 7 * beta).isZero());
+                }
+            }
+        }
+
+        system->setPairTolerance(0.0);
+    }
+
+    SECTION("Test treecode added mass products")
+    {
+        REQUIRE_NOTHROW(return_val = testPotHydro->testDipoleTreecode());
+        REQUIRE(return_val == 0);
+
+        REQUIRE_NOTHROW(return_val = testPotHydro->testDipoleTreecodeScaling());
+        REQUIRE(return_val == 0);
+
+        const Eigen::VectorXd f_hydro = potHydro->fHydro();
+        const Eigen::MatrixXd M_body  = potHydro->mTotalBodyCoords();
+        const Eigen::Matrix3d M_01    = potHydro->mTotalLinearBlock(0, 1);
+        const double          e_loc{system->eHydroLoc()};
+        testPotHydro.reset();
+        potHydro.reset();
+
+        system->setMatrixFreeHydro(true);
+        system->setTreecodeTheta(0.5);
+        REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+        REQUIRE(potHydro->fHydro().isApprox(f_hydro, 1.0e-6));
+        REQUIRE(system->eHydroLoc() == Approx(e_loc).epsilon(1.0e-6));
+
+        // body mass from treecode products, without dense (7N x 7N) matrices
+        REQUIRE(potHydro->mTotal().size() == 0);
+        REQUIRE(potHydro->mTotalBodyCoords().isApprox(M_body, 1.0e-6));
+        REQUIRE(potHydro->mTotalLinearBlock(0, 1).isApprox(M_01, 1.0e-10));
+
+        system->setMatrixFreeHydro(false);
+        system->setTreecodeTheta(0.0);
+    }
+}
+
+TEST_CASE("Test mirror-aware image system hydrodynamics", "[PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-PotentialHydrodynamics-mirror";
+
+    // simulation classes
+    std::shared_ptr<SystemData>             system;
+    std::shared_ptr<PotentialHydrodynamics> potHydro;
+    std::shared_ptr<RungeKutta4>            rk4;
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(2);
+    Eigen::ThreadPoolDevice device(&thread_pool, 2);
+
+    // Construct and initialize classes (integrator sets image kinematics from real kinematics)
+    REQUIRE_NOTHROW(system = std::make_shared<SystemData>(inputDataFile, outputDir));
+    REQUIRE_NOTHROW(system->initializeData());
+    REQUIRE(system->imageSystem());
+
+    system->setMatrixFreeHydro(true);
+    REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+    REQUIRE_NOTHROW(rk4 = std::make_shared<RungeKutta4>(system, potHydro));
+
+    REQUIRE_NOTHROW(system->update(device));
+    REQUIRE_NOTHROW(potHydro->update(device));
+
+    // real 1/2 of full image system
+    const int num_real_7N{7 * system->numParticles() / 2};
+    const int num_real_7M{7 * system->numBodies() / 2};
+
+    const Eigen::VectorXd f_hydro            = potHydro->fHydro().head(num_real_7M);
+    const Eigen::VectorXd f_hydro_no_inertia = potHydro->fHydroNoInertia().head(num_real_7M);
+    const Eigen::MatrixXd m_total            = potHydro->mTotal().topLeftCorner(num_real_7N, num_real_7N);
+    const Eigen::MatrixXd m_total_body       = potHydro->mTotalBodyCoords().topLeftCorner(num_real_7M, num_real_7M);
+    const double          e_loc{system->eHydroLoc()};
+    const double          e_loc_int{system->eHydroLocInt()};
+    const double          e_int{system->eHydroInt()};
+    const double          e_simple{system->eHydroSimple()};
+
+    rk4.reset();
+    potHydro.reset();
+
+    // mirror-aware hydrodynamics only store the real particles
+    system->setMatrixFreeHydro(false);
+    system->setMirrorHydro(true);
+    REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+    REQUIRE_NOTHROW(potHydro->update(device));
+
+    REQUIRE(potHydro->fHydro().size() == num_real_7M);
+    REQUIRE(potHydro->mTotal().rows() == num_real_7N);
+
+    REQUIRE(potHydro->fHydro().isApprox(f_hydro, 1.0e-10));
+    REQUIRE(potHydro->fHydroNoInertia().isApprox(f_hydro_no_inertia, 1.0e-10));
+    REQUIRE(potHydro->mTotal().isApprox(m_total, 1.0e-12));
+    REQUIRE(potHydro->mTotalBodyCoords().isApprox(m_total_body, 1.0e-12));
+
+    REQUIRE(system->eHydroLoc() == Approx(e_loc).epsilon(1.0e-10));
+    REQUIRE(system->eHydroLocInt() == Approx(e_loc_int).epsilon(1.0e-10));
+    REQUIRE(system->eHydroInt() == Approx(e_int).epsilon(1.0e-10));
+    REQUIRE(system->eHydroSimple() == Approx(e_simple).epsilon(1.0e-10));
+
+    system->setMirrorHydro(false);
+}
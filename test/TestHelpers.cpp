@@ -0,0 +1,263 @@
+//
+// Created by Alec Glisman on 11/04/21
+//
+
+/* Include all internal project dependencies */
+#include <helper_eigenExecutionPolicy.hpp>
+#include <helper_eigenParallelFor.hpp>
+
+/* Include all external project dependencies */
+#define CATCH_CONFIG_CONSOLE_WIDTH 300
+#include <catch2/catch.hpp> // unit testing framework
+// STL
+#include <limits> // std::numeric_limits
+#include <vector> // std::vector
+
+TEST_CASE("Test parallelForChunks helper", "[helpers]")
+{
+    const int num_threads{4};
+    const int num_items{10007};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(num_threads);
+    Eigen::ThreadPoolDevice device(&thread_pool, num_threads);
+
+    SECTION("Chunk count")
+    {
+        REQUIRE(numParallelChunks(device, num_items, 64) == num_threads);
+        REQUIRE(numParallelChunks(device, 100, 64) == 1);
+        REQUIRE(numParallelChunks(device, 0, 64) == 1);
+    }
+
+    SECTION("Every iteration evaluated once")
+    {
+        const int num_chunks{numParallelChunks(device, num_items, 64)};
+
+        std::vector<int> visits(num_items, 0);
+        std::vector<int> chunk_sums(num_chunks, 0);
+
+        parallelForChunks(device, num_chunks, num_items, [&](const int chunk_id, const int begin, const int end) {
+            for (int i = begin; i < end; i++)
+            {
+                visits[i] += 1;
+                chunk_sums[chunk_id] += 1;
+            }
+        });
+
+        int num_failed{0};
+        for (int i = 0; i < num_items; i++)
+        {
+            num_failed += (visits[i] != 1);
+        }
+        REQUIRE(num_failed == 0);
+
+        int total{0};
+        for (int chunk_id = 0; chunk_id < num_chunks; chunk_id++)
+        {
+            total += chunk_sums[chunk_id];
+        }
+        REQUIRE(total == num_items);
+    }
+}
+
+TEST_CASE("Test parallelInvoke helper", "[helpers]")
+{
+    const int num_threads{4};
+    const int num_items{10007};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(num_threads);
+    Eigen::ThreadPoolDevice device(&thread_pool, num_threads);
+
+    // NOTE: each task writes to its own slot, so tasks never conflict
+    std::vector<int> calls(3, 0);
+    std::vector<int> thread_ids(3, -2);
+
+    const auto task = [&](const int task_id) {
+        return [&, task_id]() {
+            calls[task_id] += 1;
+            thread_ids[task_id] = device.currentThreadId();
+        };
+    };
+
+    SECTION("Every task evaluated once")
+    {
+        parallelInvoke(device, task(0), task(1), task(2));
+
+        REQUIRE(calls == std::vector<int>{1, 1, 1});
+
+        // first task on calling thread, others on thread-pool
+        REQUIRE(thread_ids[0] == -1);
+        REQUIRE(thread_ids[1] >= 0);
+        REQUIRE(thread_ids[2] >= 0);
+    }
+
+    SECTION("Serial evaluation from thread-pool worker")
+    {
+        int            worker_id{-2};
+        Eigen::Barrier barrier(1);
+
+        device.enqueueNoNotification([&]() {
+            worker_id = device.currentThreadId();
+            parallelInvoke(device, task(0), task(1), task(2));
+            barrier.Notify();
+        });
+        barrier.Wait();
+
+        REQUIRE(calls == std::vector<int>{1, 1, 1});
+
+        // all tasks on worker thread
+        REQUIRE(worker_id >= 0);
+        REQUIRE(thread_ids == std::vector<int>{worker_id, worker_id, worker_id});
+    }
+
+    SECTION("Serial evaluation if thread-pool does not have more threads than enqueued tasks")
+    {
+        Eigen::ThreadPool       small_thread_pool = Eigen::ThreadPool(2);
+        Eigen::ThreadPoolDevice small_device(&small_thread_pool, 2);
+
+        std::vector<int> order;
+        order.reserve(3);
+
+        parallelInvoke(
+            small_device, [&]() { order.push_back(small_device.currentThreadId()); },
+            [&]() { order.push_back(small_device.currentThreadId()); },
+            [&]() { order.push_back(small_device.currentThreadId()); });
+
+        // all tasks on calling thread
+        REQUIRE(order == std::vector<int>{-1, -1, -1});
+    }
+
+    SECTION("Parallel loop nested in first task")
+    {
+        std::vector<int> visits(num_items, 0);
+        int              num_chunks{-1};
+
+        parallelInvoke(
+            device,
+            [&]() {
+                num_chunks = numParallelChunks(device, num_items, 64);
+
+                parallelForChunks(device, num_chunks, num_items,
+                                  [&](const int chunk_id, const int begin, const int end) {
+                                      for (int i = begin; i < end; i++)
+                                      {
+                                          visits[i] += 1;
+                                      }
+                                  });
+            },
+            task(1), task(2));
+
+        // first task runs on calling thread, so its loop is still split across the thread-pool
+        REQUIRE(num_chunks == num_threads);
+
+        int num_failed{0};
+        for (int i = 0; i < num_items; i++)
+        {
+            num_failed += (visits[i] != 1);
+        }
+        REQUIRE(num_failed == 0);
+        REQUIRE(calls == std::vector<int>{0, 1, 1});
+    }
+}
+
+TEST_CASE("Test execution policy helper", "[helpers]")
+{
+    const int num_threads{4};
+    const int n{64};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(num_threads);
+    Eigen::ThreadPoolDevice device(&thread_pool, num_threads);
+
+    // NOTE: threshold is shared by all devices, so it is restored at the end of the test
+    const long min_work_init{minParallelTensorWork().load()};
+    const long min_work_inline{std::numeric_limits<long>::max()};
+
+    const Eigen::array<Eigen::IndexPair<int>, 1> contract_il_lj = {Eigen::IndexPair<int>(1, 0)}; // = A B
+
+    Eigen::Tensor<double, 2> a(n, n);
+    Eigen::Tensor<double, 2> b(n, n);
+    a.setRandom();
+    b.setRandom();
+
+    // compares two (n x n) tensors element-wise
+    const auto max_difference = [&](const Eigen::Tensor<double, 2>& x, const Eigen::Tensor<double, 2>& y) {
+        const Eigen::Map<const Eigen::MatrixXd> x_mat(x.data(), n, n);
+        const Eigen::Map<const Eigen::MatrixXd> y_mat(y.data(), n, n);
+        return (x_mat - y_mat).cwiseAbs().maxCoeff();
+    };
+
+    SECTION("Inline and thread-pool evaluation agree")
+    {
+        const long work{static_cast<long>(n) * n * n};
+
+        Eigen::Tensor<double, 2> c_inline(n, n);
+        Eigen::Tensor<double, 2> c_pool(n, n);
+
+        // contraction
+        minParallelTensorWork().store(min_work_inline);
+        REQUIRE_FALSE(useThreadPool(device, work));
+        evaluateTensor(device, work, c_inline, a.contract(b, contract_il_lj));
+
+        minParallelTensorWork().store(0);
+        REQUIRE(useThreadPool(device, work));
+        evaluateTensor(device, work, c_pool, a.contract(b, contract_il_lj));
+
+        REQUIRE(max_difference(c_inline, c_pool) <= 1.0e-12);
+
+        // slice as left hand side
+        const Eigen::array<Eigen::Index, 2> offsets = {n / 4, 0};
+        const Eigen::array<Eigen::Index, 2> extents = {n / 2, n};
+
+        const long slice_work{static_cast<long>(n / 2) * n};
+        const auto slice_sum = a.slice(offsets, extents) + b.slice(offsets, extents);
+
+        c_inline.setZero();
+        c_pool.setZero();
+
+        minParallelTensorWork().store(min_work_inline);
+        evaluateTensor(device, slice_work, c_inline.slice(offsets, extents), slice_sum);
+
+        minParallelTensorWork().store(0);
+        evaluateTensor(device, slice_work, c_pool.slice(offsets, extents), slice_sum);
+
+        REQUIRE(max_difference(c_inline, c_pool) == 0.0);
+    }
+
+    SECTION("Inline evaluation on thread-pool workers and single thread devices")
+    {
+        minParallelTensorWork().store(0);
+
+        bool           use_pool_worker{true};
+        Eigen::Barrier barrier(1);
+
+        device.enqueueNoNotification([&]() {
+            use_pool_worker = useThreadPool(device, min_work_inline);
+            barrier.Notify();
+        });
+        barrier.Wait();
+
+        REQUIRE(useThreadPool(device, min_work_inline));
+        REQUIRE_FALSE(use_pool_worker);
+
+        Eigen::ThreadPool       single_thread_pool = Eigen::ThreadPool(1);
+        Eigen::ThreadPoolDevice single_device(&single_thread_pool, 1);
+        REQUIRE_FALSE(useThreadPool(single_device, min_work_inline));
+    }
+
+    SECTION("Calibration")
+    {
+        const long min_work{calibrateExecutionPolicy(device)};
+
+        REQUIRE(min_work == minParallelTensorWork().load());
+        REQUIRE(min_work > 0);
+
+        // smallest contraction faster on thread-pool, or always inline
+        bool valid_size{min_work == min_work_inline};
+        for (const long size : {8, 16, 24, 32, 48, 64, 96})
+        {
+            valid_size = valid_size || (min_work == size * size * size);
+        }
+        REQUIRE(valid_size);
+    }
+
+    minParallelTensorWork().store(min_work_init);
+}
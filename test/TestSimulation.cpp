@@ -4,6 +4,10 @@
 
 /* Include all internal project dependencies */
 #include <Engine.hpp>
+#include <Parareal.hpp>
+#include <PeriodicOrbit.hpp>
+#include <PotentialHydrodynamics.hpp>
+#include <RungeKutta4.hpp>
 #include <SystemData.hpp>
 
 /* Include all external project dependencies */
@@ -15,9 +19,12 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
 // STL
-#include <fstream> // std::ifstream
-#include <memory>  // for std::unique_ptr and std::shared_ptr
-#include <string>  // std::string
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+#include <fstream>   // std::ifstream
+#include <memory>    // for std::unique_ptr and std::shared_ptr
+#include <string>    // std::string
+#include <vector>    // std::vector
 
 TEST_CASE("Open GSD file", "[gsd]")
 {
@@ -86,6 +93,326 @@ TEST_CASE("Collinear swimmer isolated: run engine",
     REQUIRE_NOTHROW(eng->run());
 }
 
+TEST_CASE("Collinear swimmer isolated: stroboscopic multi-rate engine",
+          "[Collinear-Isolated][Engine][ProgressBar][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-Engine-multirate";
+
+    const double dt{0.1}; // 10 time steps per gait period
+    const double tf{8.0}; // gait periods
+
+    long num_macro_steps{0};
+
+    // runs engine to `tf`, returns final body positions and velocities
+    const auto run = [&](const int micro_periods, const int macro_periods) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setDt(dt);
+        system->setTf(tf);
+        system->setMultirateMicroPeriods(micro_periods);
+        system->setMultirateMacroPeriods(macro_periods);
+
+        auto eng = std::make_shared<Engine>(system);
+        eng->run();
+
+        num_macro_steps = eng->numMacroSteps();
+
+        REQUIRE(system->t() == Approx(tf));
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_resolved;
+    Eigen::VectorXd state_multirate;
+
+    REQUIRE_NOTHROW(state_resolved = run(1, 0));
+    REQUIRE(num_macro_steps == 0);
+
+    // 1 resolved period followed by a macro-step over 2 periods: periods 2-3, 5-6 and 8 are skipped
+    REQUIRE_NOTHROW(state_multirate = run(1, 2));
+    REQUIRE(num_macro_steps == 3);
+
+    // NOTE: isolated swimmer drifts at a constant mean velocity, so the stroboscopic map is nearly linear
+    REQUIRE(state_multirate.isApprox(state_resolved, 1.0e-3));
+}
+
+TEST_CASE("Collinear swimmer isolated: steady-state detection",
+          "[Collinear-Isolated][Engine][ProgressBar][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-Engine-steady-state";
+
+    const double dt{0.1}; // 10 time steps per gait period
+    const double tf{8.0}; // gait periods
+    const int    periods{2};
+    const double u0_scale{1.0e-2}; // small gait amplitude: drifts at a constant mean velocity from the first period
+
+    // reference mean of the hydrodynamic energy over the time steps of the last period
+    double e_hydro_int_mean{0.0};
+    {
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setDt(dt);
+        system->setSysSpecU0(u0_scale * system->sysSpecU0());
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        Eigen::ThreadPool       thread_pool(2);
+        Eigen::ThreadPoolDevice device(&thread_pool, 2);
+
+        const int steps_per_period{10};
+        for (int step = 1; step <= (1 + periods) * steps_per_period; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+
+            if (step > periods * steps_per_period)
+            {
+                e_hydro_int_mean += system->eHydroInt() / steps_per_period;
+            }
+        }
+    }
+
+    spdlog::drop_all();
+
+    auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+    system->initializeData();
+    system->setDt(dt);
+    system->setTf(tf);
+    system->setSysSpecU0(u0_scale * system->sysSpecU0());
+    system->setSteadyStateTol(1.0e-3);
+    system->setSteadyStateAtol(1.0e-12); // transverse velocities vanish up to round-off
+    system->setSteadyStatePeriods(periods);
+
+    auto eng = std::make_shared<Engine>(system);
+    REQUIRE_NOTHROW(eng->run());
+
+    // stops after the first period is compared to `periods` more
+    REQUIRE(system->steadyStateTime() == Approx(system->t()));
+    REQUIRE(system->t() == Approx(1.0 + periods));
+    REQUIRE(system->t() < tf);
+
+    // 1 free body: mean linear velocity and 4 hydrodynamic energies averaged over the last period
+    REQUIRE(system->steadyStateValues().size() == 7);
+    REQUIRE(system->steadyStateValues()(3) == Approx(e_hydro_int_mean));
+}
+
+TEST_CASE("Collinear swimmer isolated: steady-state detection of a slowly changing drift",
+          "[Collinear-Isolated][Engine][ProgressBar][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-Engine-steady-state-drift";
+
+    const double dt{0.1}; // 10 time steps per gait period
+    const double tf{5.0}; // gait periods
+    const int    periods{2};
+    const double tol{1.0e-3};
+
+    // small mean drift velocity that changes by more than `tol` relative to itself, but not relative to 1 + |x|
+    {
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setDt(dt);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        Eigen::ThreadPool       thread_pool(2);
+        Eigen::ThreadPoolDevice device(&thread_pool, 2);
+
+        const int       steps_per_period{10};
+        Eigen::VectorXd z_period = Eigen::VectorXd::Zero(3);
+        z_period(0)              = system->positionsBodies()(2);
+        for (int step = 1; step <= 2 * steps_per_period; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+
+            if (step % steps_per_period == 0)
+            {
+                z_period(step / steps_per_period) = system->positionsBodies()(2);
+            }
+        }
+
+        const double v_1{z_period(1) - z_period(0)};
+        const double v_2{z_period(2) - z_period(1)};
+        INFO("Mean drift velocities " << v_1 << " and " << v_2);
+        REQUIRE(std::abs(v_2) < 0.1);
+        REQUIRE(std::abs(v_2 - v_1) / (1.0 + std::abs(v_2)) < tol);
+        REQUIRE(std::abs(v_2 - v_1) > tol * std::abs(v_2));
+    }
+
+    spdlog::drop_all();
+
+    auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+    system->initializeData();
+    system->setDt(dt);
+    system->setTf(tf);
+    system->setSteadyStateTol(tol);
+    system->setSteadyStateAtol(1.0e-12); // transverse velocities vanish up to round-off
+    system->setSteadyStatePeriods(periods);
+
+    auto eng = std::make_shared<Engine>(system);
+    REQUIRE_NOTHROW(eng->run());
+
+    // drift is still changing: runs to the final time
+    REQUIRE(system->steadyStateTime() < 0.0);
+    REQUIRE(system->t() == Approx(tf));
+}
+
+TEST_CASE("Collinear swimmer isolated: parareal integration",
+          "[Collinear-Isolated][Engine][SystemData][RungeKutta4][PotentialHydrodynamics][Parareal]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-Engine-parareal";
+
+    const double dt{0.1}; // 10 time steps per gait period
+    const double tf{4.0}; // gait periods
+    const int    slices{4};
+
+    auto run = [&](const int parareal_slices) {
+        // close all previous loggers
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setDt(dt);
+        system->setTf(tf);
+        system->setPararealSlices(parareal_slices);
+        system->setPararealCoarseRatio(5);
+        system->setPararealTol(1.0e-10);
+
+        auto eng = std::make_shared<Engine>(system);
+        eng->run();
+        eng.reset(); // release loggers
+
+        REQUIRE(system->t() == Approx(tf));
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_serial;
+    Eigen::VectorXd state_parareal;
+
+    REQUIRE_NOTHROW(state_serial = run(0));
+    REQUIRE_NOTHROW(state_parareal = run(slices));
+
+    // converged parareal iterations reproduce serial integration
+    REQUIRE(state_parareal.isApprox(state_serial, 1.0e-8));
+
+    // output frames at the same time steps and states as a serial `Engine` run, also inside slices
+    {
+        const int write_step{3}; // does not divide the 10 time steps per slice
+
+        // NOTE: spin about the swimmer axis, so quaternion norms drift between the normalizations at output steps
+        const Eigen::Vector3d omega(0.0, 0.0, 0.50);
+        const auto            spin = [&](std::shared_ptr<SystemData> system) {
+            Eigen::VectorXd vel = system->velocitiesBodies();
+
+            for (int body_id = 0; body_id < system->numBodies(); body_id++)
+            {
+                const int body_id_7{7 * body_id};
+
+                const Eigen::Quaterniond quat(system->positionsBodies()(body_id_7 + 3),
+                                              system->positionsBodies()(body_id_7 + 4),
+                                              system->positionsBodies()(body_id_7 + 5),
+                                              system->positionsBodies()(body_id_7 + 6));
+                const Eigen::Quaterniond d_quat = quat * Eigen::Quaterniond(0.0, omega(0), omega(1), omega(2));
+
+                vel(body_id_7 + 3)            = 0.50 * d_quat.w();
+                vel.segment<3>(body_id_7 + 4) = 0.50 * d_quat.vec();
+            }
+            system->setVelocitiesBodies(vel);
+        };
+
+        const std::vector<int> frame_steps_expected = {3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 40};
+
+        // serial runs to each output time step, writing every `write_step` time steps
+        std::vector<Eigen::VectorXd> frames_serial;
+        for (const int step : frame_steps_expected)
+        {
+            spdlog::drop_all();
+
+            auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+            system->initializeData();
+            system->setDt(dt);
+            system->setTf((step - 0.50) * dt); // NOTE: rounds up to `step` time steps
+            system->setNumStepsOutput((step + write_step - 1) / write_step);
+
+            // NOTE: constructor of the integrator resets the body velocities
+            auto eng = std::make_shared<Engine>(system);
+            spin(system);
+            eng->run();
+            eng.reset(); // release loggers
+
+            REQUIRE(system->timestep() == step);
+
+            Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+            state << system->positionsBodies(), system->velocitiesBodies();
+            frames_serial.push_back(state);
+        }
+
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setDt(dt);
+        system->setTf(tf);
+        system->setPararealSlices(slices);
+        system->setPararealCoarseRatio(5);
+        system->setPararealTol(1.0e-14);
+
+        // NOTE: integrator sets initial body velocities before parareal copies the system, as in `Engine`
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+        auto parareal = std::make_shared<Parareal>(system);
+        spin(system);
+
+        Eigen::ThreadPool       thread_pool(2);
+        Eigen::ThreadPoolDevice device(&thread_pool, 2);
+
+        parareal->run(device, write_step);
+
+        REQUIRE(parareal->frameSteps() == frame_steps_expected);
+        REQUIRE(parareal->frameStates().col(13).isApprox(parareal->sliceStates().col(slices)));
+
+        for (std::size_t frame = 0; frame < frame_steps_expected.size(); frame++)
+        {
+            INFO("Frame at time step " << frame_steps_expected[frame]);
+            INFO("Difference from serial run "
+                 << (parareal->frameStates().col(frame) - frames_serial[frame]).lpNorm<Eigen::Infinity>());
+            REQUIRE(parareal->frameStates().col(frame).isApprox(frames_serial[frame], 1.0e-12));
+        }
+    }
+
+    // time steps must split evenly into slices
+    spdlog::drop_all();
+    auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+    system->initializeData();
+    system->setDt(dt);
+    system->setTf(tf);
+    system->setPararealSlices(3);
+    REQUIRE_THROWS_AS(std::make_shared<Parareal>(system), std::invalid_argument);
+}
+
 TEST_CASE("Collinear swimmer wall: initialize system",
           "[Collinear-Wall][Engine][SystemData][RungeKutta4][PotentialHydrodynamics][gsd][GSDUtil]")
 {
@@ -133,3 +460,721 @@ TEST_CASE("Collinear swimmer wall: run engine",
     // Verify simulation can run without error
     REQUIRE_NOTHROW(eng->run());
 }
+
+TEST_CASE("Collinear swimmer isolated: first-same-as-last reuse of acceleration",
+          "[Collinear-Isolated][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-RungeKutta4-fsal";
+
+    // simulation classes
+    std::shared_ptr<SystemData>             system;
+    std::shared_ptr<PotentialHydrodynamics> potHydro;
+    std::shared_ptr<RungeKutta4>            rk4;
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    // Construct and initialize simulation classes
+    REQUIRE_NOTHROW(system = std::make_shared<SystemData>(inputDataFile, outputDir));
+    REQUIRE_NOTHROW(system->initializeData());
+    REQUIRE_NOTHROW(potHydro = std::make_shared<PotentialHydrodynamics>(system));
+    REQUIRE_NOTHROW(rk4 = std::make_shared<RungeKutta4>(system, potHydro));
+
+    // advance time as in `Engine::run()`
+    const auto step = [&]() {
+        rk4->integrate(device);
+        system->setT(system->t() + system->dt());
+    };
+
+    // first step has no cached acceleration
+    long num_updates{rk4->numAccelerationUpdates()};
+    REQUIRE_NOTHROW(step());
+    REQUIRE(rk4->numAccelerationUpdates() - num_updates == 5);
+
+    // unmodified state: step 1 reuses end-of-step acceleration
+    const double          t_start{system->t()};
+    const Eigen::VectorXd pos_start = system->positionsBodies();
+    const Eigen::VectorXd vel_start = system->velocitiesBodies();
+
+    num_updates = rk4->numAccelerationUpdates();
+    REQUIRE_NOTHROW(step());
+    REQUIRE(rk4->numAccelerationUpdates() - num_updates == 4);
+
+    const Eigen::VectorXd pos_reuse = system->positionsBodies();
+    const Eigen::VectorXd vel_reuse = system->velocitiesBodies();
+
+    // same step without cached acceleration (cache holds end of previous step) gives the same result
+    system->setT(t_start);
+    system->setPositionsBodies(pos_start);
+    system->setVelocitiesBodies(vel_start);
+
+    num_updates = rk4->numAccelerationUpdates();
+    REQUIRE_NOTHROW(step());
+    REQUIRE(rk4->numAccelerationUpdates() - num_updates == 5);
+
+    REQUIRE(system->positionsBodies().isApprox(pos_reuse, 1.0e-12));
+    REQUIRE(system->velocitiesBodies().isApprox(vel_reuse, 1.0e-12));
+
+    // modified body state (quaternion normalization on output frames) invalidates cached acceleration
+    Eigen::VectorXd pos_drift = system->positionsBodies();
+    pos_drift(4) += 1.0e-6; // drift of quaternion off unit sphere
+    system->setPositionsBodies(pos_drift);
+    system->normalizeQuaternions();
+
+    num_updates = rk4->numAccelerationUpdates();
+    REQUIRE_NOTHROW(step());
+    REQUIRE(rk4->numAccelerationUpdates() - num_updates == 5);
+}
+
+TEST_CASE("Collinear swimmer isolated: adaptive Dormand-Prince time stepping",
+          "[Collinear-Isolated][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-RungeKutta4-adaptive";
+
+    const int num_steps{20};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    /* integrates to the same final time in `num_steps / output_stride` steps of size `output_stride * dt` as in
+     * `Engine::run()`, returns final body positions and velocities */
+    const auto run = [&](const double atol, const double rtol, const int output_stride, long& num_updates) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setAdaptiveAtol(atol);
+        system->setAdaptiveRtol(rtol);
+        system->setDt(output_stride * system->dt());
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        const long num_updates_init{rk4->numAccelerationUpdates()};
+        for (int step = 0; step < num_steps / output_stride; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+        }
+        num_updates = rk4->numAccelerationUpdates() - num_updates_init;
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    long num_updates_fixed{-1};
+    long num_updates_adaptive{-1};
+
+    Eigen::VectorXd state_fixed;
+    Eigen::VectorXd state_adaptive;
+
+    REQUIRE_NOTHROW(state_fixed = run(0.0, 0.0, 1, num_updates_fixed));
+
+    SECTION("Output every fixed time step")
+    {
+        REQUIRE_NOTHROW(state_adaptive = run(1.0e-10, 1.0e-10, 1, num_updates_adaptive));
+
+        INFO("Acceleration updates (fixed, adaptive): " << num_updates_fixed << ", " << num_updates_adaptive);
+        REQUIRE(state_adaptive.isApprox(state_fixed, 1.0e-6));
+    }
+
+    SECTION("Output every 10 fixed time steps")
+    {
+        REQUIRE_NOTHROW(state_adaptive = run(1.0e-8, 1.0e-8, 10, num_updates_adaptive));
+
+        INFO("Acceleration updates (fixed, adaptive): " << num_updates_fixed << ", " << num_updates_adaptive);
+        REQUIRE(state_adaptive.isApprox(state_fixed, 1.0e-6));
+        REQUIRE(num_updates_adaptive < num_updates_fixed);
+    }
+}
+
+TEST_CASE("Collinear swimmer isolated: adaptive time stepping with engine output frames",
+          "[Collinear-Isolated][Engine][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_isolated/initial_frame_dt1e-2.gsd";
+    std::string outputDir     = "output-collinear-isolated-Engine-adaptive";
+
+    const double tf{0.4};
+    const int    num_steps_output{4}; // output frame every 10 time steps
+
+    auto make_system = [&]() {
+        // close all previous loggers
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setAdaptiveAtol(1.0e-8);
+        system->setAdaptiveRtol(1.0e-8);
+        system->setTf(tf);
+        system->setNumStepsOutput(num_steps_output);
+        return system;
+    };
+
+    // engine run writes output frames in between time steps
+    auto system_engine = make_system();
+    auto eng           = std::make_shared<Engine>(system_engine);
+    REQUIRE_NOTHROW(eng->run());
+    eng.reset(); // release loggers
+
+    REQUIRE(system_engine->t() == Approx(tf));
+
+    // same time steps without output frames
+    auto system   = make_system();
+    auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+    auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    const int tot_step = (int)ceil((system->tf() - system->t()) / system->dt());
+    for (int step = 0; step < tot_step; step++)
+    {
+        rk4->integrate(device);
+        system->setT(system->t() + system->dt());
+    }
+
+    // output frames do not restart internal steps, so both runs agree up to round-off
+    REQUIRE(system_engine->positionsBodies().isApprox(system->positionsBodies(), 1.0e-12));
+    REQUIRE(system_engine->velocitiesBodies().isApprox(system->velocitiesBodies(), 1.0e-12));
+
+    // output state has unit quaternions
+    for (int body_id = 0; body_id < system_engine->numBodies(); body_id++)
+    {
+        REQUIRE(system_engine->positionsBodies().segment<4>(7 * body_id + 3).norm() == Approx(1.0).epsilon(1.0e-14));
+    }
+}
+
+TEST_CASE("Collinear swimmer wall: Cholesky Udwadia-Kalaba solver",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-cholesky";
+
+    const int num_steps{10};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    // integrates `num_steps` steps as in `Engine::run()`, returns final body positions, velocities and accelerations
+    const auto run = [&](const int udwadia_solver) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setUdwadiaSolver(udwadia_solver);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        for (int step = 0; step < num_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+        }
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(3 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies(), system->accelerationsBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_eigen;
+    Eigen::VectorXd state_cholesky;
+
+    REQUIRE_NOTHROW(state_eigen = run(0));
+    REQUIRE_NOTHROW(state_cholesky = run(1));
+
+    REQUIRE(state_cholesky.isApprox(state_eigen, 1.0e-10));
+}
+
+TEST_CASE("Collinear swimmer wall: projected conjugate gradient Udwadia-Kalaba solver",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-iterative";
+
+    const int num_steps{10};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    long num_cg_iterations{0};
+
+    // integrates `num_steps` steps as in `Engine::run()`, returns final body positions, velocities and accelerations
+    const auto run = [&](const int udwadia_solver) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setUdwadiaSolver(udwadia_solver);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        for (int step = 0; step < num_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+        }
+
+        num_cg_iterations = rk4->numCGIterations();
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(3 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies(), system->accelerationsBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_eigen;
+    Eigen::VectorXd state_iterative;
+
+    REQUIRE_NOTHROW(state_eigen = run(0));
+    REQUIRE(num_cg_iterations == 0);
+
+    REQUIRE_NOTHROW(state_iterative = run(2));
+    REQUIRE(num_cg_iterations > 0);
+
+    REQUIRE(state_iterative.isApprox(state_eigen, 1.0e-10));
+}
+
+TEST_CASE("Collinear swimmer wall: reuse of effective mass factorization",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-refactor";
+
+    const int num_steps{10};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    long num_factorizations{0};
+    long num_updates{0};
+
+    // integrates `num_steps` steps with the Cholesky solver, returns final body positions, velocities and accelerations
+    const auto run = [&](const double refactor_tol) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setUdwadiaSolver(1);
+        system->setUdwadiaRefactorTol(refactor_tol);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        for (int step = 0; step < num_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+        }
+
+        num_factorizations = rk4->numMassFactorizations();
+        num_updates        = rk4->numAccelerationUpdates();
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(3 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies(), system->accelerationsBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_direct;
+    Eigen::VectorXd state_reuse;
+
+    REQUIRE_NOTHROW(state_direct = run(0.0));
+    REQUIRE(num_factorizations == num_updates);
+
+    REQUIRE_NOTHROW(state_reuse = run(1.0e-12));
+    REQUIRE(num_factorizations < num_updates);
+
+    REQUIRE(state_reuse.isApprox(state_direct, 1.0e-10));
+}
+
+TEST_CASE("Collinear swimmer wall: Lie-group integrator scheme",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-lie-group";
+
+    const int num_steps{10};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    double max_quat_norm_error{0.0};
+
+    // integrates `num_steps` steps as in `Engine::run()`, returns final body positions and velocities
+    const auto run = [&](const int integrator_scheme) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setIntegratorScheme(integrator_scheme);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        max_quat_norm_error = 0.0;
+
+        for (int step = 0; step < num_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+
+            for (int body_id = 0; body_id < system->numBodies(); body_id++)
+            {
+                const double quat_norm{system->positionsBodies().segment<4>(7 * body_id + 3).norm()};
+                max_quat_norm_error = std::max(max_quat_norm_error, std::abs(quat_norm - 1.0));
+            }
+        }
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_classical;
+    Eigen::VectorXd state_lie_group;
+
+    REQUIRE_NOTHROW(state_classical = run(0));
+    REQUIRE_NOTHROW(state_lie_group = run(1));
+
+    // quaternions stay unit by construction
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+
+    // NOTE: bodies of the collinear swimmer do not rotate, so both schemes take the same steps
+    REQUIRE(state_lie_group.isApprox(state_classical, 1.0e-10));
+}
+
+TEST_CASE("Collinear swimmer wall: Lie-group integrator scheme with rotating bodies",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-lie-group-rotating";
+
+    const int num_steps{10};
+
+    // initial angular velocity of the free bodies about the wall normal (keeps the image system consistent)
+    const Eigen::Vector3d omega(0.0, 0.0, 0.50);
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    double max_quat_norm_error{0.0};
+
+    // integrates to the same final time with time step `dt / refine`, returns final body positions and velocities
+    const auto run = [&](const int integrator_scheme, const int refine) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setIntegratorScheme(integrator_scheme);
+        system->setDt(system->dt() / refine);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        // NOTE: constructor of the integrator resets the body velocities, dq/dt = q (0, omega) / 2
+        Eigen::VectorXd vel = system->velocitiesBodies();
+
+        for (int body_id = 0; body_id < system->numBodies(); body_id++)
+        {
+            const int body_id_7{7 * body_id};
+
+            const Eigen::Quaterniond quat(system->positionsBodies()(body_id_7 + 3),
+                                          system->positionsBodies()(body_id_7 + 4),
+                                          system->positionsBodies()(body_id_7 + 5),
+                                          system->positionsBodies()(body_id_7 + 6));
+            const Eigen::Quaterniond d_quat = quat * Eigen::Quaterniond(0.0, omega(0), omega(1), omega(2));
+
+            vel(body_id_7 + 3)            = 0.50 * d_quat.w();
+            vel.segment<3>(body_id_7 + 4) = 0.50 * d_quat.vec();
+        }
+        system->setVelocitiesBodies(vel);
+
+        max_quat_norm_error = 0.0;
+
+        for (int step = 0; step < refine * num_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+
+            for (int body_id = 0; body_id < system->numBodies(); body_id++)
+            {
+                const double quat_norm{system->positionsBodies().segment<4>(7 * body_id + 3).norm()};
+                max_quat_norm_error = std::max(max_quat_norm_error, std::abs(quat_norm - 1.0));
+            }
+        }
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_reference;
+    Eigen::VectorXd state_lie_group;
+    Eigen::VectorXd state_lie_group_refined;
+
+    REQUIRE_NOTHROW(state_reference = run(0, 8));
+
+    // NOTE: quaternions are never normalized, they stay unit by construction
+    REQUIRE_NOTHROW(state_lie_group = run(1, 1));
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+
+    REQUIRE_NOTHROW(state_lie_group_refined = run(1, 2));
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+
+    // bodies rotate: vector part of the quaternion of the free body is not small
+    REQUIRE(state_lie_group.segment<3>(4).norm() > 0.10);
+
+    // converges (at least second order) towards the classical Runge-Kutta solution at a fine time step
+    const double err{(state_lie_group - state_reference).norm() / state_reference.norm()};
+    const double err_refined{(state_lie_group_refined - state_reference).norm() / state_reference.norm()};
+    INFO("Relative error (dt, dt / 2): " << err << ", " << err_refined);
+
+    REQUIRE(err < 5.0e-3);
+    REQUIRE(err_refined < err / 3.0);
+}
+
+TEST_CASE("Collinear swimmer wall: RATTLE integrator scheme",
+          "[Collinear-Wall][SystemData][RungeKutta4][PotentialHydrodynamics]")
+{
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-RungeKutta4-rattle";
+
+    const int num_steps{10};
+
+    // thread-pool device
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    long   num_updates{0};
+    long   num_rattle_iterations{0};
+    double max_quat_norm_error{0.0};
+    double max_mass_quat_error{0.0};
+    double min_height{0.0};
+
+    // integrates `run_steps` steps of time step `dt * dt_scale`, returns final body positions and velocities
+    const auto run = [&](const int integrator_scheme, const double dt_scale, const int run_steps) {
+        spdlog::drop_all();
+
+        auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+        system->initializeData();
+        system->setIntegratorScheme(integrator_scheme);
+        system->setDt(system->dt() * dt_scale);
+
+        auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+        auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+        max_quat_norm_error = 0.0;
+        max_mass_quat_error = 0.0;
+        min_height          = system->positionsBodies()(2);
+
+        for (int step = 0; step < run_steps; step++)
+        {
+            rk4->integrate(device);
+            system->setT(system->t() + system->dt());
+
+            for (int body_id = 0; body_id < system->numBodies(); body_id++)
+            {
+                const double quat_norm{system->positionsBodies().segment<4>(7 * body_id + 3).norm()};
+                max_quat_norm_error = std::max(max_quat_norm_error, std::abs(quat_norm - 1.0));
+            }
+
+            min_height = std::min(min_height, system->positionsBodies()(2));
+
+            // RATTLE projects along the quaternions, which must be eigenvectors of the effective body mass matrix
+            const Eigen::Vector4d quat   = system->positionsBodies().segment<4>(3);
+            Eigen::VectorXd       M_quat = potHydro->mTotalBodyCoords().middleCols<4>(3) * quat;
+            M_quat.segment<4>(3) -= quat.dot(M_quat.segment<4>(3)) * quat;
+            max_mass_quat_error = std::max(max_mass_quat_error,
+                                           M_quat.norm() / potHydro->mTotalBodyCoords().middleCols<4>(3).norm());
+        }
+
+        num_updates           = rk4->numAccelerationUpdates();
+        num_rattle_iterations = rk4->numRattleIterations();
+
+        Eigen::VectorXd state = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+        state << system->positionsBodies(), system->velocitiesBodies();
+        return state;
+    };
+
+    Eigen::VectorXd state_classical;
+    Eigen::VectorXd state_rattle;
+    Eigen::VectorXd state_rattle_refined;
+
+    REQUIRE_NOTHROW(state_classical = run(0, 1.0, num_steps));
+    const long num_updates_classical{num_updates};
+
+    REQUIRE_NOTHROW(state_rattle = run(2, 1.0, num_steps));
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+    REQUIRE(max_mass_quat_error < 1.0e-12);
+
+    // one acceleration update per fixed-point iteration of the final kick after the first, at most two per step
+    INFO("Acceleration updates (classical, RATTLE): " << num_updates_classical << ", " << num_updates);
+    REQUIRE(num_updates == num_rattle_iterations + 1);
+    REQUIRE(num_rattle_iterations >= num_steps);
+    REQUIRE(num_rattle_iterations <= 2 * num_steps);
+    REQUIRE(num_updates < num_updates_classical);
+
+    REQUIRE_NOTHROW(state_rattle_refined = run(2, 0.5, 2 * num_steps));
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+
+    // second order convergence towards the (more accurate) classical Runge-Kutta solution
+    const double err{(state_rattle - state_classical).norm() / state_classical.norm()};
+    const double err_refined{(state_rattle_refined - state_classical).norm() / state_classical.norm()};
+
+    REQUIRE(err < 5.0e-2);
+    REQUIRE(err_refined < err / 3.0);
+
+    // NOTE: with four times the time step the classical scheme steps the body through the wall
+    const double coarse_dt_scale{4.0};
+    bool         classical_failed{false};
+
+    try
+    {
+        const Eigen::VectorXd state_classical_coarse = run(0, coarse_dt_scale, num_steps);
+        classical_failed = (!state_classical_coarse.allFinite()) || (min_height <= 0.0);
+    }
+    catch (const std::runtime_error&)
+    {
+        classical_failed = true;
+    }
+    REQUIRE(classical_failed);
+
+    Eigen::VectorXd state_rattle_coarse;
+    REQUIRE_NOTHROW(state_rattle_coarse = run(2, coarse_dt_scale, num_steps));
+    REQUIRE(state_rattle_coarse.allFinite());
+    REQUIRE(max_quat_norm_error < 1.0e-14);
+    REQUIRE(min_height > 0.0);
+    REQUIRE(state_rattle_coarse.tail(state_rattle_coarse.size() / 2).norm() <
+            10.0 * state_classical.tail(state_classical.size() / 2).norm());
+
+    // time-reversible: stepping back with -dt from the end of the run recovers the initial state
+    // NOTE: reversibility needs the fixed-point iterations of the final kick to converge
+    spdlog::drop_all();
+
+    auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+    system->initializeData();
+    system->setIntegratorScheme(2);
+    system->setRattleIterations(50);
+
+    auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+    auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+    Eigen::VectorXd state_init = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+    state_init << system->positionsBodies(), system->velocitiesBodies();
+
+    for (int step = 0; step < num_steps; step++)
+    {
+        rk4->integrate(device);
+        system->setT(system->t() + system->dt());
+    }
+
+    Eigen::VectorXd state_mid = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+    state_mid << system->positionsBodies(), system->velocitiesBodies();
+
+    // NOTE: time step is fixed at construction of the integrator, which also resets the initial body velocities
+    rk4.reset(); // release logger
+    system->setDt(-system->dt());
+    rk4 = std::make_shared<RungeKutta4>(system, potHydro);
+    system->setPositionsBodies(state_mid.head(7 * system->numBodies()));
+    system->setVelocitiesBodies(state_mid.tail(7 * system->numBodies()));
+
+    for (int step = 0; step < num_steps; step++)
+    {
+        rk4->integrate(device);
+        system->setT(system->t() + system->dt());
+    }
+
+    Eigen::VectorXd state_final = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+    state_final << system->positionsBodies(), system->velocitiesBodies();
+
+    INFO("Reversibility error: " << (state_final - state_init).norm() / state_init.norm());
+    REQUIRE(state_final.isApprox(state_init, 1.0e-10));
+}
+
+TEST_CASE("Collinear swimmer wall: periodic orbit by Newton-Krylov shooting",
+          "[Collinear-Wall][Engine][SystemData][RungeKutta4][PotentialHydrodynamics][PeriodicOrbit]")
+{
+    // close all previous loggers
+    spdlog::drop_all();
+
+    // I/O Parameters
+    std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
+    std::string outputDir     = "output-collinear-wall-Engine-periodic-orbit";
+
+    // NOTE: residual cannot fall much below the time integration error per period
+    const double tol{1.0e-4};
+
+    auto system = std::make_shared<SystemData>(inputDataFile, outputDir);
+    system->initializeData();
+    system->setPeriodicOrbitTol(tol);
+
+    auto eng = std::make_shared<Engine>(system);
+    REQUIRE_NOTHROW(eng->run());
+    eng.reset(); // release loggers
+
+    REQUIRE(system->t() == Approx(0.0));
+    REQUIRE(system->periodicOrbitResidual() <= tol);
+
+    // 1 free body: z-height and 3 linear velocities, repeated multipliers may not all be resolved
+    REQUIRE(system->floquetMultipliers().rows() >= 1);
+    REQUIRE(system->floquetMultipliers().rows() <= 4);
+
+    // integrating one more period from the periodic state returns to it
+    Eigen::VectorXd state_orbit = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+    state_orbit << system->positionsBodies(), system->velocitiesBodies();
+
+    Eigen::ThreadPool       thread_pool(1);
+    Eigen::ThreadPoolDevice device(&thread_pool, 1);
+
+    auto potHydro = std::make_shared<PotentialHydrodynamics>(system);
+    auto rk4      = std::make_shared<RungeKutta4>(system, potHydro);
+
+    // NOTE: `RungeKutta4` constructor sets the initial body velocities
+    const int m7{7 * system->numBodies()};
+    system->setPositionsBodies(state_orbit.head(m7));
+    system->setVelocitiesBodies(state_orbit.tail(m7));
+
+    const int steps_per_period{static_cast<int>(std::round(2.0 * M_PI / (system->sysSpecOmega() * system->tau()) /
+                                                           system->dt()))};
+    for (int step = 0; step < steps_per_period; step++)
+    {
+        rk4->integrate(device);
+        system->setT(system->t() + system->dt());
+    }
+
+    Eigen::VectorXd state_period = Eigen::VectorXd::Zero(2 * 7 * system->numBodies());
+    state_period << system->positionsBodies(), system->velocitiesBodies();
+
+    for (int i = 0; i < 3; i++)
+    {
+        const double displacement{state_period(i) - state_orbit(i)};
+        REQUIRE(displacement == Approx(system->periodicOrbitDisplacement()(i)).margin(tol));
+        REQUIRE(state_period(m7 + i) == Approx(state_orbit(m7 + i)).margin(tol));
+    }
+    REQUIRE(std::abs(state_period(2) - state_orbit(2)) <= tol);
+}
@@ -5,16 +5,23 @@
 
 /* Include all internal project dependencies */
 #include <TestSystemData.hpp>
+#include <UpdateGraph.hpp>
 
 /* Include all external project dependencies */
 #define CATCH_CONFIG_CONSOLE_WIDTH 300
 #include <catch2/catch.hpp> // unit testing framework
+// Logging
+#include <spdlog/spdlog.h>
 // STL
 #include <memory> // for std::unique_ptr and std::shared_ptr
 #include <string> // std::string
+#include <vector> // std::vector
 
 TEST_CASE("Test SystemData class", "[SystemData]")
 {
+    // close all previous loggers
+    spdlog::drop_all();
+
     // I/O Parameters
     std::string inputDataFile = "input/collinear_swimmer_wall/initial_frame_dt1e-1_Z-height6.gsd";
     std::string outputDir     = "output-SystemData-init";
@@ -40,7 +47,101 @@ TEST_CASE("Test SystemData class", "[SystemData]")
         REQUIRE(return_val == 0);
     }
 
+    SECTION("Test rigid body motion tensors")
+    {
+        REQUIRE_NOTHROW(system->initializeData());
+
+        REQUIRE_NOTHROW(return_val = testSystem->testRigidBodyMotionTensors());
+        REQUIRE(return_val == 0);
+    }
+
+    SECTION("Test incremental updates")
+    {
+        REQUIRE_NOTHROW(system->initializeData());
+
+        REQUIRE_NOTHROW(return_val = testSystem->testUpdateGraph());
+        REQUIRE(return_val == 0);
+    }
+
     // REQUIRE_NOTHROW(system->initializeData());
     // Verify data was correctly parsed from GSD to simulation
     // REQUIRE(system->gSDParsed());
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test UpdateGraph class", "[UpdateGraph]")
+{
+    // stage 0 reads positions, stage 1 time and stage 0, stage 2 velocities and stage 1, stage 3 velocities only
+    UpdateGraph graph({
+        {UpdateGraph::Positions, {}},
+        {UpdateGraph::Time, {0}},
+        {UpdateGraph::Velocities, {1}},
+        {UpdateGraph::Velocities, {}},
+    });
+    const int num_stages{4};
+
+    UpdateGraph::Versions versions{};
+
+    // returns which stages are outdated, then marks all stages current
+    const auto outdated_stages = [&]() {
+        std::vector<bool> outdated(num_stages);
+        for (int stage = 0; stage < num_stages; stage++)
+        {
+            outdated[stage] = graph.outdated(stage, versions);
+        }
+        for (int stage = 0; stage < num_stages; stage++)
+        {
+            graph.markCurrent(stage, versions);
+        }
+        return outdated;
+    };
+
+    SECTION("Version counters")
+    {
+        UpdateGraph::touch(versions, UpdateGraph::Positions | UpdateGraph::Velocities);
+        REQUIRE(versions == UpdateGraph::Versions{0, 1, 1, 0});
+
+        UpdateGraph::touch(versions, UpdateGraph::Velocities);
+        REQUIRE(versions == UpdateGraph::Versions{0, 1, 2, 0});
+    }
+
+    SECTION("Stages are outdated until evaluated")
+    {
+        REQUIRE(outdated_stages() == std::vector<bool>{true, true, true, true});
+        REQUIRE(outdated_stages() == std::vector<bool>{false, false, false, false});
+    }
+
+    SECTION("Input changes propagate to children")
+    {
+        outdated_stages();
+
+        UpdateGraph::touch(versions, UpdateGraph::Velocities);
+        REQUIRE(outdated_stages() == std::vector<bool>{false, false, true, true});
+
+        UpdateGraph::touch(versions, UpdateGraph::Positions);
+        REQUIRE(outdated_stages() == std::vector<bool>{true, true, true, false});
+
+        UpdateGraph::touch(versions, UpdateGraph::Time);
+        REQUIRE(outdated_stages() == std::vector<bool>{false, true, true, false});
+
+        UpdateGraph::touch(versions, UpdateGraph::Accelerations);
+        REQUIRE(outdated_stages() == std::vector<bool>{false, false, false, false});
+    }
+
+    SECTION("Stages are outdated after invalidation")
+    {
+        outdated_stages();
+
+        graph.invalidate();
+        REQUIRE(outdated_stages() == std::vector<bool>{true, true, true, true});
+    }
+
+    SECTION("Parents must be defined before their children")
+    {
+        const std::vector<UpdateGraph::StageDefinition> parent_after_child{{UpdateGraph::Positions, {1}},
+                                                                           {UpdateGraph::Time, {}}};
+        const std::vector<UpdateGraph::StageDefinition> own_parent{{UpdateGraph::Positions, {0}}};
+
+        REQUIRE_THROWS_AS(UpdateGraph(parent_after_child), std::invalid_argument);
+        REQUIRE_THROWS_AS(UpdateGraph(own_parent), std::invalid_argument);
+    }
+}
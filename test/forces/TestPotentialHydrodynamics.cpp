@@ -0,0 +1,597 @@
+//
+// Created by Alec Glisman on 11/02/21
+//
+
+#include <TestPotentialHydrodynamics.hpp>
+
+int
+TestPotentialHydrodynamics::testParticleDistances()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    m_potHydro->calcParticleDistances(single_core_device);
+
+    const Eigen::VectorXd& positions = m_potHydro->m_system->positionsParticles();
+
+    for (int k = 0; k < m_potHydro->m_num_pair_inter; k++)
+    {
+        const Eigen::Vector3d r_ab = positions.segment<3>(3 * m_potHydro->m_alphaVec(k)) -
+                                     positions.segment<3>(3 * m_potHydro->m_betaVec(k));
+        const double          r{r_ab.norm()};
+
+        if (!m_potHydro->m_r_ab.row(k).transpose().isApprox(r_ab, m_tol))
+        {
+            num_failed_tests += 1;
+        }
+        if (std::abs(m_potHydro->m_r_mag_ab(k) - r) > m_tol * r)
+        {
+            num_failed_tests += 1;
+        }
+        if (std::abs(m_potHydro->m_r_inv3_ab(k) - std::pow(r, -3)) > m_tol * std::pow(r, -3))
+        {
+            num_failed_tests += 1;
+        }
+        if (std::abs(m_potHydro->m_r_inv5_ab(k) - std::pow(r, -5)) > m_tol * std::pow(r, -5))
+        {
+            num_failed_tests += 1;
+        }
+        if (std::abs(m_potHydro->m_r_inv7_ab(k) - std::pow(r, -7)) > m_tol * std::pow(r, -7))
+        {
+            num_failed_tests += 1;
+        }
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testAddedMassGrad()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    const double          h{1.0e-5};
+    const int             n7{m_potHydro->m_7N};
+    const Eigen::VectorXd x0 = m_potHydro->m_system->positionsParticles();
+
+    const Eigen::Tensor<double, 3> grad_M_added = m_potHydro->m_grad_M_added.toDense();
+
+    // scale of gradient elements
+    const Eigen::Tensor<double, 0> grad_max = grad_M_added.abs().maximum();
+
+    for (int l = 0; l < x0.size(); l++)
+    {
+        Eigen::VectorXd x = x0;
+
+        // forward step
+        x(l) = x0(l) + h;
+        m_potHydro->m_system->setPositionsParticles(x);
+        m_potHydro->calcParticleDistances(single_core_device);
+        m_potHydro->calcAddedMass(single_core_device);
+        const Eigen::MatrixXd M_forward = m_potHydro->m_M_added;
+
+        // backward step
+        x(l) = x0(l) - h;
+        m_potHydro->m_system->setPositionsParticles(x);
+        m_potHydro->calcParticleDistances(single_core_device);
+        m_potHydro->calcAddedMass(single_core_device);
+        const Eigen::MatrixXd M_backward = m_potHydro->m_M_added;
+
+        const Eigen::MatrixXd fd_grad = (M_forward - M_backward) / (2.0 * h);
+
+        for (int i = 0; i < n7; i++)
+        {
+            for (int j = 0; j < n7; j++)
+            {
+                num_failed_tests += (std::abs(fd_grad(i, j) - grad_M_added(i, j, l)) > m_tol * grad_max());
+            }
+        }
+    }
+
+    // restore configuration
+    m_potHydro->m_system->setPositionsParticles(x0);
+    m_potHydro->calcParticleDistances(single_core_device);
+    m_potHydro->calcAddedMass(single_core_device);
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testAddedMassGradElement()
+{
+    int num_failed_tests{0};
+
+    const int                      num_particles{m_potHydro->m_system->numParticles()};
+    const Eigen::Tensor<double, 3> grad_M_added = m_potHydro->m_grad_M_added.toDense();
+
+    const Eigen::array<Eigen::Index, 3> extents = {3, 3, 3};
+
+    for (int alpha = 0; alpha < num_particles; alpha++)
+    {
+        for (int beta = 0; beta < num_particles; beta++)
+        {
+            for (int gamma = 0; gamma < num_particles; gamma++)
+            {
+                const Eigen::array<Eigen::Index, 3> offsets = {7 * alpha, 7 * beta, 3 * gamma};
+
+                const BlockSparseGradient::Block dense_block = grad_M_added.slice(offsets, extents);
+                const BlockSparseGradient::Block block = m_potHydro->m_grad_M_added.element(alpha, beta, gamma);
+
+                const Eigen::Tensor<double, 0> diff = (dense_block - block).abs().maximum();
+                num_failed_tests += (diff() != 0.0);
+            }
+        }
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testAddedMassGradBodyCoords()
+{
+    int num_failed_tests{0};
+
+    const Eigen::array<Eigen::IndexPair<int>, 1> contract_ijl_kl = {Eigen::IndexPair<int>(2, 1)};
+
+    const Eigen::Tensor<double, 3> grad_M_added = m_potHydro->m_grad_M_added.toDense();
+    const Eigen::Tensor<double, 3> grad_M_added_body_coords =
+        grad_M_added.contract(m_potHydro->m_system->tensChi(), contract_ijl_kl);
+
+    const Eigen::Tensor<double, 0> grad_max = grad_M_added_body_coords.abs().maximum();
+    const Eigen::Tensor<double, 0> diff =
+        (grad_M_added_body_coords - m_potHydro->m_grad_M_added_body_coords).abs().maximum();
+
+    num_failed_tests += (diff() > m_tol * grad_max());
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testHydroForcesMatrixFree()
+{
+    int num_failed_tests{0};
+
+    std::uniform_real_distribution<double> unif(-1.0, 1.0);
+    std::default_random_engine             re;
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    const int m7{m_potHydro->m_7M};
+
+    for (int trial = 0; trial < 3; trial++)
+    {
+        // random body kinematics
+        Eigen::VectorXd xi_dot  = Eigen::VectorXd::Zero(m7);
+        Eigen::VectorXd xi_ddot = Eigen::VectorXd::Zero(m7);
+        for (int i = 0; i < m7; i++)
+        {
+            xi_dot(i)  = unif(re);
+            xi_ddot(i) = unif(re);
+        }
+
+        m_potHydro->m_system->setVelocitiesBodies(xi_dot);
+        m_potHydro->m_system->setAccelerationsBodies(xi_ddot);
+        m_potHydro->m_system->update(single_core_device);
+
+        // tensor (N1, N2, N3) force evaluation
+        m_potHydro->update(single_core_device);
+        const Eigen::VectorXd f_hydro            = m_potHydro->fHydro();
+        const Eigen::VectorXd f_hydro_no_inertia  = m_potHydro->fHydroNoInertia();
+
+        // forces must be non-trivial for comparison to be meaningful
+        num_failed_tests += (f_hydro.norm() == 0.0);
+        num_failed_tests += (f_hydro_no_inertia.norm() == 0.0);
+
+        // matrix-free force evaluation
+        m_potHydro->calcHydroForcesMatrixFree(single_core_device);
+
+        num_failed_tests += !(m_potHydro->fHydro().isApprox(f_hydro, m_tol));
+        num_failed_tests += !(m_potHydro->fHydroNoInertia().isApprox(f_hydro_no_inertia, m_tol));
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testNeighborList()
+{
+    int num_failed_tests{0};
+
+    const int    num_particles{200};
+    const double box_length{20.0};
+    const double r_cut{3.0};
+    const double r_skin{1.0};
+
+    std::default_random_engine             generator(0);
+    std::uniform_real_distribution<double> distribution(-0.5 * box_length, 0.5 * box_length);
+
+    Eigen::VectorXd positions = Eigen::VectorXd::Zero(3 * num_particles);
+    for (int i = 0; i < positions.size(); i++)
+    {
+        positions(i) = distribution(generator);
+    }
+
+    NeighborList neighbor_list(num_particles, r_cut, r_skin);
+
+    if (!neighbor_list.update(positions))
+    {
+        num_failed_tests += 1;
+    }
+
+    // brute force list of all pairs within r_cut + r_skin (ordered by alpha, then beta)
+    int pair_id{0};
+    for (int alpha = 0; alpha < num_particles; alpha++)
+    {
+        for (int beta = alpha + 1; beta < num_particles; beta++)
+        {
+            const double r{(positions.segment<3>(3 * alpha) - positions.segment<3>(3 * beta)).norm()};
+
+            if (r >= r_cut + r_skin)
+            {
+                continue;
+            }
+
+            if ((pair_id >= neighbor_list.numPairs()) || (neighbor_list.alphaVec()(pair_id) != alpha) ||
+                (neighbor_list.betaVec()(pair_id) != beta))
+            {
+                num_failed_tests += 1;
+            }
+
+            pair_id++;
+        }
+    }
+
+    if (pair_id != neighbor_list.numPairs())
+    {
+        num_failed_tests += 1;
+    }
+
+    // displacement below half the skin distance: list is still valid
+    positions(0) += 0.4 * r_skin;
+    if (neighbor_list.update(positions))
+    {
+        num_failed_tests += 1;
+    }
+
+    // displacement above half the skin distance: list must be rebuilt
+    positions(0) += 0.2 * r_skin;
+    if (!neighbor_list.update(positions) || (neighbor_list.numBuilds() != 2))
+    {
+        num_failed_tests += 1;
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testDipoleTreecode()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(4);
+    Eigen::ThreadPoolDevice device(&thread_pool, 4);
+
+    const int    num_particles{500};
+    const double box_length{40.0};
+
+    std::default_random_engine             generator(0);
+    std::uniform_real_distribution<double> position_distribution(-0.5 * box_length, 0.5 * box_length);
+    std::uniform_real_distribution<double> vector_distribution(-1.0, 1.0);
+
+    Eigen::VectorXd positions = Eigen::VectorXd::Zero(3 * num_particles);
+    Eigen::VectorXd x         = Eigen::VectorXd::Zero(3 * num_particles);
+    for (int i = 0; i < positions.size(); i++)
+    {
+        positions(i) = position_distribution(generator);
+        x(i)         = vector_distribution(generator);
+    }
+
+    // direct sum of pairwise dipole kernel
+    Eigen::VectorXd y_direct = Eigen::VectorXd::Zero(3 * num_particles);
+    for (int i = 0; i < num_particles; i++)
+    {
+        for (int j = 0; j < num_particles; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            const Eigen::Vector3d r_ij = positions.segment<3>(3 * i) - positions.segment<3>(3 * j);
+            const double          r{r_ij.norm()};
+
+            Eigen::Matrix3d K = -1.50 / std::pow(r, 5) * r_ij * r_ij.transpose();
+            K.diagonal().array() += 0.50 / std::pow(r, 3);
+
+            y_direct.segment<3>(3 * i).noalias() += K * x.segment<3>(3 * j);
+        }
+    }
+
+    // relative error at decreasing opening angles
+    const std::vector<double> thetas = {0.7, 0.4, 0.1};
+    std::vector<double>       errors;
+
+    for (const double theta : thetas)
+    {
+        DipoleTreecode treecode(num_particles, theta, 4);
+        treecode.build(positions);
+
+        Eigen::VectorXd y = Eigen::VectorXd::Zero(3 * num_particles);
+        treecode.apply(x, y, device);
+
+        errors.push_back((y - y_direct).norm() / y_direct.norm());
+    }
+
+    if (errors[0] > 2.5e-1)
+    {
+        num_failed_tests += 1;
+    }
+    if ((errors[1] >= errors[0]) || (errors[2] >= errors[1]))
+    {
+        num_failed_tests += 1;
+    }
+    if (errors[2] > 1.0e-3)
+    {
+        num_failed_tests += 1;
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testDipoleTreecodeScaling()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(4);
+    Eigen::ThreadPoolDevice device(&thread_pool, 4);
+
+    const double theta{0.5};
+    const double padding{2.0};
+    const double spacing{3.0};
+
+    std::default_random_engine             generator(0);
+    std::uniform_real_distribution<double> jitter_distribution(-0.25, 0.25);
+
+    // particles on jittered cubic lattices of (n x n x n) sites at fixed density
+    const std::vector<int> lattice_sizes = {8, 16};
+    std::vector<double>    num_evaluations;
+    std::vector<double>    num_pairs;
+
+    for (const int n : lattice_sizes)
+    {
+        const int num_particles{n * n * n};
+
+        Eigen::VectorXd positions = Eigen::VectorXd::Zero(3 * num_particles);
+        for (int i = 0; i < num_particles; i++)
+        {
+            positions(3 * i)     = spacing * (i % n) + jitter_distribution(generator);
+            positions(3 * i + 1) = spacing * ((i / n) % n) + jitter_distribution(generator);
+            positions(3 * i + 2) = spacing * (i / (n * n)) + jitter_distribution(generator);
+        }
+
+        const Eigen::VectorXd x = Eigen::VectorXd::Ones(3 * num_particles);
+        Eigen::VectorXd       y = Eigen::VectorXd::Zero(3 * num_particles);
+
+        DipoleTreecode treecode(num_particles, theta);
+        treecode.build(positions);
+        treecode.apply(x, y, device);
+
+        num_evaluations.push_back(static_cast<double>(treecode.numDirectEvaluations() +
+                                                      treecode.numFarFieldEvaluations()));
+
+        Eigen::VectorXi alpha_vec;
+        Eigen::VectorXi beta_vec;
+        treecode.nearFieldPairs(padding, alpha_vec, beta_vec);
+        num_pairs.push_back(static_cast<double>(alpha_vec.size()));
+
+        for (int k = 0; k < alpha_vec.size(); k++)
+        {
+            if (alpha_vec(k) >= beta_vec(k))
+            {
+                num_failed_tests += 1;
+            }
+        }
+
+        // all pairs closer than padding / theta are in the near-field (dense check on smallest lattice only)
+        if (n != lattice_sizes[0])
+        {
+            continue;
+        }
+
+        Eigen::MatrixXi is_near = Eigen::MatrixXi::Zero(num_particles, num_particles);
+        for (int k = 0; k < alpha_vec.size(); k++)
+        {
+            is_near(alpha_vec(k), beta_vec(k)) = 1;
+        }
+
+        for (int i = 0; i < num_particles; i++)
+        {
+            for (int j = i + 1; j < num_particles; j++)
+            {
+                const double r{(positions.segment<3>(3 * i) - positions.segment<3>(3 * j)).norm()};
+
+                if ((r < padding / theta) && (is_near(i, j) == 0))
+                {
+                    num_failed_tests += 1;
+                }
+            }
+        }
+    }
+
+    /* 8x more particles: direct sums cost 64x more, treecode products O(N log N) (measured 15x) and near-field
+     * pairs O(N) (measured 11x, lattice boundaries are a smaller fraction of the larger lattice) */
+    const double particle_ratio{std::pow(static_cast<double>(lattice_sizes[1]) / lattice_sizes[0], 3)};
+
+    if (num_evaluations[1] / num_evaluations[0] > 0.30 * particle_ratio * particle_ratio)
+    {
+        num_failed_tests += 1;
+    }
+    if (num_pairs[1] / num_pairs[0] > 1.50 * particle_ratio)
+    {
+        num_failed_tests += 1;
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testBodyMassSized()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    // only compiled for the isolated collinear swimmer
+    if ((m_potHydro->m_7N != 21) || (m_potHydro->m_7M != 7))
+    {
+        return 1;
+    }
+
+    m_potHydro->calcBodyMassDynamic(single_core_device);
+    const Eigen::MatrixXd M2_dynamic = m_potHydro->m_mat_M2;
+    const Eigen::MatrixXd M3_dynamic = m_potHydro->m_mat_M3;
+
+    // dense connectivity tensor assembled from its per-particle blocks
+    Eigen::MatrixXd rbm_conn = Eigen::MatrixXd::Zero(m_potHydro->m_7M, m_potHydro->m_7N);
+    for (int particle_id = 0; particle_id < m_potHydro->m_num_particles; particle_id++)
+    {
+        const int body_id_7{7 * m_potHydro->m_system->particleGroupId()(particle_id)};
+
+        rbm_conn.block<7, 7>(body_id_7, 7 * particle_id) = m_potHydro->m_system->rbmConnBlock(particle_id);
+    }
+
+    const Eigen::MatrixXd M2_dense = rbm_conn * m_potHydro->m_M_total;
+    const Eigen::MatrixXd M3_dense = M2_dense * rbm_conn.transpose();
+
+    if (!M2_dynamic.isApprox(M2_dense, m_tol))
+    {
+        num_failed_tests += 1;
+    }
+    if (!M3_dynamic.isApprox(M3_dense, m_tol))
+    {
+        num_failed_tests += 1;
+    }
+
+    m_potHydro->m_mat_M2.setZero();
+    m_potHydro->m_mat_M3.setZero();
+    m_potHydro->calcBodyMass(single_core_device); // dispatches to calcBodyMassSized<21, 7>()
+
+    if (!m_potHydro->m_mat_M2.isApprox(M2_dynamic, m_tol))
+    {
+        num_failed_tests += 1;
+    }
+    if (!m_potHydro->m_mat_M3.isApprox(M3_dynamic, m_tol))
+    {
+        num_failed_tests += 1;
+    }
+
+    const Eigen::MatrixXd M3_tensor = MatrixCast(m_potHydro->m_M3, m_potHydro->m_7M, m_potHydro->m_7M);
+    if (!M3_tensor.isApprox(M3_dynamic, m_tol))
+    {
+        num_failed_tests += 1;
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestPotentialHydrodynamics::testUpdateGraph()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    const std::shared_ptr<SystemData>& system = m_potHydro->m_system;
+
+    system->update(single_core_device);
+    m_potHydro->update(single_core_device);
+
+    // test 1: velocity-only change does not re-evaluate position dependent stages
+    // NOTE: sentinels in stage outputs are only overwritten if the stage is re-evaluated
+    const double sentinel{12345.0};
+
+    const double r_mag{m_potHydro->m_r_mag_ab(0)};
+    const double M_added{m_potHydro->m_M_added(0, 0)};
+    const double grad_M_added{m_potHydro->m_grad_M_added.block(0)(0, 0, 0)};
+    const double M3{m_potHydro->m_mat_M3(0, 0)};
+
+    m_potHydro->m_r_mag_ab(0)                    = sentinel;
+    m_potHydro->m_M_added(0, 0)                  = sentinel;
+    m_potHydro->m_grad_M_added.block(0)(0, 0, 0) = sentinel;
+    m_potHydro->m_mat_M3(0, 0)                   = sentinel;
+    m_potHydro->m_F_hydro(0)                     = sentinel;
+
+    system->setVelocitiesBodies(2.0 * system->velocitiesBodies());
+    system->update(single_core_device);
+    m_potHydro->update(single_core_device);
+
+    num_failed_tests += (m_potHydro->m_r_mag_ab(0) != sentinel);                    // StageDistances
+    num_failed_tests += (m_potHydro->m_M_added(0, 0) != sentinel);                  // StageAddedMass
+    num_failed_tests += (m_potHydro->m_grad_M_added.block(0)(0, 0, 0) != sentinel); // StageAddedMassGrad
+    num_failed_tests += (m_potHydro->m_mat_M3(0, 0) != sentinel);                   // StageBodyMass
+    num_failed_tests += (m_potHydro->m_F_hydro(0) == sentinel);                     // StageForces
+
+    m_potHydro->m_r_mag_ab(0)                    = r_mag;
+    m_potHydro->m_M_added(0, 0)                  = M_added;
+    m_potHydro->m_grad_M_added.block(0)(0, 0, 0) = grad_M_added;
+    m_potHydro->m_mat_M3(0, 0)                   = M3;
+
+    // test 2: incremental update matches full re-evaluation bit for bit
+    Eigen::VectorXd positions_bodies = system->positionsBodies();
+    positions_bodies(0) += 1.0e-3;
+    system->setPositionsBodies(positions_bodies);
+    system->setVelocitiesBodies(0.5 * system->velocitiesBodies());
+    system->update(single_core_device);
+    m_potHydro->update(single_core_device);
+
+    const auto tensor_vector = [](const auto& tensor) {
+        return Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(tensor.data(), tensor.size()));
+    };
+
+    const Eigen::MatrixXd M_added_incremental = m_potHydro->m_M_added;
+    const Eigen::MatrixXd M_total_incremental = m_potHydro->m_M_total;
+    const Eigen::MatrixXd M2_incremental      = m_potHydro->m_mat_M2;
+    const Eigen::MatrixXd M3_incremental      = m_potHydro->m_mat_M3;
+    const Eigen::VectorXd N1_incremental      = tensor_vector(m_potHydro->m_N1);
+    const Eigen::VectorXd N2_incremental      = tensor_vector(m_potHydro->m_N2);
+    const Eigen::VectorXd N3_incremental      = tensor_vector(m_potHydro->m_N3);
+    const Eigen::VectorXd F_incremental       = m_potHydro->m_F_hydro;
+    const Eigen::VectorXd F_no_inertia        = m_potHydro->m_F_hydroNoInertia;
+    const double          E_incremental{system->eHydroLoc()};
+
+    std::vector<Eigen::VectorXd> grad_M_added_incremental;
+    for (int k = 0; k < m_potHydro->m_num_pair_inter; k++)
+    {
+        grad_M_added_incremental.push_back(tensor_vector(m_potHydro->m_grad_M_added.block(k)));
+    }
+
+    m_potHydro->m_update_graph.invalidate();
+    m_potHydro->update(single_core_device);
+
+    num_failed_tests += !(M_added_incremental == m_potHydro->m_M_added);
+    num_failed_tests += !(M_total_incremental == m_potHydro->m_M_total);
+    num_failed_tests += !(M2_incremental == m_potHydro->m_mat_M2);
+    num_failed_tests += !(M3_incremental == m_potHydro->m_mat_M3);
+    num_failed_tests += !(N1_incremental == tensor_vector(m_potHydro->m_N1));
+    num_failed_tests += !(N2_incremental == tensor_vector(m_potHydro->m_N2));
+    num_failed_tests += !(N3_incremental == tensor_vector(m_potHydro->m_N3));
+    num_failed_tests += !(F_incremental == m_potHydro->m_F_hydro);
+    num_failed_tests += !(F_no_inertia == m_potHydro->m_F_hydroNoInertia);
+    num_failed_tests += (E_incremental != system->eHydroLoc());
+
+    for (int k = 0; k < m_potHydro->m_num_pair_inter; k++)
+    {
+        num_failed_tests += !(grad_M_added_incremental[k] == tensor_vector(m_potHydro->m_grad_M_added.block(k)));
+    }
+
+    return num_failed_tests;
+}
@@ -0,0 +1,142 @@
+//
+// Created by Alec Glisman on 11/02/21
+//
+
+#ifndef BODIES_IN_POTENTIAL_FLOW_TEST_PotentialHydrodynamics_HPP
+#define BODIES_IN_POTENTIAL_FLOW_TEST_PotentialHydrodynamics_HPP
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+/* Include all internal project dependencies */
+#include <PotentialHydrodynamics.hpp>
+#include <SystemData.hpp>
+
+/* Include all external project dependencies */
+#include <memory> // for std::unique_ptr and std::shared_ptr
+#include <random> // std::uniform_real_distribution, std::default_random_engine
+
+/**
+ * @class TestPotentialHydrodynamics
+ *
+ * @brief Friend class to test `PotentialHydrodynamics` class
+ *
+ */
+class TestPotentialHydrodynamics
+{
+  public:
+    // classes
+    /// shared pointer reference to PotentialHydrodynamics class
+    std::shared_ptr<PotentialHydrodynamics> m_potHydro;
+
+    /**
+     * @brief Construct a new test Potential Hydrodynamics object
+     *
+     * @param potHydro PotentialHydrodynamics class to test
+     */
+    explicit TestPotentialHydrodynamics(std::shared_ptr<PotentialHydrodynamics> potHydro) : m_potHydro(potHydro){};
+
+    /**
+     * @brief Destroy the test Potential Hydrodynamics object
+     *
+     */
+    ~TestPotentialHydrodynamics() = default;
+
+    /**
+     * @brief Test the structure-of-arrays pair geometry of `PotentialHydrodynamics::calcParticleDistances()` against
+     * scalar evaluation from the particle positions
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testParticleDistances();
+
+    /**
+     * @brief Test `PotentialHydrodynamics::calcAddedMassGrad()` against central finite differences of
+     * `PotentialHydrodynamics::calcAddedMass()`
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testAddedMassGrad();
+
+    /**
+     * @brief Test `BlockSparseGradient::element()` against the dense gradient tensor
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testAddedMassGradElement();
+
+    /**
+     * @brief Test `BlockSparseGradient::contractChi()` against a dense tensor contraction
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testAddedMassGradBodyCoords();
+
+    /**
+     * @brief Test `PotentialHydrodynamics::calcHydroForcesMatrixFree()` against
+     * `PotentialHydrodynamics::calcHydroForces()` at random body kinematics
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testHydroForcesMatrixFree();
+
+    /**
+     * @brief Test `NeighborList` builds against a brute force search of all particle pairs at random positions, and
+     * that the list is only rebuilt once particles move more than half the skin distance
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testNeighborList();
+
+    /**
+     * @brief Test `DipoleTreecode::apply()` against a direct sum over all particle pairs at random positions, and that
+     * the error decreases with the opening angle
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testDipoleTreecode();
+
+    /**
+     * @brief Test that the kernel evaluations of `DipoleTreecode::apply()` and the pairs of
+     * `DipoleTreecode::nearFieldPairs()` grow sub-quadratically with the number of particles, and that all close pairs
+     * are in the near-field
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testDipoleTreecodeScaling();
+
+    /**
+     * @brief Test `PotentialHydrodynamics::calcBodyMassSized()` (through `PotentialHydrodynamics::calcBodyMass()`)
+     * against `PotentialHydrodynamics::calcBodyMassDynamic()`, and the latter against dense products with the
+     * connectivity tensor assembled from `SystemData::rbmConnBlock()`
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testBodyMassSized();
+
+    /**
+     * @brief Test that `PotentialHydrodynamics::update()` only re-evaluates the stages of
+     * `PotentialHydrodynamics::m_update_graph` whose inputs changed, and that incremental updates match a full
+     * re-evaluation
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testUpdateGraph();
+
+  private:
+    /// relative tolerance for tensor comparisons
+    const double m_tol{1.0e-6};
+};
+
+#endif // BODIES_IN_POTENTIAL_FLOW_TEST_PotentialHydrodynamics_HPP
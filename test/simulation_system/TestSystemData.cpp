@@ -163,8 +163,153 @@ TestSystemData::testEMatrix()
 int
 TestSystemData::testRigidBodyMotionTensors()
 {
-    const int num_tests{4};
-    int       num_failed_tests{0};
+    int num_failed_tests{0};
+
+    const int num_particles{m_system->numParticles()};
+    const int num_bodies_7{7 * m_system->numBodies()};
+
+    // test 1: per-particle chi blocks are the only non-zero blocks of the chi tensor
+    Eigen::MatrixXd rbm_conn_blocks = Eigen::MatrixXd::Zero(num_bodies_7, 7 * num_particles);
+    Eigen::MatrixXd chi_blocks      = Eigen::MatrixXd::Zero(num_bodies_7, 3 * num_particles);
+
+    for (int particle_id = 0; particle_id < num_particles; particle_id++)
+    {
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+        rbm_conn_blocks.block<7, 7>(body_id_7, 7 * particle_id) = m_system->rbmConnBlock(particle_id);
+        chi_blocks.block<7, 3>(body_id_7, 3 * particle_id)      = m_system->chiBlock(particle_id);
+    }
+
+    num_failed_tests += !(chi_blocks == MatrixMap(m_system->tensChi()));
+
+    // test 2: particle velocities match the product with the connectivity tensor assembled from its blocks
+    Eigen::VectorXd vel_particles = rbm_conn_blocks.transpose() * m_system->velocitiesBodies();
+    vel_particles += m_system->velocitiesParticlesArticulation();
+
+    num_failed_tests += !(vel_particles.isApprox(m_system->velocitiesParticles(), 1e-12));
+
+    // test 3: gradient blocks only couple quaternion rows of the body, and angular block is constant
+    for (int particle_id = 0; particle_id < num_particles; particle_id++)
+    {
+        const SystemData::GradRbmConnBlock& grad_rbm_conn = m_system->gradRbmConnBlock(particle_id);
+
+        for (int k = 0; k < 7; k++)
+        {
+            for (int c = 0; c < 7; c++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    num_failed_tests += (grad_rbm_conn(j, c, k) != 0.0);
+                }
+
+                for (int j = 3; (j < 7) && (c >= 3); j++)
+                {
+                    num_failed_tests += (grad_rbm_conn(j, c, k) != 2.0 * m_system->m_kappa(j - 3, c - 3, k));
+                }
+            }
+        }
+    }
+
+    // test 4: particle accelerations are re-evaluated after the body accelerations change
+    const Eigen::VectorXd acc_bodies = Eigen::VectorXd::Random(num_bodies_7);
+    m_system->setAccelerationsBodies(acc_bodies);
+
+    for (int particle_id = 0; particle_id < num_particles; particle_id++)
+    {
+        if (m_system->particleTypeId()(particle_id) != 1)
+        {
+            continue; // only locater particles move with the body locater point
+        }
+
+        const int body_id_7{7 * m_system->particleGroupId()(particle_id)};
+
+        Eigen::Vector3d acc_locater = acc_bodies.segment<3>(body_id_7);
+        acc_locater += m_system->accelerationsParticlesArticulation().segment<3>(7 * particle_id);
+
+        num_failed_tests +=
+            !(acc_locater.isApprox(m_system->accelerationsParticles().segment<3>(7 * particle_id), 1e-12));
+    }
+
+    return num_failed_tests;
+}
+
+int
+TestSystemData::testUpdateGraph()
+{
+    int num_failed_tests{0};
+
+    Eigen::ThreadPool       thread_pool = Eigen::ThreadPool(1);
+    Eigen::ThreadPoolDevice single_core_device(&thread_pool, 1);
+
+    const int num_particles{m_system->numParticles()};
+
+    m_system->update(single_core_device);
+
+    // test 1: velocity-only change does not re-evaluate position dependent stages
+    // NOTE: sentinels in stage outputs are only overwritten if the stage is re-evaluated
+    const double sentinel{12345.0};
+
+    const double orientation{m_system->m_orientations_particles(0)};
+    const double articulation{m_system->m_positions_particles_articulation(0)};
+    const double position{m_system->m_positions_particles(0)};
+    const double rbm_conn{m_system->m_rbm_conn_blocks[0](0, 0)};
+
+    m_system->m_orientations_particles(0)           = sentinel;
+    m_system->m_positions_particles_articulation(0) = sentinel;
+    m_system->m_positions_particles(0)              = sentinel;
+    m_system->m_rbm_conn_blocks[0](0, 0)            = sentinel;
+    m_system->m_velocities_particles(0)             = sentinel;
+
+    m_system->setVelocitiesBodies(2.0 * m_system->velocitiesBodies());
+    m_system->update(single_core_device);
+
+    num_failed_tests += (m_system->m_orientations_particles(0) != sentinel);           // StageOrientation
+    num_failed_tests += (m_system->m_positions_particles_articulation(0) != sentinel); // StageArticulation
+    num_failed_tests += (m_system->m_positions_particles(0) != sentinel);              // StageRbmTensors
+    num_failed_tests += (m_system->m_rbm_conn_blocks[0](0, 0) != sentinel);            // StageRbmTensors
+    num_failed_tests += (m_system->m_velocities_particles(0) == sentinel);             // StageParticleKinematics
+
+    m_system->m_orientations_particles(0)           = orientation;
+    m_system->m_positions_particles_articulation(0) = articulation;
+    m_system->m_positions_particles(0)              = position;
+    m_system->m_rbm_conn_blocks[0](0, 0)            = rbm_conn;
+
+    // test 2: incremental update matches full re-evaluation bit for bit
+    Eigen::VectorXd positions_bodies = m_system->positionsBodies();
+    positions_bodies(0) += 1.0e-3;
+    m_system->setPositionsBodies(positions_bodies);
+    m_system->setVelocitiesBodies(0.5 * m_system->velocitiesBodies());
+    m_system->update(single_core_device);
+
+    const Eigen::VectorXd positions_particles     = m_system->positionsParticles();
+    const Eigen::VectorXd velocities_particles    = m_system->velocitiesParticles();
+    const Eigen::VectorXd accelerations_particles = m_system->accelerationsParticles();
+    const Eigen::MatrixXd udwadia_A               = m_system->udwadiaA();
+    const Eigen::VectorXd udwadia_b               = m_system->udwadiaB();
+
+    const std::vector<SystemData::RbmConnBlock>     rbm_conn_blocks      = m_system->m_rbm_conn_blocks;
+    const std::vector<SystemData::ChiBlock>         chi_blocks           = m_system->m_chi_blocks;
+    const std::vector<SystemData::GradRbmConnBlock> grad_rbm_conn_blocks = m_system->m_grad_rbm_conn_blocks;
+
+    m_system->m_update_graph.invalidate();
+    m_system->update(single_core_device);
+
+    num_failed_tests += !(positions_particles == m_system->positionsParticles());
+    num_failed_tests += !(velocities_particles == m_system->velocitiesParticles());
+    num_failed_tests += !(accelerations_particles == m_system->accelerationsParticles());
+    num_failed_tests += !(udwadia_A == m_system->udwadiaA());
+    num_failed_tests += !(udwadia_b == m_system->udwadiaB());
+
+    for (int particle_id = 0; particle_id < num_particles; particle_id++)
+    {
+        num_failed_tests += !(rbm_conn_blocks[particle_id] == m_system->rbmConnBlock(particle_id));
+        num_failed_tests += !(chi_blocks[particle_id] == m_system->chiBlock(particle_id));
+
+        const Eigen::Map<const Eigen::VectorXd> grad_rbm_conn(grad_rbm_conn_blocks[particle_id].data(), 343);
+        const Eigen::Map<const Eigen::VectorXd> grad_rbm_conn_full(m_system->gradRbmConnBlock(particle_id).data(),
+                                                                   343);
+        num_failed_tests += !(grad_rbm_conn == grad_rbm_conn_full);
+    }
 
     return num_failed_tests;
 }
@@ -65,6 +65,15 @@ class TestSystemData
     int
     testRigidBodyMotionTensors();
 
+    /**
+     * @brief Test that `SystemData::update()` only re-evaluates the stages of `SystemData::m_update_graph` whose
+     * inputs changed, and that incremental updates match a full re-evaluation
+     *
+     * @return int Number of failed tests
+     */
+    int
+    testUpdateGraph();
+
   private:
 };
 